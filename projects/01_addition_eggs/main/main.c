@@ -2,6 +2,7 @@
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "arith.h"
 
 // กำหนดชื่อสำหรับแสดงใน log
 static const char *TAG = "EGGS_MATH";
@@ -27,7 +28,10 @@ void app_main(void)
     vTaskDelay(3000 / portTICK_PERIOD_MS);
 
     // คำนวณผลรวม (การบวก)
-    total_eggs = eggs_already_have + eggs_new_today;
+    if (arith_add_int(eggs_already_have, eggs_new_today, &total_eggs) != ARITH_OK) {
+        ESP_LOGE(TAG, "❌ จำนวนไข่มากเกินกว่าที่ตัวแปร int เก็บได้!");
+        return;
+    }
 
     // แสดงขั้นตอนการคิด
     ESP_LOGI(TAG, "🧮 ขั้นตอนการคิด:");
@@ -2,6 +2,7 @@
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "arith.h"
 
 // เปลี่ยนชื่อ TAG ให้สื่อความหมายมากขึ้น
 static const char *TAG = "TOYS_CHALLENGE";
@@ -31,7 +32,10 @@ void app_main(void)
     if (toys_at_home >= toys_give_away) {
         ESP_LOGI(TAG, "   ✅ ของเล่นพอแจก");
         // คำนวณผลลัพธ์ (การลบ)
-        toys_remaining = toys_at_home - toys_give_away;
+        if (arith_sub_int(toys_at_home, toys_give_away, &toys_remaining) != ARITH_OK) {
+            ESP_LOGE(TAG, "   ❌ ผลลบเกินกว่าที่ตัวแปร int เก็บได้!");
+            return;
+        }
         ESP_LOGI(TAG, "   เหลือของเล่น %d - %d = %d ชิ้น", 
                  toys_at_home, toys_give_away, toys_remaining);
 
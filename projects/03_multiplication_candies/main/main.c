@@ -2,28 +2,36 @@
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "arith.h"
+#include "fastdiv.h"
+#include "render_buf.h"
 
 static const char *TAG = "CANDY_PROJECT";
 
+// 🖨️ บัฟเฟอร์เรนเดอร์ใช้ร่วมกันทั้งโปรแกรม (ประกอบทั้งเฟรมแล้วเขียนครั้งเดียว)
+static char render_storage[2048];
+static render_buf_t render;
+
 // แสดงภาพถุงลูกอมตามจำนวน
 void show_candy_bags(int bags, int per_bag) {
     for (int i = 1; i <= bags; i++) {
-        ESP_LOGI(TAG, "   ถุงที่ %d: ", i);
-        printf("      ");
-        for (int j = 0; j < per_bag; j++) {
-            printf("🍬");
-        }
-        printf(" (%d เม็ด)\n", per_bag);
+        render_buf_log_line(&render, TAG);
+        render_buf_printf(&render, "   ถุงที่ %d: \n      ", i);
+        render_buf_repeat(&render, "🍬", per_bag);
+        render_buf_printf(&render, " (%d เม็ด)\n", per_bag);
     }
+    render_buf_flush(&render);
 }
 
 // แสดงตารางสูตรคูณ
 void show_multiplication_table(int base) {
-    ESP_LOGI(TAG, "📊 ตารางสูตรคูณของ %d:", base);
+    render_buf_log_line(&render, TAG);
+    render_buf_printf(&render, "📊 ตารางสูตรคูณของ %d:", base);
     for (int i = 1; i <= 10; i++) {
-        ESP_LOGI(TAG, "   %d × %d = %d", i, base, i * base);
-        vTaskDelay(300 / portTICK_PERIOD_MS);
+        render_buf_log_line(&render, TAG);
+        render_buf_printf(&render, "   %d × %d = %d", i, base, i * base);
     }
+    render_buf_flush(&render);
 }
 
 // แสดงการบวกซ้ำๆ
@@ -33,18 +41,31 @@ void show_repeated_addition(int times, int value) {
     for (int i = 0; i < times; i++) {
         sum += value;
         if (i == 0) {
-            printf("      %d", value);
+            render_buf_printf(&render, "      %d", value);
         } else {
-            printf(" + %d", value);
+            render_buf_printf(&render, " + %d", value);
         }
     }
-    printf(" = %d\n", sum);
+    render_buf_printf(&render, " = %d\n", sum);
+    render_buf_flush(&render);
 }
 
 // แจกจ่ายลูกอมให้เพื่อน
 void share_candies(int total, int friends) {
-    int per_friend = total / friends;
-    int leftover = total % friends;
+    // ตรวจก่อนแปลงเป็น uint32_t: ค่าติดลบจะกลายเป็นเลขใหญ่มากแทนที่จะถูกปฏิเสธ
+    if (friends <= 0) {
+        ESP_LOGE(TAG, "❌ จำนวนเพื่อนต้องมากกว่า 0");
+        return;
+    }
+    if (total < 0) {
+        ESP_LOGE(TAG, "❌ จำนวนลูกอมต้องไม่ติดลบ");
+        return;
+    }
+    fastdiv_u32_t divisor;
+    fastdiv_u32_init(&divisor, (uint32_t)friends);
+    fastdiv_qr_t share = fastdiv_u32_divmod(&divisor, (uint32_t)total);
+    int per_friend = (int)share.quotient;
+    int leftover = (int)share.remainder;
     ESP_LOGI(TAG, "👥 แจกให้เพื่อน %d คน:", friends);
     ESP_LOGI(TAG, "   คนละ %d เม็ด", per_friend);
     ESP_LOGI(TAG, "   เหลือ %d เม็ด", leftover);
@@ -58,9 +79,15 @@ void app_main(void)
     int orange_bags = 2;
     int grape_bags = 4;
 
+    render_buf_init(&render, render_storage, sizeof(render_storage));
+
     // คำนวณรวม
     int total_bags = strawberry_bags + orange_bags + grape_bags;
-    int total_candies = total_bags * candies_per_bag;
+    int total_candies;
+    if (arith_mul_int(total_bags, candies_per_bag, &total_candies) != ARITH_OK) {
+        ESP_LOGE(TAG, "❌ ลูกอมเยอะเกินกว่าที่ตัวแปร int เก็บได้!");
+        return;
+    }
 
     ESP_LOGI(TAG, "🍬 เริ่มต้นโปรแกรมนับลูกอม 🍬");
     ESP_LOGI(TAG, "=======================================");
@@ -93,6 +120,12 @@ void app_main(void)
              total_candies, total_candies / 12, total_candies % 12);
     ESP_LOGI(TAG, "   ✅ การคูณมีคุณสมบัติสับเปลี่ยน: a × b = b × a");
 
+    // 🖨️ วัดผลการรวมข้อความเป็นก้อนเดียว
+    ESP_LOGI(TAG, "");
+    ESP_LOGI(TAG, "🖨️ render: %lu ชิ้นส่วน → เขียนจริง %lu ครั้ง (%lu ไบต์)",
+             (unsigned long)render.stats.fragments, (unsigned long)render.stats.writes,
+             (unsigned long)render.stats.bytes);
+
     ESP_LOGI(TAG, "");
     ESP_LOGI(TAG, "🎉 จบโปรแกรมนับลูกอม!");
 }
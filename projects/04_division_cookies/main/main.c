@@ -2,9 +2,44 @@
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "arith.h"
+#include "fastdiv.h"
+#include "render_buf.h"
 
 static const char *TAG = "COOKIES_MATH";
 
+// 🖨️ บัฟเฟอร์สำหรับวาดภาพประกอบทั้งเฟรมแล้วเขียนครั้งเดียว
+static char render_storage[2048];
+static render_buf_t render;
+
+// 🎨 วาดภาพประกอบการแบ่งคุกกี้ให้เพื่อนแต่ละคน
+void show_cookie_sharing(int total, int friends, int per_person, int remaining) {
+    render_buf_log_line(&render, TAG);
+    render_buf_append(&render, "🎨 ภาพประกอบการแบ่ง:");
+    render_buf_log_line(&render, TAG);
+    render_buf_append(&render, "   คุกกี้ทั้งหมด: ");
+    render_buf_repeat(&render, "🍪", total);
+    render_buf_printf(&render, " (%d ชิ้น)", total);
+    render_buf_log_line(&render, TAG);
+
+    // แสดงการแบ่งให้แต่ละคน
+    for (int person = 1; person <= friends; person++) {
+        render_buf_log_line(&render, TAG);
+        render_buf_printf(&render, "   เพื่อนคนที่ %d: ", person);
+        render_buf_repeat(&render, "🍪", per_person);
+        render_buf_printf(&render, " (%d ชิ้น)", per_person);
+    }
+
+    if (remaining > 0) {
+        render_buf_log_line(&render, TAG);
+        render_buf_append(&render, "   เหลือ: ");
+        render_buf_repeat(&render, "🍪", remaining);
+        render_buf_printf(&render, " (%d ชิ้น)", remaining);
+    }
+    render_buf_log_line(&render, TAG);
+    render_buf_flush(&render);
+}
+
 void app_main(void)
 {
     ESP_LOGI(TAG, "🍪 เริ่มต้นโปรแกรมแบ่งคุกกี้ 🍪");
@@ -25,8 +60,17 @@ void app_main(void)
     
     vTaskDelay(3000 / portTICK_PERIOD_MS);
     
-    // ตรวจสอบการหารด้วยศูนย์
-    if (number_of_friends == 0) {
+    // ตรวจค่าติดลบก่อนแปลงเป็น uint32_t (ไม่งั้นจะกลายเป็นเลขใหญ่มากแทนที่จะถูกปฏิเสธ)
+    if (total_cookies < 0 || number_of_friends < 0) {
+        ESP_LOGE(TAG, "❌ ข้อผิดพลาด: จำนวนคุกกี้และจำนวนเพื่อนต้องไม่ติดลบ");
+        ESP_LOGI(TAG, "");
+        ESP_LOGI(TAG, "🎉 จบโปรแกรม!");
+        return;
+    }
+
+    // ตรวจสอบการหารด้วยศูนย์ และเตรียมตัวหาร (คำนวณส่วนกลับครั้งเดียว ใช้ซ้ำได้)
+    fastdiv_u32_t friends_divisor;
+    if (number_of_friends == 0 || !fastdiv_u32_init(&friends_divisor, (uint32_t)number_of_friends)) {
         ESP_LOGE(TAG, "❌ ข้อผิดพลาด: ไม่สามารถหารด้วยศูนย์ได้!");
         ESP_LOGI(TAG, "   ในชีวิตจริง: ไม่มีเพื่อนมาแบ่งคุกกี้");
         ESP_LOGI(TAG, "   คุกกี้ทั้งหมด %d ชิ้น จะเหลือไว้ทั้งหมด", total_cookies);
@@ -36,8 +80,9 @@ void app_main(void)
     }
     
     // คำนวณผลลัพธ์ (การหาร)
-    cookies_per_person = total_cookies / number_of_friends;    // ผลหาร
-    remaining_cookies = total_cookies % number_of_friends;     // เศษที่เหลือ
+    fastdiv_qr_t share = fastdiv_u32_divmod(&friends_divisor, (uint32_t)total_cookies);
+    cookies_per_person = (int)share.quotient;    // ผลหาร
+    remaining_cookies = (int)share.remainder;    // เศษที่เหลือ
     
     // แสดงขั้นตอนการคิด
     ESP_LOGI(TAG, "🧮 ขั้นตอนการคิด:");
@@ -60,27 +105,8 @@ void app_main(void)
     ESP_LOGI(TAG, "");
     
     // แสดงภาพประกอบ
-    ESP_LOGI(TAG, "🎨 ภาพประกอบการแบ่ง:");
-    ESP_LOGI(TAG, "   คุกกี้ทั้งหมด: 🍪🍪🍪🍪🍪🍪🍪🍪🍪🍪🍪🍪 (%d ชิ้น)", total_cookies);
-    ESP_LOGI(TAG, "");
-    
-    // แสดงการแบ่งให้แต่ละคน
-    for (int person = 1; person <= number_of_friends; person++) {
-        ESP_LOGI(TAG, "   เพื่อนคนที่ %d: ", person);
-        for (int cookie = 0; cookie < cookies_per_person; cookie++) {
-            // แสดงคุกกี้ที่ได้รับ (อย่างง่าย)
-        }
-        ESP_LOGI(TAG, "🍪🍪🍪 (%d ชิ้น)", cookies_per_person);
-    }
-    
-    if (remaining_cookies > 0) {
-        ESP_LOGI(TAG, "   เหลือ: ");
-        for (int i = 0; i < remaining_cookies; i++) {
-            // แสดงคุกกี้ที่เหลือ
-        }
-        ESP_LOGI(TAG, "🍪 (%d ชิ้น)", remaining_cookies);
-    }
-    ESP_LOGI(TAG, "");
+    render_buf_init(&render, render_storage, sizeof(render_storage));
+    show_cookie_sharing(total_cookies, number_of_friends, cookies_per_person, remaining_cookies);
     
     // ตัวอย่างเพิ่มเติม
     ESP_LOGI(TAG, "💡 ตัวอย่างเพิ่มเติม:");
@@ -106,7 +132,20 @@ void app_main(void)
     ESP_LOGI(TAG, "   (หารไม่ลงตัว)");
     ESP_LOGI(TAG, "");
     
-    // ตัวอย่างที่ 3: กรณีพิเศษ
+    // ตัวอย่างที่ 3: คุกกี้หลายถาด แบ่งให้เพื่อนกลุ่มเดิม (ใช้ตัวหารเดิมซ้ำ)
+    uint32_t trays[] = {12, 13, 14, 15, 16};
+    uint32_t trays_per_person[5];
+    uint32_t trays_remaining[5];
+    fastdiv_u32_divmod_array(&friends_divisor, trays, trays_per_person, trays_remaining, 5);
+    ESP_LOGI(TAG, "   คุกกี้หลายถาด แบ่งให้เพื่อน %d คนเดิม:", number_of_friends);
+    for (int i = 0; i < 5; i++) {
+        ESP_LOGI(TAG, "   ถาด %lu ชิ้น → คนละ %lu ชิ้น, เหลือ %lu ชิ้น",
+                 (unsigned long)trays[i], (unsigned long)trays_per_person[i],
+                 (unsigned long)trays_remaining[i]);
+    }
+    ESP_LOGI(TAG, "");
+    
+    // ตัวอย่างที่ 4: กรณีพิเศษ
     ESP_LOGI(TAG, "⚠️  กรณีพิเศษ - หารด้วยศูนย์:");
     ESP_LOGI(TAG, "   ถ้าไม่มีเพื่อนมาแบ่ง (หารด้วย 0)");
     ESP_LOGI(TAG, "   ไม่สามารถคำนวณได้ในทางคณิตศาสตร์");
@@ -116,9 +155,14 @@ void app_main(void)
     // ความสัมพันธ์กับการคูณ
     ESP_LOGI(TAG, "🔄 ความสัมพันธ์กับการคูณ:");
     ESP_LOGI(TAG, "   การหาร: %d ÷ %d = %d", total_cookies, number_of_friends, cookies_per_person);
-    ESP_LOGI(TAG, "   การคูณ: %d × %d = %d", cookies_per_person, number_of_friends, cookies_per_person * number_of_friends);
-    if (remaining_cookies > 0) {
-        ESP_LOGI(TAG, "   บวกเศษ: %d + %d = %d", cookies_per_person * number_of_friends, remaining_cookies, total_cookies);
+    int shared_cookies;
+    if (arith_mul_int(cookies_per_person, number_of_friends, &shared_cookies) != ARITH_OK) {
+        ESP_LOGE(TAG, "   ❌ ผลคูณเกินกว่าที่ตัวแปร int เก็บได้!");
+    } else {
+        ESP_LOGI(TAG, "   การคูณ: %d × %d = %d", cookies_per_person, number_of_friends, shared_cookies);
+        if (remaining_cookies > 0) {
+            ESP_LOGI(TAG, "   บวกเศษ: %d + %d = %d", shared_cookies, remaining_cookies, total_cookies);
+        }
     }
     ESP_LOGI(TAG, "   การหารและการคูณเป็นการดำเนินการตรงข้ามกัน");
     ESP_LOGI(TAG, "");
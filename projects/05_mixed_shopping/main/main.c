@@ -1,50 +1,163 @@
 #include <stdio.h>
 #include <string.h>
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "arith.h"
+#include "billsplit.h"
+#include "catalog.h"
+#include "receipt.h"
 
 static const char *TAG = "SHOPPING_MATH";
 
+// 🍎 สินค้าในตลาด สร้างจาก main/market_catalog.csv ตอน build
+extern const catalog_t market_catalog;
+
+// 💰 เงินทุกจำนวนเป็นสตางค์ (จำนวนเต็ม) ตั้งแต่ราคาต่อหน่วยจนถึงส่วนที่แต่ละคนจ่าย
+// ไม่ผ่าน float จึงไม่มีเศษปัดสะสม และยอดที่แบ่งจ่ายคือยอดบนใบเสร็จพอดี
 typedef struct {
-    char name[20];
+    const char *name;           // ชี้เข้าชื่อในแคตตาล็อก
     int quantity;
-    float price_per_unit;
-    float total_price;
+    int64_t price_satang;
+    int64_t total_satang;
+    bool vat_free;              // คอลัมน์ vat ของแคตตาล็อกเป็น zero/exempt
 } product_t;
 
 void calculate_product_total(product_t *product) {
-    product->total_price = product->quantity * product->price_per_unit;
-}
-
-void display_product(const product_t *product) {
-    ESP_LOGI(TAG, "   %s: %d × %.0f = %.0f บาท",
-             product->name, product->quantity, product->price_per_unit, product->total_price);
+    if (arith_satang_mul(product->price_satang, product->quantity, &product->total_satang) != ARITH_OK) {
+        ESP_LOGE(TAG, "Error: ยอดของ %s ใหญ่เกินจะคิดได้", product->name);
+        product->total_satang = 0;
+    }
 }
 
-float calculate_total_bill(product_t products[], int count) {
-    float total = 0.0;
+int64_t calculate_total_bill(product_t products[], int count) {
+    int64_t total = 0;
     for (int i = 0; i < count; i++) {
         calculate_product_total(&products[i]);
-        total += products[i].total_price;
+        total += products[i].total_satang;
     }
     return total;
 }
 
-float apply_discount(float total, float discount) {
-    return total - discount;
+int64_t apply_discount(int64_t total, int64_t discount) {
+    int64_t result;
+    arith_err_t err = arith_satang_discount(total, discount, &result);
+    if (err != ARITH_OK) {
+        ESP_LOGW(TAG, "⚠️ ส่วนลดต้องไม่ติดลบและไม่เกินยอดรวม (%s) จึงไม่หักส่วนลด", arith_err_name(err));
+    }
+    return result;
+}
+
+// 🏛️ VAT เป็น basis point (700 = 7%) คิดเฉพาะรายการที่ต้องเสีย VAT ตามแคตตาล็อก
+// ส่วนลดท้ายบิลเฉลี่ยลงยอดที่เสีย VAT ตามสัดส่วน แล้วคิด VAT จากยอดนั้น
+int64_t calculate_vat(const product_t products[], int count, int64_t subtotal,
+                      int64_t discounted, int vat_bp) {
+    if (vat_bp < 0) {
+        ESP_LOGW(TAG, "⚠️ อัตรา VAT ไม่ควรติดลบ");
+        return 0;
+    }
+    int64_t taxable = 0;
+    for (int i = 0; i < count; i++) {
+        if (!products[i].vat_free) {
+            taxable += products[i].total_satang;
+        }
+    }
+    if (taxable == 0 || subtotal <= 0) {
+        return 0;
+    }
+    // taxable × discounted / subtotal แล้ว × vat_bp / 10000 (ปัดครึ่งสตางค์ขึ้นทีละขั้น)
+    int64_t taxable_net, vat;
+    arith_err_t err = arith_satang_prorate(taxable, discounted, subtotal, &taxable_net);
+    if (err == ARITH_OK) {
+        err = arith_satang_percent(taxable_net, (uint32_t)vat_bp, &vat);
+    }
+    if (err != ARITH_OK) {
+        ESP_LOGE(TAG, "Error: คิด VAT ไม่ได้ (%s)", arith_err_name(err));
+        return 0;
+    }
+    return vat;
+}
+
+// 💳 แบ่งจ่ายเป็นสตางค์ ผลรวมทุกคนเท่ากับยอดบิลพอดี
+// weights == NULL คือหารเท่ากัน ยอดต้องอยู่ในช่วงที่ billsplit รับได้ (ไม่เกิน UINT32_MAX สตางค์)
+bool split_payment(int64_t amount_satang, int people, const uint16_t *weights, uint32_t shares_satang[]) {
+    billsplit_plan_t plan;
+    if (amount_satang < 0 || amount_satang > UINT32_MAX || people <= 0 ||
+        billsplit_plan_init(&plan, (uint32_t)people, weights) != BILLSPLIT_OK) {
+        ESP_LOGE(TAG, "Error: จำนวนคนต้องมากกว่า 0 และยอดเงินต้องไม่ติดลบหรือใหญ่เกิน");
+        return false;
+    }
+    billsplit_split(&plan, (uint32_t)amount_satang, shares_satang);
+    return true;
 }
 
-float add_vat(float total, float vat_percent) {
-    return total + (total * vat_percent / 100.0);
+// 🧾 แสดงส่วนที่แต่ละคนต้องจ่าย
+void display_shares(const uint32_t shares_satang[], int people) {
+    uint32_t sum = 0;
+    for (int i = 0; i < people; i++) {
+        ESP_LOGI(TAG, "     คนที่ %d:                %lu.%02lu บาท", i + 1,
+                 (unsigned long)(shares_satang[i] / 100), (unsigned long)(shares_satang[i] % 100));
+        sum += shares_satang[i];
+    }
+    ESP_LOGI(TAG, "     รวมทุกคน:               %lu.%02lu บาท",
+             (unsigned long)(sum / 100), (unsigned long)(sum % 100));
 }
 
-float split_payment(float amount, int people) {
-    if (people <= 0) {
-        ESP_LOGE(TAG, "Error: จำนวนคนต้องมากกว่า 0");
-        return 0.0;
+// 🧾 รูปแบบใบเสร็จ: คอลัมน์คำนวณครั้งเดียวตอนเรียกครั้งแรก
+static const receipt_layout_t receipt_layout = {
+    .indent = "   ", .currency = " บาท", .width = 42, .money_cols = 10, .qty_cols = 14,
+};
+static receipt_template_t receipt_tpl;
+static char receipt_buf[1536];
+
+// 🧾 วางใบเสร็จทั้งใบในบัฟเฟอร์เดียว (เงินเป็นสตางค์) แล้วเขียนออกครั้งเดียว
+// payers = 0 คือไม่แสดงการแบ่งจ่าย
+void print_receipt(const product_t products[], int count, int64_t subtotal, int64_t discount,
+                   int vat_bp, int64_t vat, int payers, const uint32_t shares_satang[]) {
+    receipt_t r;
+    char label[48];
+    int64_t start = esp_timer_get_time();
+
+    if (receipt_tpl.width == 0) {
+        receipt_template_init(&receipt_tpl, &receipt_layout);
+    }
+    int64_t discounted = subtotal - discount;
+
+    receipt_begin(&r, &receipt_tpl, receipt_buf, sizeof(receipt_buf));
+    receipt_text(&r, "🧾 ใบเสร็จซื้อของที่ตลาด");
+    receipt_rule(&r, true);
+    for (int i = 0; i < count; i++) {
+        receipt_item(&r, products[i].name, (uint32_t)products[i].quantity,
+                     products[i].price_satang, products[i].total_satang);
+    }
+    receipt_rule(&r, false);
+    receipt_amount(&r, "รวม:", 0, subtotal);
+    receipt_amount(&r, "ส่วนลด:", '-', discount);
+    receipt_amount(&r, "ยอดหลังหักส่วนลด:", 0, discounted);
+    snprintf(label, sizeof(label), "VAT %d%%:", vat_bp / 100);
+    receipt_amount(&r, label, '+', vat);
+    receipt_rule(&r, true);
+    receipt_amount(&r, "ยอดสุทธิ:", 0, discounted + vat);
+    if (payers > 0) {
+        uint32_t sum = 0;
+        snprintf(label, sizeof(label), "แบ่งจ่าย %d คน:", payers);
+        receipt_text(&r, label);
+        for (int i = 0; i < payers; i++) {
+            snprintf(label, sizeof(label), "  คนที่ %d:", i + 1);
+            receipt_amount(&r, label, 0, shares_satang[i]);
+            sum += shares_satang[i];
+        }
+        receipt_amount(&r, "  รวมทุกคน:", 0, sum);
     }
-    return amount / people;
+    receipt_rule(&r, true);
+    receipt_text(&r, "ขอบคุณที่ใช้บริการ ❤️");
+    int64_t laid_out = esp_timer_get_time();
+
+    receipt_emit(&r, receipt_sink_stdio, NULL);
+    ESP_LOGI(TAG, "⏱️ ใบเสร็จ %u บรรทัด %u ไบต์ ใช้เวลาวาง %lld µs ส่ง %lld µs",
+             (unsigned)r.lines, (unsigned)r.len, (long long)(laid_out - start),
+             (long long)(esp_timer_get_time() - laid_out));
 }
 
 void app_main(void)
@@ -52,47 +165,61 @@ void app_main(void)
     ESP_LOGI(TAG, "🛒 เริ่มต้นโปรแกรมซื้อของที่ตลาด 🛒");
     ESP_LOGI(TAG, "=====================================");
 
-    product_t products[] = {
-        {"แอปเปิ้ล", 6, 15.0, 0.0},
-        {"กล้วย", 12, 8.0, 0.0},
-        {"ส้ม", 8, 12.0, 0.0}
+    // 📟 สแกน barcode ของที่หยิบมา แล้วดึงชื่อและราคาจากแคตตาล็อก
+    static const struct {
+        uint64_t barcode;
+        int quantity;
+    } picked[] = {
+        {2000001000015ull, 6},      // แอปเปิ้ล
+        {2000001000022ull, 12},     // กล้วย
+        {2000001000039ull, 8}       // ส้ม
     };
-    int product_count = sizeof(products) / sizeof(products[0]);
-    float discount = 20.0;
-    float vat_percent = 7.0;
+    product_t products[sizeof(picked) / sizeof(picked[0])];
+    int product_count = 0;
+    for (size_t i = 0; i < sizeof(picked) / sizeof(picked[0]); i++) {
+        int32_t item = catalog_find(&market_catalog, picked[i].barcode);
+        if (item == CATALOG_NOT_FOUND) {
+            ESP_LOGW(TAG, "⚠️ ไม่พบสินค้า barcode %llu", (unsigned long long)picked[i].barcode);
+            continue;
+        }
+        products[product_count++] = (product_t){
+            .name = catalog_name(&market_catalog, (uint32_t)item),
+            .quantity = picked[i].quantity,
+            .price_satang = market_catalog.price[item],
+            .vat_free = market_catalog.vat[item] != CATALOG_VAT_STANDARD,
+        };
+    }
+    int64_t discount = 2000;         // 20 บาท
+    int vat_bp = 700;               // 7%
     int people = 3;
 
     ESP_LOGI(TAG, "\n📖 โจทย์:");
     for (int i = 0; i < product_count; i++) {
-        ESP_LOGI(TAG, "   - %s: %d หน่วย หน่วยละ %.0f บาท",
-                 products[i].name, products[i].quantity, products[i].price_per_unit);
+        ESP_LOGI(TAG, "   - %s: %d หน่วย หน่วยละ %lld บาท",
+                 products[i].name, products[i].quantity, (long long)(products[i].price_satang / 100));
     }
-    ESP_LOGI(TAG, "   - ส่วนลด: %.0f บาท", discount);
-    ESP_LOGI(TAG, "   - ภาษี VAT: %.0f%%", vat_percent);
+    ESP_LOGI(TAG, "   - ส่วนลด: %lld บาท", (long long)(discount / 100));
+    ESP_LOGI(TAG, "   - ภาษี VAT: %d%%", vat_bp / 100);
     ESP_LOGI(TAG, "   - แบ่งจ่าย: %d คน", people);
 
     vTaskDelay(2000 / portTICK_PERIOD_MS);
 
-    float subtotal = calculate_total_bill(products, product_count);
-    float discounted_total = apply_discount(subtotal, discount);
-    float total_with_vat = add_vat(discounted_total, vat_percent);
-    float per_person = split_payment(total_with_vat, people);
+    int64_t subtotal = calculate_total_bill(products, product_count);
+    int64_t discounted_total = apply_discount(subtotal, discount);
+    int64_t vat = calculate_vat(products, product_count, subtotal, discounted_total, vat_bp);
+    int64_t total_with_vat = discounted_total + vat;
+    uint32_t shares[BILLSPLIT_MAX_PAYERS];
+    bool split_ok = split_payment(total_with_vat, people, NULL, shares);
 
-    ESP_LOGI(TAG, "\n🧾 ใบเสร็จซื้อของที่ตลาด");
-    ESP_LOGI(TAG, "   ==========================================");
-    for (int i = 0; i < product_count; i++) {
-        display_product(&products[i]);
-    }
-    ESP_LOGI(TAG, "   ------------------------------------------");
-    ESP_LOGI(TAG, "   รวม:                     %.2f บาท", subtotal);
-    ESP_LOGI(TAG, "   ส่วนลด:                 -%.2f บาท", discount);
-    ESP_LOGI(TAG, "   ยอดหลังหักส่วนลด:       %.2f บาท", discounted_total);
-    ESP_LOGI(TAG, "   VAT %.0f%%:                +%.2f บาท", vat_percent, total_with_vat - discounted_total);
-    ESP_LOGI(TAG, "   ==========================================");
-    ESP_LOGI(TAG, "   ยอดสุทธิ:               %.2f บาท", total_with_vat);
-    ESP_LOGI(TAG, "   แบ่งจ่าย %d คน:           %.2f บาท/คน", people, per_person);
-    ESP_LOGI(TAG, "   ==========================================");
-    ESP_LOGI(TAG, "   ขอบคุณที่ใช้บริการ ❤️");
+    print_receipt(products, product_count, subtotal, subtotal - discounted_total, vat_bp,
+                  vat, split_ok ? people : 0, shares);
+
+    // แบ่งตามสัดส่วน: คนแรกกินเยอะ จ่าย 2 ส่วน อีกสองคนจ่ายคนละ 1 ส่วน
+    uint16_t weights[] = {2, 1, 1};
+    if (split_payment(total_with_vat, people, weights, shares)) {
+        ESP_LOGI(TAG, "\n⚖️ แบ่งจ่ายตามสัดส่วน 2:1:1");
+        display_shares(shares, people);
+    }
 
     // สรุปการเรียนรู้
     ESP_LOGI(TAG, "\n📚 สิ่งที่เรียนรู้:");
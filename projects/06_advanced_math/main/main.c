@@ -3,13 +3,18 @@
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "arith.h"
+#include "numfmt.h"
 
 // 🏷️ Tag สำหรับ Log
 static const char *TAG = "ADVANCED_MATH";
 
-// 🔢 ค่าคงที่ทางคณิตศาสตร์
-#define PI 3.14159265359
-#define SQUARE_METERS_TO_RAI 1600.0  // 1 ไร่ = 1,600 ตร.ม.
+// 🔢 ค่าคงที่ทางคณิตศาสตร์ (π, ตร.ม. ต่อไร่) อยู่ใน arith.h
+
+// 🔢 จัดรูปตัวเลขในการ์ดพร้อมคั่นหลักพัน (เช่น 6,000.00) โดยไม่ผ่าน printf ของ float
+static inline const char *num(char *buf, double v, int decimals) {
+    return numfmt_fixed_str(buf, v, decimals, NUMFMT_GROUP);
+}
 
 // 📐 โครงสร้างข้อมูลรูปทรง
 typedef struct {
@@ -21,61 +26,60 @@ typedef struct {
 
 // 🏟️ ฟังก์ชันคำนวณสี่เหลี่ยม
 void calculate_rectangle(shape_t shape) {
-    double area = shape.length * shape.width;
-    double perimeter = 2 * (shape.length + shape.width);
-    double area_in_rai = area / SQUARE_METERS_TO_RAI;
-    
+    double area = arith_rectangle_area(shape.length, shape.width);
+    double perimeter = arith_rectangle_perimeter(shape.length, shape.width);
+    double area_in_rai = arith_sqm_to_rai(area);
+    char n0[NUMFMT_BUF], n1[NUMFMT_BUF], n2[NUMFMT_BUF];
+
     ESP_LOGI(TAG, "╔══════════════════════════════════════╗");
     ESP_LOGI(TAG, "║          %s           ║", shape.name);
     ESP_LOGI(TAG, "╠══════════════════════════════════════╣");
-    ESP_LOGI(TAG, "║ 📏 ความยาว: %.2f เมตร", shape.length);
-    ESP_LOGI(TAG, "║ 📏 ความกว้าง: %.2f เมตร", shape.width);
-    ESP_LOGI(TAG, "║ 📐 พื้นที่: %.2f × %.2f = %.2f ตร.ม.", 
-             shape.length, shape.width, area);
-    ESP_LOGI(TAG, "║ 🔄 ปริเมตร: 2×(%.0f+%.0f) = %.2f ม.", 
-             shape.length, shape.width, perimeter);
-    ESP_LOGI(TAG, "║ 🌾 เท่ากับ: %.4f ไร่", area_in_rai);
+    ESP_LOGI(TAG, "║ 📏 ความยาว: %s เมตร", num(n0, shape.length, 2));
+    ESP_LOGI(TAG, "║ 📏 ความกว้าง: %s เมตร", num(n0, shape.width, 2));
+    ESP_LOGI(TAG, "║ 📐 พื้นที่: %s × %s = %s ตร.ม.",
+             num(n0, shape.length, 2), num(n1, shape.width, 2), num(n2, area, 2));
+    ESP_LOGI(TAG, "║ 🔄 ปริเมตร: 2×(%s+%s) = %s ม.",
+             num(n0, shape.length, 0), num(n1, shape.width, 0), num(n2, perimeter, 2));
+    ESP_LOGI(TAG, "║ 🌾 เท่ากับ: %s ไร่", num(n0, area_in_rai, 4));
     ESP_LOGI(TAG, "╚══════════════════════════════════════╝");
 }
 
 // 🏊‍♀️ ฟังก์ชันคำนวณวงกลม
 void calculate_circle(shape_t shape) {
     double radius = shape.length;  // ใช้ length เป็น radius
-    double surface_area = PI * radius * radius;
-    double circumference = 2 * PI * radius;
+    double surface_area = arith_circle_area(radius);
+    double circumference = arith_circle_circumference(radius);
     double volume = surface_area * shape.height;  // ปริมาตรทรงกระบอก
-    
+    char n0[NUMFMT_BUF], n1[NUMFMT_BUF], n2[NUMFMT_BUF];
+
     ESP_LOGI(TAG, "╔══════════════════════════════════════╗");
     ESP_LOGI(TAG, "║          %s            ║", shape.name);
     ESP_LOGI(TAG, "╠══════════════════════════════════════╣");
-    ESP_LOGI(TAG, "║ 📏 รัศมี: %.2f เมตร", radius);
-    ESP_LOGI(TAG, "║ 📏 ความลึก: %.2f เมตร", shape.height);
-    ESP_LOGI(TAG, "║ 🌊 พื้นที่ผิวน้ำ: π × %.0f² = %.2f ตร.ม.", 
-             radius, surface_area);
-    ESP_LOGI(TAG, "║ ⭕ เส้นรอบวง: 2π × %.0f = %.2f ม.", 
-             radius, circumference);
-    ESP_LOGI(TAG, "║ 💧 ปริมาตรน้ำ: %.2f × %.2f = %.2f ลบ.ม.", 
-             surface_area, shape.height, volume);
+    ESP_LOGI(TAG, "║ 📏 รัศมี: %s เมตร", num(n0, radius, 2));
+    ESP_LOGI(TAG, "║ 📏 ความลึก: %s เมตร", num(n0, shape.height, 2));
+    ESP_LOGI(TAG, "║ 🌊 พื้นที่ผิวน้ำ: π × %s² = %s ตร.ม.", num(n0, radius, 0), num(n1, surface_area, 2));
+    ESP_LOGI(TAG, "║ ⭕ เส้นรอบวง: 2π × %s = %s ม.", num(n0, radius, 0), num(n1, circumference, 2));
+    ESP_LOGI(TAG, "║ 💧 ปริมาตรน้ำ: %s × %s = %s ลบ.ม.",
+             num(n0, surface_area, 2), num(n1, shape.height, 2), num(n2, volume, 2));
     ESP_LOGI(TAG, "╚══════════════════════════════════════╝");
 }
 
 // 🎁 ฟังก์ชันคำนวณทรงผีเสื้อ
 void calculate_box(shape_t shape) {
-    double volume = shape.length * shape.width * shape.height;
-    double surface_area = 2 * (shape.length * shape.width + 
-                               shape.width * shape.height + 
-                               shape.length * shape.height);
-    
+    double volume = arith_box_volume(shape.length, shape.width, shape.height);
+    double surface_area = arith_box_surface(shape.length, shape.width, shape.height);
+    char n0[NUMFMT_BUF], n1[NUMFMT_BUF], n2[NUMFMT_BUF], n3[NUMFMT_BUF];
+
     ESP_LOGI(TAG, "╔══════════════════════════════════════╗");
     ESP_LOGI(TAG, "║          %s          ║", shape.name);
     ESP_LOGI(TAG, "╠══════════════════════════════════════╣");
-    ESP_LOGI(TAG, "║ 📏 ความยาว: %.2f ซม.", shape.length);
-    ESP_LOGI(TAG, "║ 📏 ความกว้าง: %.2f ซม.", shape.width);
-    ESP_LOGI(TAG, "║ 📏 ความสูง: %.2f ซม.", shape.height);
-    ESP_LOGI(TAG, "║ 📦 ปริมาตร: %.0f×%.0f×%.0f = %.2f ลบ.ซม.", 
-             shape.length, shape.width, shape.height, volume);
-    ESP_LOGI(TAG, "║ 🎀 พื้นที่ผิว: %.2f ตร.ซม.", surface_area);
-    ESP_LOGI(TAG, "║ 📐 เท่ากับ: %.6f ลิตร", volume / 1000.0);
+    ESP_LOGI(TAG, "║ 📏 ความยาว: %s ซม.", num(n0, shape.length, 2));
+    ESP_LOGI(TAG, "║ 📏 ความกว้าง: %s ซม.", num(n0, shape.width, 2));
+    ESP_LOGI(TAG, "║ 📏 ความสูง: %s ซม.", num(n0, shape.height, 2));
+    ESP_LOGI(TAG, "║ 📦 ปริมาตร: %s×%s×%s = %s ลบ.ซม.",
+             num(n0, shape.length, 0), num(n1, shape.width, 0), num(n2, shape.height, 0), num(n3, volume, 2));
+    ESP_LOGI(TAG, "║ 🎀 พื้นที่ผิว: %s ตร.ซม.", num(n0, surface_area, 2));
+    ESP_LOGI(TAG, "║ 📐 เท่ากับ: %s ลิตร", num(n0, volume / 1000.0, 6));
     ESP_LOGI(TAG, "╚══════════════════════════════════════╝");
 }
 
@@ -113,19 +117,19 @@ void calculate_triangle_bonus(void) {
     double side2 = 8.0;     // ด้านที่ 2
     double side3 = 6.0;     // ด้านที่ 3
     
-    double area = 0.5 * base * height;
+    double area = arith_triangle_area(base, height);
     double perimeter = side1 + side2 + side3;
-    
+    char n0[NUMFMT_BUF], n1[NUMFMT_BUF], n2[NUMFMT_BUF], n3[NUMFMT_BUF];
+
     ESP_LOGI(TAG, "\n🎯 โบนัส: สามเหลี่ยม");
     ESP_LOGI(TAG, "╔═══════════════════════════════════════╗");
     ESP_LOGI(TAG, "║         สามเหลี่ยมมุมฉาก             ║");
     ESP_LOGI(TAG, "╠═══════════════════════════════════════╣");
-    ESP_LOGI(TAG, "║ 📏 ฐาน: %.2f ซม.", base);
-    ESP_LOGI(TAG, "║ 📏 สูง: %.2f ซม.", height);
-    ESP_LOGI(TAG, "║ 📐 พื้นที่: ½×%.0f×%.0f = %.2f ตร.ซม.", 
-             base, height, area);
-    ESP_LOGI(TAG, "║ 🔄 ปริเมตร: %.0f+%.0f+%.0f = %.2f ซม.", 
-             side1, side2, side3, perimeter);
+    ESP_LOGI(TAG, "║ 📏 ฐาน: %s ซม.", num(n0, base, 2));
+    ESP_LOGI(TAG, "║ 📏 สูง: %s ซม.", num(n0, height, 2));
+    ESP_LOGI(TAG, "║ 📐 พื้นที่: ½×%s×%s = %s ตร.ซม.", num(n0, base, 0), num(n1, height, 0), num(n2, area, 2));
+    ESP_LOGI(TAG, "║ 🔄 ปริเมตร: %s+%s+%s = %s ซม.",
+             num(n0, side1, 0), num(n1, side2, 0), num(n2, side3, 0), num(n3, perimeter, 2));
     ESP_LOGI(TAG, "╚═══════════════════════════════════════╝");
 }
 
@@ -193,39 +197,42 @@ void app_main(void) {
 }
 
 void calculate_triangle(double base, double height) {
-    double area = 0.5 * base * height;
+    double area = arith_triangle_area(base, height);
+    char n0[NUMFMT_BUF], n1[NUMFMT_BUF], n2[NUMFMT_BUF];
 
     ESP_LOGI(TAG, "\n🎯 พื้นที่สามเหลี่ยม");
     ESP_LOGI(TAG, "╔══════════════════════════════╗");
-    ESP_LOGI(TAG, "║ ฐาน: %.2f เมตร", base);
-    ESP_LOGI(TAG, "║ สูง: %.2f เมตร", height);
-    ESP_LOGI(TAG, "║ 📐 พื้นที่: ½ × %.2f × %.2f = %.2f ตร.ม.", base, height, area);
+    ESP_LOGI(TAG, "║ ฐาน: %s เมตร", num(n0, base, 2));
+    ESP_LOGI(TAG, "║ สูง: %s เมตร", num(n0, height, 2));
+    ESP_LOGI(TAG, "║ 📐 พื้นที่: ½ × %s × %s = %s ตร.ม.",
+             num(n0, base, 2), num(n1, height, 2), num(n2, area, 2));
     ESP_LOGI(TAG, "╚══════════════════════════════╝");
 }
 
 void calculate_cone(double radius, double height) {
-    double volume = (PI * radius * radius * height) / 3;
-    double slant = sqrt(radius * radius + height * height);
-    double surface_area = PI * radius * (radius + slant);
+    double volume = arith_cone_volume(radius, height);
+    double surface_area = arith_cone_surface(radius, height);
+    char n0[NUMFMT_BUF];
 
     ESP_LOGI(TAG, "\n🔺 ปริมาตรทรงกรวย");
     ESP_LOGI(TAG, "╔════════════════════════════════╗");
-    ESP_LOGI(TAG, "║ รัศมี: %.2f เมตร", radius);
-    ESP_LOGI(TAG, "║ ความสูง: %.2f เมตร", height);
-    ESP_LOGI(TAG, "║ 📐 พื้นที่ผิว: πr(r+√r²+h²) = %.2f ตร.ม.", surface_area);
-    ESP_LOGI(TAG, "║ 💧 ปริมาตร: (1/3)πr²h = %.2f ลบ.ม.", volume);
+    ESP_LOGI(TAG, "║ รัศมี: %s เมตร", num(n0, radius, 2));
+    ESP_LOGI(TAG, "║ ความสูง: %s เมตร", num(n0, height, 2));
+    ESP_LOGI(TAG, "║ 📐 พื้นที่ผิว: πr(r+√r²+h²) = %s ตร.ม.", num(n0, surface_area, 2));
+    ESP_LOGI(TAG, "║ 💧 ปริมาตร: (1/3)πr²h = %s ลบ.ม.", num(n0, volume, 2));
     ESP_LOGI(TAG, "╚════════════════════════════════╝");
 }
 
 void convert_to_rai(double length, double width) {
-    double area_sqm = length * width;
-    double area_rai = area_sqm / SQUARE_METERS_TO_RAI;
+    double area_sqm = arith_rectangle_area(length, width);
+    double area_rai = arith_sqm_to_rai(area_sqm);
+    char n0[NUMFMT_BUF];
 
     ESP_LOGI(TAG, "\n🔁 แปลงหน่วย: เมตร → ตร.ม. → ไร่");
     ESP_LOGI(TAG, "╔════════════════════════════════╗");
-    ESP_LOGI(TAG, "║ ความยาว: %.2f เมตร", length);
-    ESP_LOGI(TAG, "║ ความกว้าง: %.2f เมตร", width);
-    ESP_LOGI(TAG, "║ 📐 พื้นที่: %.2f ตร.ม.", area_sqm);
-    ESP_LOGI(TAG, "║ 🌾 เท่ากับ: %.4f ไร่", area_rai);
+    ESP_LOGI(TAG, "║ ความยาว: %s เมตร", num(n0, length, 2));
+    ESP_LOGI(TAG, "║ ความกว้าง: %s เมตร", num(n0, width, 2));
+    ESP_LOGI(TAG, "║ 📐 พื้นที่: %s ตร.ม.", num(n0, area_sqm, 2));
+    ESP_LOGI(TAG, "║ 🌾 เท่ากับ: %s ไร่", num(n0, area_rai, 4));
     ESP_LOGI(TAG, "╚════════════════════════════════╝");
 }
@@ -7,19 +7,21 @@
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "arith.h"
+#include "memstat.h"
 
 // 🏷️ Tag สำหรับ Log
 static const char *TAG = "ERROR_HANDLING";
 
-// 🚨 enum สำหรับประเภทข้อผิดพลาด
+// 🚨 enum สำหรับประเภทข้อผิดพลาด (ค่าตรงกับ arith_err_t ของคอมโพเนนต์ arith)
 typedef enum {
-    ERROR_NONE = 0,           // ไม่มีข้อผิดพลาด
-    ERROR_DIVISION_BY_ZERO,   // หารด้วยศูนย์
-    ERROR_INVALID_INPUT,      // ข้อมูลผิดประเภท
-    ERROR_OUT_OF_RANGE,       // ข้อมูลเกินขอบเขต
-    ERROR_NEGATIVE_VALUE,     // ค่าติดลบไม่เหมาะสม
-    ERROR_OVERFLOW,           // ข้อมูลล้น
-    ERROR_UNDERFLOW           // ข้อมูลต่ำเกินไป
+    ERROR_NONE = ARITH_OK,                          // ไม่มีข้อผิดพลาด
+    ERROR_DIVISION_BY_ZERO = ARITH_ERR_DIV_BY_ZERO, // หารด้วยศูนย์
+    ERROR_INVALID_INPUT = ARITH_ERR_INVALID_INPUT,  // ข้อมูลผิดประเภท
+    ERROR_OUT_OF_RANGE = ARITH_ERR_OUT_OF_RANGE,    // ข้อมูลเกินขอบเขต
+    ERROR_NEGATIVE_VALUE = ARITH_ERR_NEGATIVE,      // ค่าติดลบไม่เหมาะสม
+    ERROR_OVERFLOW = ARITH_ERR_OVERFLOW,            // ข้อมูลล้น
+    ERROR_UNDERFLOW = ARITH_ERR_UNDERFLOW           // ข้อมูลต่ำเกินไป
 } error_code_t;
 
 // 📊 โครงสร้างผลลัพธ์
@@ -66,8 +68,10 @@ calculation_result_t safe_divide(double dividend, double divisor, const char* co
     ESP_LOGI(TAG, "\n🔍 ตรวจสอบการหาร: %s", context);
     ESP_LOGI(TAG, "📊 %g ÷ %g = ?", dividend, divisor);
 
+    arith_err_t err = arith_div(dividend, divisor, &result.result);
+
     // ตรวจสอบหารด้วยศูนย์
-    if (divisor == 0.0) {
+    if (err == ARITH_ERR_DIV_BY_ZERO) {
         result.error = ERROR_DIVISION_BY_ZERO;
         snprintf(result.message, sizeof(result.message), "❌ ข้อผิดพลาด: ไม่สามารถหารด้วยศูนย์ได้!");
         ESP_LOGE(TAG, "%s", result.message);
@@ -77,8 +81,7 @@ calculation_result_t safe_divide(double dividend, double divisor, const char* co
     }
 
     // ตรวจสอบผลลัพธ์ล้น
-    result.result = dividend / divisor;
-    if (isinf(result.result)) {
+    if (err == ARITH_ERR_OVERFLOW) {
         result.error = ERROR_OVERFLOW;
         snprintf(result.message, sizeof(result.message), "⚠️ เตือน: ผลลัพธ์เป็น infinity!");
         ESP_LOGW(TAG, "%s", result.message);
@@ -121,7 +124,7 @@ calculation_result_t validate_money(double amount, const char* description) {
     }
 
     // ตรวจสอบทศนิยมมากเกินไป
-    double rounded = round(amount * 100) / 100;  // ปัดเศษสตางค์
+    double rounded = arith_round_satang(amount);  // ปัดเศษสตางค์
     if (fabs(amount - rounded) > 0.001) {
         ESP_LOGW(TAG, "⚠️ เตือน: ปัดเศษจาก %.4f เป็น %.2f บาท", amount, rounded);
         amount = rounded;
@@ -215,7 +218,7 @@ calculation_result_t calculate_interest(double principal, double rate, int years
     }
 
     // คำนวณดอกเบี้ยแบบง่าย
-    double interest = principal * (rate / 100.0) * years;
+    double interest = arith_simple_interest(principal, rate, years);
     double total = principal + interest;
 
     // ตรวจสอบ overflow
@@ -404,6 +407,10 @@ void show_error_handling_summary(void) {
 }
 
 void app_main(void) {
+    // 📏 เฝ้า stack ของ main task: ทุกฟังก์ชันคืน calculation_result_t (264 ไบต์) แบบ by value
+    memstat_init();
+    memstat_watch_task(NULL, NULL, MEMSTAT_MAIN_STACK_SIZE);  // ชื่อจริงของ task ("main" หรือชื่อ lab ใน 09)
+
     ESP_LOGI(TAG, "🚀 เริ่มต้นโปรแกรมจัดการข้อผิดพลาด!");
     ESP_LOGI(TAG, "🛡️ การตรวจสอบและป้องกันข้อผิดพลาด\n");
 
@@ -426,4 +433,13 @@ void app_main(void) {
     ESP_LOGI(TAG, "\n✅ เสร็จสิ้นการเรียนรู้การจัดการข้อผิดพลาด!");
     ESP_LOGI(TAG, "🎓 ได้เรียนรู้: enum, struct, error codes, และการตรวจสอบข้อมูล");
     ESP_LOGI(TAG, "🏆 ตอนนี้คุณสามารถเขียนโค้ดที่ปลอดภัยและน่าเชื่อถือแล้ว!");
+
+    // 📏 stack ที่ใช้จริงและ heap ที่เหลือหลังผ่านทุกสถานการณ์
+    // snapshot ~600 ไบต์ จองจาก heap ไม่วางบน stack ของ main task
+    memstat_snapshot_t *mem = malloc(sizeof(*mem));
+    if (mem != NULL) {
+        memstat_snapshot(mem);
+        memstat_report(TAG, mem);
+        free(mem);
+    }
 }
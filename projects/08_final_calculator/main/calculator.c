@@ -0,0 +1,537 @@
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sys/time.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "arith_batch.h"
+#include "numfmt.h"
+#include "sdkconfig.h"
+#include "calculator.h"
+#if !CONFIG_IDF_TARGET_LINUX
+#include "esp_rtc_time.h"
+#include "esp_system.h"
+#endif
+
+#if CONFIG_CALC_HISTORY_PSRAM
+#define HISTORY_PREFER_PSRAM true
+#else
+#define HISTORY_PREFER_PSRAM false
+#endif
+
+// 📡 ส่งเฟรม telemetry ออก stdout ทีละเฟรม
+static void telemetry_stdout_sink(void *ctx, const uint8_t *data, size_t len) {
+    (void)ctx;
+    fwrite(data, 1, len, stdout);
+    fflush(stdout);
+}
+
+// 🏗️ เตรียม context: ทุกอย่างที่ session ใช้ถูกจองไว้ใน context เอง
+// session 0 ใช้ tag เดิมของโปรแกรม session อื่นต่อท้ายหมายเลขเพื่อแยก log
+bool calculator_init(calculator_data_t *calc, int session) {
+    bool ok = true;
+
+    memset(calc, 0, sizeof(*calc));
+    calc->session = session;
+    if (session == 0) {
+        snprintf(calc->tag, sizeof(calc->tag), "FINAL_CALCULATOR");
+    } else {
+        snprintf(calc->tag, sizeof(calc->tag), "FINAL_CALC#%d", session);
+    }
+#if CONFIG_CALC_OUTPUT_BINARY
+    esp_log_level_set(calc->tag, ESP_LOG_WARN);
+#endif
+    telemetry_writer_init(&calc->telemetry, telemetry_stdout_sink, NULL);
+
+    if (!history_store_init(&calc->history, CONFIG_CALC_HISTORY_ARENA_SIZE,
+                            HISTORY_PREFER_PSRAM)) {
+        ESP_LOGE(calc->tag, "❌ จองหน่วยความจำประวัติ %d ไบต์ไม่สำเร็จ - ปิดการบันทึกประวัติ",
+                 CONFIG_CALC_HISTORY_ARENA_SIZE);
+        ok = false;
+    }
+    if (!history_stats_init(&calc->stats, OP_COUNT, CONFIG_CALC_STATS_BUCKETS,
+                            CONFIG_CALC_STATS_BUCKET_SEC * 1000u)) {
+        ESP_LOGE(calc->tag, "❌ จองหน่วยความจำสถิติไม่สำเร็จ - ปิดสถิติแยกตามเวลา");
+        ok = false;
+    }
+#if CONFIG_CALC_BIGINT_ARENA_SIZE > 0
+    void *arena = malloc(CONFIG_CALC_BIGINT_ARENA_SIZE);
+    if (arena == NULL) {
+        ESP_LOGE(calc->tag, "❌ จองหน่วยความจำแฟกทอเรียลตรงทุกหลักไม่สำเร็จ - ใช้ค่า double แทน");
+        ok = false;
+    }
+    bigint_arena_init(&calc->bigint, arena, CONFIG_CALC_BIGINT_ARENA_SIZE);
+#endif
+#if CONFIG_CALC_STREAM_WINDOW > 0
+    if (!stream_stats_init(&calc->stream, CONFIG_CALC_STREAM_WINDOW,
+                           CONFIG_CALC_STREAM_EWMA_PERCENT / 100.0)) {
+        ESP_LOGE(calc->tag, "❌ จองหน่วยความจำหน้าต่างสตรีม %d ค่าไม่สำเร็จ - ปิดขั้นสตรีม",
+                 CONFIG_CALC_STREAM_WINDOW);
+        ok = false;
+    }
+#endif
+    calc->current_mode = MODE_MAIN_MENU;
+    calc->shop_tax_rate = 7.0;
+    return ok;
+}
+
+void calculator_deinit(calculator_data_t *calc) {
+    history_store_free(&calc->history);
+    history_stats_free(&calc->stats);
+    free(calc->bigint.base);
+    bigint_arena_init(&calc->bigint, NULL, 0);
+    stream_stats_free(&calc->stream);
+}
+
+// 📡 ส่งผลการคำนวณหนึ่งรายการเป็นเรคคอร์ดไบนารี (เฉพาะโหมดไบนารี)
+void emit_result(calculator_data_t *calc, operation_t op, double op1, double op2, double result, arith_err_t err, int id) {
+#if CONFIG_CALC_OUTPUT_BINARY
+    telemetry_record_t rec = {
+        .op = (uint8_t)op,
+        .err = (uint8_t)err,
+        .n_operands = calc_op(op) ? calc_op(op)->arity : 2,
+        .id = (uint32_t)id,
+        .timestamp_ms = (uint32_t)(esp_timer_get_time() / 1000),
+        .operands = {op1, op2},
+        .result = result,
+    };
+    telemetry_write(&calc->telemetry, &rec);
+#else
+    (void)calc; (void)op; (void)op1; (void)op2; (void)result; (void)err; (void)id;
+#endif
+}
+
+// ⏰ เวลาปัจจุบันเป็นมิลลิวินาที (เก็บในประวัติ)
+int64_t current_time_ms(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000 + tv.tv_usec / 1000;
+}
+
+// ⏱️ µs ตั้งแต่รีเซ็ต: ตัวนับ RTC เริ่มที่ 0 ตอนจ่ายไฟจึงรวม ROM + bootloader แล้ว
+// แต่ไม่ถูกล้างตอน esp_restart()/watchdog/deep sleep — รีเซ็ตแบบนั้นนับได้แค่ตั้งแต่แอปเริ่ม (esp_timer)
+int64_t time_since_reset_us(void) {
+#if !CONFIG_IDF_TARGET_LINUX
+    if (esp_reset_reason() == ESP_RST_POWERON) {
+        return (int64_t)esp_rtc_get_time_us();
+    }
+#endif
+    return esp_timer_get_time();
+}
+
+// ⏰ ฟังก์ชันสร้าง timestamp
+void create_timestamp(char* buffer, size_t size, int64_t time_ms) {
+    time_t now = (time_t)(time_ms / 1000);
+    struct tm timeinfo;
+    localtime_r(&now, &timeinfo);
+    strftime(buffer, size, "%Y-%m-%d %H:%M:%S", &timeinfo);
+}
+
+// 💾 ฟังก์ชันบันทึกประวัติ (code = operation_t หรือ operation_t | HISTORY_SALE)
+// ไม่เก็บข้อความคำอธิบาย สร้างใหม่จากค่าที่เก็บไว้ตอนแสดงผล
+// คืนค่า true ถ้าเป็นผลแรกของ session นับจากบูต (จดเวลาตั้งแต่รีเซ็ตไว้ใน first_result_us)
+static bool record_result(calculator_data_t *calc, uint8_t code, int64_t now,
+                          double op1, double op2, double result) {
+    history_store_append(&calc->history, code, now, op1, op2, result);
+    history_stats_add(&calc->stats, code & ~HISTORY_SALE, now, result);
+    calc->total_calculations++;
+    if (calc->first_result_us != 0) {
+        return false;
+    }
+    calc->first_result_us = time_since_reset_us();
+    return true;
+}
+
+void save_to_history(calculator_data_t *calc, uint8_t code, double op1, double op2, double result, const char* desc) {
+    bool first = record_result(calc, code, current_time_ms(), op1, op2, result);
+    
+    ESP_LOGI(calc->tag, "💾 บันทึกประวัติ #%d: %s", calc->total_calculations, desc);
+    if (first) {
+        ESP_LOGI(calc->tag, "⏱️ รีเซ็ต → ผลแรก: %lld µs (นับจากแอปเริ่ม %lld µs)",
+                 (long long)calc->first_result_us, (long long)esp_timer_get_time());
+    }
+}
+
+// 🔢 kernel ของแต่ละ op (เคอร์เนลจริงอยู่ในคอมโพเนนต์ arith) — ไม่พิมพ์ log
+static arith_err_t op_add(double a, double b, double *out) {
+    *out = arith_add(a, b);
+    return ARITH_OK;
+}
+
+static arith_err_t op_sub(double a, double b, double *out) {
+    *out = arith_sub(a, b);
+    return ARITH_OK;
+}
+
+static arith_err_t op_mul(double a, double b, double *out) {
+    *out = arith_mul(a, b);
+    return ARITH_OK;
+}
+
+static arith_err_t op_sqrt(double a, double unused, double *out) {
+    (void)unused;
+    return arith_sqrt(a, out);
+}
+
+static arith_err_t op_factorial(double n, double unused, double *out) {
+    (void)unused;
+    if (n > INT_MAX) {
+        *out = INFINITY;
+        return ARITH_ERR_OVERFLOW;
+    }
+    if (!(n >= INT_MIN)) {
+        *out = NAN;
+        return isnan(n) ? ARITH_ERR_INVALID_INPUT : ARITH_ERR_NEGATIVE;
+    }
+    return arith_factorial((int)n, out);
+}
+
+// 📐 เรขาคณิต: ค่าลบได้ NaN จาก arith
+static arith_err_t op_circle(double radius, double unused, double *out) {
+    (void)unused;
+    *out = arith_circle_area(radius);
+    return isnan(*out) ? ARITH_ERR_NEGATIVE : ARITH_OK;
+}
+
+static arith_err_t op_rectangle(double length, double width, double *out) {
+    *out = arith_rectangle_area(length, width);
+    return isnan(*out) ? ARITH_ERR_NEGATIVE : ARITH_OK;
+}
+
+// op1 = พื้นที่ฐาน (ยาว × กว้าง), op2 = ความสูง
+static arith_err_t op_box(double base_area, double height, double *out) {
+    *out = arith_box_volume(base_area, 1.0, height);
+    return isnan(*out) ? ARITH_ERR_NEGATIVE : ARITH_OK;
+}
+
+// 💰 การเงิน
+static arith_err_t op_percentage(double value, double percent, double *out) {
+    *out = arith_percentage(value, percent);
+    return ARITH_OK;
+}
+
+static arith_err_t op_discount(double price, double percent, double *out) {
+    return arith_discount_percent(price, percent, out);
+}
+
+static arith_err_t op_tax(double amount, double rate, double *out) {
+    return arith_add_tax(amount, rate, out);
+}
+
+// ✅ ตัวตรวจ: ข้อความแจ้งของแต่ละ op (ระดับ log เดิมของแต่ละกรณี)
+static arith_err_t check_range(calculator_data_t *calc, const calc_op_t *op,
+                               double op1, double op2, double *result, arith_err_t err) {
+    (void)op1; (void)op2; (void)result;
+    ESP_LOGW(calc->tag, "⚠️ เตือน: ผล%sเกินขอบเขต (%s)!", op->name, arith_err_name(err));
+    return err;
+}
+
+static arith_err_t check_divide(calculator_data_t *calc, const calc_op_t *op,
+                                double op1, double op2, double *result, arith_err_t err) {
+    if (err != ARITH_ERR_DIV_BY_ZERO) {
+        return check_range(calc, op, op1, op2, result, err);
+    }
+    ESP_LOGE(calc->tag, "❌ ข้อผิดพลาด: ไม่สามารถหารด้วยศูนย์ได้!");
+    return err;
+}
+
+static arith_err_t check_power(calculator_data_t *calc, const calc_op_t *op,
+                               double op1, double op2, double *result, arith_err_t err) {
+    if (err == ARITH_ERR_INVALID_INPUT) {
+        ESP_LOGE(calc->tag, "❌ ข้อผิดพลาด: ฐานติดลบยกกำลังเศษส่วนไม่ได้ (ผลไม่ใช่จำนวนจริง)!");
+        return err;
+    }
+    if (err != ARITH_ERR_DIV_BY_ZERO) {
+        return check_range(calc, op, op1, op2, result, err);
+    }
+    ESP_LOGE(calc->tag, "❌ ข้อผิดพลาด: 0 ยกกำลังลบไม่ได้!");
+    return err;
+}
+
+static arith_err_t check_sqrt(calculator_data_t *calc, const calc_op_t *op,
+                              double op1, double op2, double *result, arith_err_t err) {
+    if (err != ARITH_ERR_NEGATIVE) {
+        return check_range(calc, op, op1, op2, result, err);
+    }
+    ESP_LOGE(calc->tag, "❌ ข้อผิดพลาด: ไม่สามารถหารากที่สองของจำนวนลบได้!");
+    return err;
+}
+
+static arith_err_t check_negative(calculator_data_t *calc, const calc_op_t *op,
+                                  double op1, double op2, double *result, arith_err_t err) {
+    if (err != ARITH_ERR_NEGATIVE) {
+        return check_range(calc, op, op1, op2, result, err);
+    }
+    ESP_LOGE(calc->tag, "❌ %s", op->label);
+    return err;
+}
+
+static arith_err_t check_discount(calculator_data_t *calc, const calc_op_t *op,
+                                  double op1, double op2, double *result, arith_err_t err) {
+    if (err != ARITH_ERR_OUT_OF_RANGE) {
+        return check_range(calc, op, op1, op2, result, err);
+    }
+    ESP_LOGW(calc->tag, "⚠️ ส่วนลดควรอยู่ระหว่าง 0-100%%");
+    return err;
+}
+
+static arith_err_t check_tax(calculator_data_t *calc, const calc_op_t *op,
+                             double op1, double op2, double *result, arith_err_t err) {
+    if (err != ARITH_ERR_NEGATIVE) {
+        return check_range(calc, op, op1, op2, result, err);
+    }
+    ESP_LOGW(calc->tag, "⚠️ อัตราภาษีไม่ควรเป็นลบ");
+    return err;
+}
+
+const char *calculator_factorial_exact(calculator_data_t *calc, int n, double *approx) {
+    bigint_arena_t *arena = &calc->bigint;
+    bigint_t f;
+
+    bigint_arena_release(arena, 0);
+    if (bigint_factorial(arena, n, &f) != ARITH_OK) {
+        return NULL;
+    }
+    size_t size = bigint_decimal_size(&f) + 1;
+    char *text = bigint_arena_alloc(arena, size);
+    if (text == NULL || bigint_to_decimal(arena, &f, text, size) == 0) {
+        return NULL;
+    }
+    *approx = bigint_to_double(&f);
+    return text;
+}
+
+// ❗ แฟกทอเรียลเกิน 20: คำนวณตรงทุกหลักแล้วพิมพ์เป็นเลขฐานสิบ ผลที่คืนเป็นค่าโดยประมาณ
+// ถ้าปิด bigint หรือ arena ไม่พอ คงผล inf ไว้พร้อมคำเตือน
+static arith_err_t check_factorial(calculator_data_t *calc, const calc_op_t *op,
+                                   double op1, double op2, double *result, arith_err_t err) {
+    (void)op; (void)op2;
+    if (err == ARITH_ERR_NEGATIVE) {
+        ESP_LOGE(calc->tag, "❌ ข้อผิดพลาด: แฟกทอเรียลของจำนวนลบไม่ได้!");
+        return err;
+    }
+    if (err == ARITH_ERR_OVERFLOW && op1 <= INT_MAX && calc->bigint.size > 0) {
+        int n = (int)op1;
+        double approx;
+        const char *digits = calculator_factorial_exact(calc, n, &approx);
+        if (digits != NULL) {
+            ESP_LOGI(calc->tag, "🔢 %d! = %s (%u หลัก)", n, digits, (unsigned)strlen(digits));
+            *result = approx;
+            return ARITH_OK;
+        }
+        ESP_LOGW(calc->tag, "⚠️ หน่วยความจำไม่พอสำหรับ %d! แบบตรงทุกหลัก (ใช้ได้ %u ไบต์)",
+                 n, (unsigned)calc->bigint.size);
+    }
+    ESP_LOGW(calc->tag, "⚠️ เตือน: แฟกทอเรียลใหญ่เกินไป!");
+    return err;
+}
+
+// 📝 ตัวจัดข้อความ: ตัวเลขจัดรูปด้วย numfmt ก่อน snprintf เหลือแค่ต่อ %s
+// (printf ของ float ช้าและกิน stack มาก)
+static inline const char *fix2(char *buf, double v) {
+    return numfmt_fixed_str(buf, v, 2, 0);
+}
+
+static void fmt_binary(char *buf, size_t size, const calc_op_t *op, double op1, double op2, double result) {
+    char a[NUMFMT_BUF], b[NUMFMT_BUF], r[NUMFMT_BUF];
+    snprintf(buf, size, "%s %s %s = %s", fix2(a, op1), op->label, fix2(b, op2), fix2(r, result));
+}
+
+static void fmt_sqrt(char *buf, size_t size, const calc_op_t *op, double op1, double op2, double result) {
+    char a[NUMFMT_BUF], r[NUMFMT_BUF];
+    (void)op; (void)op2;
+    snprintf(buf, size, "√%s = %s", fix2(a, op1), fix2(r, result));
+}
+
+static void fmt_factorial(char *buf, size_t size, const calc_op_t *op, double op1, double op2, double result) {
+    char a[NUMFMT_BUF], r[NUMFMT_BUF];
+    (void)op; (void)op2;
+    snprintf(buf, size, "%s! = %s", numfmt_fixed_str(a, op1, 0, 0), numfmt_shortest_str(r, result, 0));
+}
+
+static void fmt_circle(char *buf, size_t size, const calc_op_t *op, double op1, double op2, double result) {
+    char a[NUMFMT_BUF], r[NUMFMT_BUF];
+    (void)op; (void)op2;
+    snprintf(buf, size, "พื้นที่วงกลม r=%s = %s", fix2(a, op1), fix2(r, result));
+}
+
+static void fmt_rectangle(char *buf, size_t size, const calc_op_t *op, double op1, double op2, double result) {
+    char a[NUMFMT_BUF], b[NUMFMT_BUF], r[NUMFMT_BUF];
+    (void)op;
+    snprintf(buf, size, "พื้นที่สี่เหลี่ยม %s×%s = %s", fix2(a, op1), fix2(b, op2), fix2(r, result));
+}
+
+static void fmt_box(char *buf, size_t size, const calc_op_t *op, double op1, double op2, double result) {
+    char r[NUMFMT_BUF];
+    (void)op; (void)op1; (void)op2;
+    snprintf(buf, size, "ปริมาตรกล่อง = %s", fix2(r, result));
+}
+
+static void fmt_percent(char *buf, size_t size, const calc_op_t *op, double op1, double op2, double result) {
+    char a[NUMFMT_BUF], b[NUMFMT_BUF], r[NUMFMT_BUF];
+    (void)op;
+    snprintf(buf, size, "%s%% ของ %s = %s", fix2(b, op2), fix2(a, op1), fix2(r, result));
+}
+
+// "ค่าเฉลี่ย 64 ค่า (รวม 1600.00) = 25.00"
+static void fmt_mean(char *buf, size_t size, const calc_op_t *op, double op1, double op2, double result) {
+    char a[NUMFMT_BUF], b[NUMFMT_BUF], r[NUMFMT_BUF];
+    (void)op;
+    snprintf(buf, size, "ค่าเฉลี่ย %s ค่า (รวม %s) = %s",
+             numfmt_fixed_str(b, op2, 0, 0), fix2(a, op1), fix2(r, result));
+}
+
+// "ลด 10.00% จาก 100.00 = 90.00" (label = "ลด" / "ภาษี")
+static void fmt_rate(char *buf, size_t size, const calc_op_t *op, double op1, double op2, double result) {
+    char a[NUMFMT_BUF], b[NUMFMT_BUF], r[NUMFMT_BUF];
+    snprintf(buf, size, "%s %s%% จาก %s = %s", op->label, fix2(b, op2), fix2(a, op1), fix2(r, result));
+}
+
+// 📋 ทะเบียน: หนึ่งแถวของ CALC_OPERATIONS = หนึ่ง descriptor (index = รหัส op)
+#define CALC_OP_ROW(id, tok, nm, n, kern, bat, chk, fmt, lbl)                                  \
+    [OP_##id] = { .token = tok, .name = nm, .label = lbl, .arity = n,                            \
+                  .kernel = kern, .batch = bat, .check = chk, .format = fmt },
+
+const calc_op_t calc_ops[OP_COUNT] = {
+    CALC_OPERATIONS(CALC_OP_ROW)
+};
+
+#undef CALC_OP_ROW
+
+// 🔇 เรียก kernel แล้วจัดผลที่เป็น inf/NaN เป็นรหัสข้อผิดพลาด (ไม่แตกแขนงถ้าผลปกติ)
+static inline arith_err_t run_kernel(const calc_op_t *op, double op1, double op2, double *out) {
+    arith_err_t err = op->kernel(op1, op2, out);
+    return err != ARITH_OK ? err : arith_errmask_first(arith_value_mask(*out));
+}
+
+// 📝 สร้างข้อความอธิบายการคำนวณ (ใช้ทั้งตอนคำนวณและตอนแสดงประวัติ)
+void describe_calculation(char* buffer, size_t size, operation_t op,
+                          double op1, double op2, double result) {
+    const calc_op_t *d = calc_op(op);
+    if (d == NULL) {
+        snprintf(buffer, size, "?");
+        return;
+    }
+    d->format(buffer, size, d, op1, op2, result);
+}
+
+// 🎯 ฟังก์ชันประมวลผลการคำนวณ
+double perform_calculation(calculator_data_t *calc, operation_t op, double op1, double op2) {
+    int64_t start_time = esp_timer_get_time();
+    const calc_op_t *d = calc_op(op);
+    double result;
+    char description[100];
+
+    if (d == NULL) {
+        ESP_LOGE(calc->tag, "❌ การดำเนินการไม่รู้จัก!");
+        calc->last_error = ARITH_ERR_INVALID_INPUT;
+        emit_result(calc, op, op1, op2, NAN, ARITH_ERR_INVALID_INPUT, 0);
+        return NAN;
+    }
+    arith_err_t err = run_kernel(d, op1, op2, &result);
+    if (err != ARITH_OK) {
+        err = d->check(calc, d, op1, op2, &result, err);
+    }
+    calc->last_error = err;
+    d->format(description, sizeof(description), d, op1, op2, result);
+    
+    int64_t end_time = esp_timer_get_time();
+    double computation_time = (end_time - start_time) / 1000.0; // มิลลิวินาที
+    calc->total_computation_time += computation_time;
+    
+    if (!isnan(result) && !isinf(result)) {
+        save_to_history(calc, op, op1, op2, result, description);
+        ESP_LOGI(calc->tag, "✅ %s", description);
+        ESP_LOGI(calc->tag, "⏱️ ใช้เวลา: %.3f มิลลิวินาที", computation_time);
+        emit_result(calc, op, op1, op2, result, calc->last_error, calc->total_calculations);
+    } else {
+        emit_result(calc, op, op1, op2, result, calc->last_error, 0);
+    }
+    
+    return result;
+}
+
+// 📦 ช่วงของ op เดียวกันที่ติดกันและมีเคอร์เนลชุด คำนวณทั้งช่วงครั้งเดียว (คืนจำนวนที่ทำไป)
+#define EVAL_RUN_MAX 32
+
+static size_t evaluate_run(const calc_op_t *d, const calc_request_t *req, calc_response_t *resp, size_t n) {
+    double a[EVAL_RUN_MAX], b[EVAL_RUN_MAX], out[EVAL_RUN_MAX];
+    operation_t op = req[0].op;
+    size_t run = 0;
+
+    while (run < n && run < EVAL_RUN_MAX && req[run].op == op) {
+        a[run] = req[run].op1;
+        b[run] = req[run].op2;
+        run++;
+    }
+    arith_errmask_t mask = d->batch(a, b, out, run);
+    for (size_t i = 0; i < run; i++) {
+        resp[i].result = out[i];
+        resp[i].err = ARITH_OK;
+    }
+    // ส่วนใหญ่ทั้งชุดถูกต้อง ไล่หาตัวที่ผิดด้วย kernel เดี่ยวเฉพาะเมื่อ mask ไม่เป็น 0
+    if (mask != 0) {
+        for (size_t i = 0; i < run; i++) {
+            resp[i].err = run_kernel(d, a[i], b[i], &resp[i].result);
+        }
+    }
+    return run;
+}
+
+void calculator_evaluate_batch(calculator_data_t *calc, const calc_request_t *req,
+                               calc_response_t *resp, size_t n) {
+    int64_t start_time = esp_timer_get_time();
+    size_t i = 0;
+
+    while (i < n) {
+        const calc_op_t *d = calc_op(req[i].op);
+        if (d == NULL) {
+            resp[i].result = NAN;
+            resp[i].err = ARITH_ERR_INVALID_INPUT;
+            i++;
+        } else if (d->batch != NULL && i + 1 < n && req[i + 1].op == req[i].op) {
+            i += evaluate_run(d, &req[i], &resp[i], n - i);
+        } else {
+            resp[i].err = run_kernel(d, req[i].op1, req[i].op2, &resp[i].result);
+            i++;
+        }
+    }
+
+    // บันทึกประวัติ/สถิติเหมือน perform_calculation: เก็บทุกผลที่เป็นตัวเลขจริง
+    int64_t now = current_time_ms();
+    for (i = 0; i < n; i++) {
+        resp[i].id = req[i].id;
+        if (isfinite(resp[i].result)) {
+            record_result(calc, (uint8_t)req[i].op, now, req[i].op1, req[i].op2, resp[i].result);
+        }
+    }
+    calc->last_error = n > 0 ? resp[n - 1].err : ARITH_OK;
+    calc->total_computation_time += (esp_timer_get_time() - start_time) / 1000.0;
+}
+
+size_t calculator_stream_push(calculator_data_t *calc, const double *samples, size_t n) {
+    stream_stats_t *s = &calc->stream;
+    if (s->window == 0) {
+        return 0;
+    }
+    int64_t start_time = esp_timer_get_time();
+    size_t accepted = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        if (!stream_stats_push(s, samples[i])) {
+            continue;
+        }
+        accepted++;
+        // ครบหน้าต่าง: ring วนกลับช่อง 0 และผลรวม/ค่าเฉลี่ยเพิ่งถูกคำนวณใหม่ทั้งรอบ
+        if (s->pos == 0) {
+            double sum = s->sum + s->sum_comp;
+            record_result(calc, OP_WINDOW_MEAN, current_time_ms(), sum, s->window, s->mean);
+            emit_result(calc, OP_WINDOW_MEAN, sum, s->window, s->mean, ARITH_OK, calc->total_calculations);
+        }
+    }
+    calc->total_computation_time += (esp_timer_get_time() - start_time) / 1000.0;
+    return accepted;
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "arith.h"
+#include "arith_batch.h"
+#include "bigint.h"
+#include "history_store.h"
+#include "history_stats.h"
+#include "stream_stats.h"
+#include "telemetry.h"
+
+// 🧮 แกนเครื่องคิดเลข: สถานะทั้งหมดอยู่ใน calculator_data_t (context)
+// ทุกฟังก์ชันที่อ่าน/เขียนสถานะรับ context เป็นพารามิเตอร์แรก ไม่มีตัวแปรโกลบอลที่แก้ไขได้
+// แต่ละ session (เทอร์มินัล/task) มี context ของตัวเอง จึงรันพร้อมกันหลาย core ได้โดยไม่ต้องล็อก
+
+// 📊 enum สำหรับโหมดการทำงาน
+typedef enum {
+    MODE_MAIN_MENU = 0,
+    MODE_BASIC,
+    MODE_ADVANCED,
+    MODE_SHOP,
+    MODE_HISTORY,
+    MODE_EXIT
+} calculator_mode_t;
+
+// 🧮 ทะเบียนการดำเนินการ: ทุกทาง (คำนวณเดี่ยว, batch, เซิร์ฟเวอร์, ประวัติ, telemetry) ใช้ตารางนี้
+// เพิ่ม op ใหม่ = เพิ่มหนึ่งแถว (+ kernel/formatter ใน calculator.c ถ้ายังไม่มีตัวที่ใช้ร่วมได้)
+// ลำดับแถวคือรหัส op ที่เก็บในประวัติและ telemetry — เพิ่มต่อท้ายเท่านั้น ห้ามสลับ
+//   X(ชื่อ, token ใน line protocol, ชื่อในตารางสถิติ, จำนวน operand,
+//     kernel, kernel แบบชุด (NULL = ไม่มี), ตัวตรวจ, ตัวจัดข้อความ, ป้ายในข้อความ)
+#define CALC_OPERATIONS(X)                                                                            \
+    X(ADD,            "+",      "บวก",        2, op_add,        arith_add_batch, check_range,     fmt_binary,    "+")  \
+    X(SUBTRACT,       "-",      "ลบ",         2, op_sub,        arith_sub_batch, check_range,     fmt_binary,    "-")  \
+    X(MULTIPLY,       "*",      "คูณ",        2, op_mul,        arith_mul_batch, check_range,     fmt_binary,    "×")  \
+    X(DIVIDE,         "/",      "หาร",        2, arith_div,     arith_div_batch, check_divide,    fmt_binary,    "÷")  \
+    X(POWER,          "^",      "ยกกำลัง",    2, arith_power,   NULL,            check_power,     fmt_binary,    "^")  \
+    X(SQRT,           "sqrt",   "ราก",        1, op_sqrt,       NULL,            check_sqrt,      fmt_sqrt,      NULL) \
+    X(FACTORIAL,      "!",      "แฟกทอเรียล", 1, op_factorial,  NULL,            check_factorial, fmt_factorial, NULL) \
+    X(AREA_CIRCLE,    "circle", "วงกลม",      1, op_circle,     NULL,            check_negative,  fmt_circle,    "รัศมีไม่สามารถเป็นลบได้!") \
+    X(AREA_RECTANGLE, "rect",   "สี่เหลี่ยม", 2, op_rectangle,  NULL,            check_negative,  fmt_rectangle, "ความยาวและความกว้างไม่สามารถเป็นลบได้!") \
+    X(VOLUME_BOX,     "box",    "กล่อง",      2, op_box,        NULL,            check_negative,  fmt_box,       "ขนาดทุกด้านต้องเป็นบวก!") \
+    X(PERCENTAGE,     "%",      "เปอร์เซ็นต์", 2, op_percentage, NULL,            check_range,     fmt_percent,   NULL) \
+    X(DISCOUNT,       "disc",   "ส่วนลด",     2, op_discount,   NULL,            check_discount,  fmt_rate,      "ลด") \
+    X(TAX,            "tax",    "ภาษี",       2, op_tax,        NULL,            check_tax,       fmt_rate,      "ภาษี") \
+    X(WINDOW_MEAN,    "mean",   "ค่าเฉลี่ยสตรีม", 2, arith_div,   NULL,            check_divide,    fmt_mean,      NULL)
+
+typedef enum {
+    OP_NONE = 0,                // รหัส 0 ไม่ใช้ (คำขอ/เรคคอร์ดที่ไม่รู้จัก)
+#define CALC_OP_ENUM(id, ...) OP_##id,
+    CALC_OPERATIONS(CALC_OP_ENUM)
+#undef CALC_OP_ENUM
+    OP_COUNT
+} operation_t;
+
+// 🧾 รหัสในประวัติ = operation_t หรือรวมบิตนี้สำหรับการขายหน้าร้าน
+#define HISTORY_SALE 0x80
+
+#define CART_MAX 10
+#define CALC_RECEIPT_SIZE 2048      // บัฟเฟอร์ใบเสร็จต่อ session (ตะกร้าเต็ม 10 รายการ ≈ 1.3 KB)
+
+// 🛒 หนึ่งรายการในตะกร้า: ข้อมูลสินค้า (ชื่อ ราคา หมวด) อยู่ในแคตตาล็อก shop_catalog ไม่คัดลอกมาเก็บ
+typedef struct {
+    uint32_t item;              // ดัชนีใน shop_catalog (ผลของ catalog_find)
+    int quantity;
+    double total;
+} cart_line_t;
+
+// 💾 โครงสร้างข้อมูลเครื่องคิดเลข (หนึ่ง context ต่อหนึ่ง session)
+typedef struct {
+    int session;                // หมายเลข session (0 = session หลัก)
+    char tag[24];               // log tag ของ session นี้
+    history_store_t history;    // ประวัติแบบบีบอัด จองใน calculator_init
+    history_stats_t stats;      // สถิติสะสมแยกตาม op และช่วงเวลา (อัปเดตใน save_to_history)
+    telemetry_writer_t telemetry;
+    bigint_arena_t bigint;      // arena ของแฟกทอเรียลแบบตรงทุกหลัก (size 0 = ปิด)
+    stream_stats_t stream;      // ขั้นสตรีมของค่าต่อเนื่อง (window 0 = ปิด)
+    int total_calculations;
+    double total_computation_time;
+    int64_t first_result_us;    // µs ตั้งแต่รีเซ็ตถึงผลแรกของ session (0 = ยังไม่มีผล)
+    calculator_mode_t current_mode;
+    cart_line_t cart[CART_MAX];
+    int cart_count;
+    double shop_total;
+    double shop_discount;
+    double shop_tax_rate;
+    bool shop_member;           // ลูกค้าสมาชิก (ราคาสมาชิก/โปรเฉพาะสมาชิก)
+    char receipt[CALC_RECEIPT_SIZE];    // ใบเสร็จล่าสุด (receipt.h วางลงที่นี่แล้วส่งออกทั้งก้อน)
+    arith_err_t last_error;     // ผลตรวจสอบของการคำนวณล่าสุด
+} calculator_data_t;
+
+// 🏗️ เตรียม context ใหม่ (จองประวัติและสถิติตามค่าใน menuconfig)
+// คืนค่า false ถ้าจองหน่วยความจำไม่สำเร็จ (context ยังใช้ได้ แต่ไม่มีประวัติ/สถิติ)
+bool calculator_init(calculator_data_t *calc, int session);
+void calculator_deinit(calculator_data_t *calc);
+
+// ⏰ เวลา
+int64_t current_time_ms(void);
+int64_t time_since_reset_us(void);
+void create_timestamp(char* buffer, size_t size, int64_t time_ms);
+
+// 💾 ประวัติ
+void save_to_history(calculator_data_t *calc, uint8_t code, double op1, double op2,
+                     double result, const char* desc);
+
+// 📋 descriptor ของหนึ่ง op (สร้างจาก CALC_OPERATIONS ดู calc_ops)
+typedef struct calc_op calc_op_t;
+
+// kernel ไม่พิมพ์ log: เขียนผลลง *out เสมอ (NaN/inf เมื่อผิด) แล้วคืนรหัสข้อผิดพลาด
+typedef arith_err_t (*calc_kernel_fn)(double op1, double op2, double *out);
+typedef arith_errmask_t (*calc_batch_fn)(const double *a, const double *b, double *out, size_t n);
+// ตัวตรวจ (เฉพาะทางที่พิมพ์ log) เรียกเมื่อ kernel คืนข้อผิดพลาด: แจ้งด้วยข้อความของ op
+// แล้วคืนรหัสสุดท้าย แก้ *result ได้ (เช่น n! เกิน 20 คำนวณใหม่แบบตรงทุกหลัก)
+typedef arith_err_t (*calc_check_fn)(calculator_data_t *calc, const calc_op_t *op,
+                                     double op1, double op2, double *result, arith_err_t err);
+typedef void (*calc_format_fn)(char *buf, size_t size, const calc_op_t *op,
+                               double op1, double op2, double result);
+
+struct calc_op {
+    const char *token;          // ชื่อสั้น ASCII ใน line protocol (server.h, tools/loadgen)
+    const char *name;           // ชื่อสั้นในตารางสถิติ
+    const char *label;          // สัญลักษณ์/คำ/ข้อความผิดพลาดที่ตัวจัดข้อความหรือตัวตรวจใช้
+    uint8_t arity;              // จำนวน operand (telemetry)
+    calc_kernel_fn kernel;
+    calc_batch_fn batch;        // เคอร์เนลทั้งอาร์เรย์ของ arith (NULL = คำนวณทีละตัว)
+    calc_check_fn check;
+    calc_format_fn format;
+};
+
+// แถวที่ 0 (OP_NONE) เป็นศูนย์ทั้งหมด
+extern const calc_op_t calc_ops[OP_COUNT];
+
+// 🔎 descriptor ของ op หรือ NULL ถ้ารหัสไม่รู้จัก
+static inline const calc_op_t *calc_op(operation_t op) {
+    return (unsigned)op < OP_COUNT && calc_ops[op].kernel != NULL ? &calc_ops[op] : NULL;
+}
+
+// ❗ n! แบบตรงทุกหลักเป็นเลขฐานสิบ อยู่ใน arena ของ context (ใช้ได้จนถึงการเรียกครั้งถัดไป)
+// *approx = ค่าเป็น double (inf เมื่อ n > 170) คืน NULL ถ้า n < 0 หรือ arena ไม่พอ
+const char *calculator_factorial_exact(calculator_data_t *calc, int n, double *approx);
+
+// 📝 ข้อความอธิบายการคำนวณ (ใช้ทั้งตอนคำนวณและตอนแสดงประวัติ)
+void describe_calculation(char* buffer, size_t size, operation_t op,
+                          double op1, double op2, double result);
+
+// 🎯 คำนวณ บันทึกประวัติ และส่ง telemetry ในครั้งเดียว
+double perform_calculation(calculator_data_t *calc, operation_t op, double op1, double op2);
+
+// 🌊 ป้อนค่าต่อเนื่อง (เช่นเซนเซอร์) เข้าขั้นสตรีม O(1) ต่อค่า ไม่พิมพ์ log คืนจำนวนที่รับ (NaN/inf ถูกทิ้ง)
+// ทุกครั้งที่ครบหน้าต่าง บันทึกค่าเฉลี่ยของหน้าต่างลงประวัติ/สถิติเป็น OP_WINDOW_MEAN
+// (op1 = ผลรวม, op2 = จำนวนค่า) แทนการบันทึกทุกค่าที่จะล้น arena ของประวัติ
+size_t calculator_stream_push(calculator_data_t *calc, const double *samples, size_t n);
+
+// 📨 คำขอ/คำตอบหนึ่งรายการ (โหมดเซิร์ฟเวอร์ ดู server.h)
+typedef struct {
+    uint32_t id;
+    operation_t op;
+    double op1;
+    double op2;
+} calc_request_t;
+
+typedef struct {
+    uint32_t id;
+    arith_err_t err;
+    double result;
+} calc_response_t;
+
+// 📦 คำนวณคำขอทั้งชุดโดยไม่พิมพ์ log — resp[i] ตอบ req[i] ตามลำดับเดิม
+// op พื้นฐานที่ติดกันใช้เคอร์เนลชุดของ arith ผลที่เป็นตัวเลขจริงถูกบันทึกลงประวัติและสถิติ
+void calculator_evaluate_batch(calculator_data_t *calc, const calc_request_t *req,
+                               calc_response_t *resp, size_t n);
+
+// 📡 ส่งผลหนึ่งรายการเป็นเรคคอร์ดไบนารี (เฉพาะ CONFIG_CALC_OUTPUT_BINARY)
+void emit_result(calculator_data_t *calc, operation_t op, double op1, double op2,
+                 double result, arith_err_t err, int id);
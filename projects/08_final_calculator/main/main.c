@@ -2,331 +2,142 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
-#include <time.h>
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "arith_batch.h"
+#include "sdkconfig.h"
+#include "calculator.h"
+#include "catalog.h"
+#include "memstat.h"
+#include "pricing.h"
+#include "receipt.h"
+#if CONFIG_CALC_SERVER
+#include "server.h"
+#endif
+#if CONFIG_CALC_WARM_SNAPSHOT
+#include "snapshot.h"
+#endif
+#if CONFIG_CALC_OUTPUT_BINARY && !CONFIG_IDF_TARGET_LINUX
+#include "driver/uart_vfs.h"
+#endif
+#if CONFIG_ARITH_BENCH
+#include "arith_bench.h"
+#endif
 
 // 🏷️ Tag สำหรับ Log
 static const char *TAG = "FINAL_CALCULATOR";
 
+// 🎨 ข้อความตกแต่งคงที่ (โลโก้, กรอบเมนู, สรุปการเรียนรู้)
+// ใน lean build (CONFIG_CALC_LEAN) ถูกตัดทิ้งทั้งหมด ข้อความไม่ถูกเก็บใน flash
+#if CONFIG_CALC_LEAN
+#define UI_LOGI(tag, format, ...) do { if (0) { ESP_LOGI(tag, format, ##__VA_ARGS__); } } while (0)
+#else
+#define UI_LOGI(tag, format, ...) ESP_LOGI(tag, format, ##__VA_ARGS__)
+#endif
+
+// ⏸️ หน่วงจังหวะของเดโมให้คนอ่านทัน — fast boot (CONFIG_CALC_FAST_BOOT) ตัดทิ้งทั้งหมด
+#if CONFIG_CALC_FAST_BOOT
+#define DEMO_PAUSE(ms) do { } while (0)
+#else
+#define DEMO_PAUSE(ms) vTaskDelay(pdMS_TO_TICKS(ms))
+#endif
+
 // 🎯 ค่าคงที่
-#define PI 3.14159265359
-#define MAX_HISTORY 50
 #define MAX_DISPLAY_LENGTH 20
 #define VERSION "1.0.0"
+#define SESSION_STACK_SIZE 6144
+
+// 🏷️ หมวดสินค้าของร้าน (ดัชนีหมวดในกฎราคา และคอลัมน์ category ของ shop_catalog.csv)
+enum { SHOP_CAT_GENERAL = 0, SHOP_CAT_DRINKS, SHOP_CAT_BAKERY, SHOP_CAT_FRESH };
+
+// 📜 กฎราคาของร้าน: compile เป็นตารางครั้งเดียวตอนเริ่ม ทุก session ใช้ตารางเดียวกัน (อ่านอย่างเดียว)
+// เพิ่มโปรโมชันได้เป็นร้อยข้อ เวลาคิดเงินไม่เปลี่ยน
+static const pricing_rule_t shop_rules[] = {
+    PRICING_CART_DISCOUNT(1000, 0, 0),                          // ส่วนลด 10% ทั้งตะกร้า
+    PRICING_CART_DISCOUNT(1500, 100000, PRICING_MEMBER_ONLY),   // สมาชิกซื้อครบ 1,000 บาท ลด 15%
+    PRICING_CATEGORY_DISCOUNT(SHOP_CAT_BAKERY, 500, PRICING_MEMBER_ONLY),
+    PRICING_MEMBER_PRICE(3, 3900),                              // กาแฟกระป๋อง ราคาสมาชิก 39 บาท
+    PRICING_BUY_X_GET_Y(1, 5, 1, 0),                            // น้ำดื่ม ซื้อ 5 แถม 1
+};
+// สินค้าที่ยกเว้น VAT (เช่นของสด) กำหนดต่อรายการในคอลัมน์ vat ของ shop_catalog.csv ไม่ใช่ในกฎ
+static pricing_table_t shop_pricing;
+
+// 🛒 แคตตาล็อกสินค้า สร้างจาก main/shop_catalog.csv ตอน build (catalog_generate ใน main/CMakeLists.txt)
+extern const catalog_t shop_catalog;
+
+// 🧾 รูปแบบใบเสร็จ 42 ช่อง (ความกว้างกระดาษ thermal 80 มม.) เตรียมครั้งเดียวตอนเริ่ม
+static const receipt_layout_t shop_receipt_layout = {
+    .currency = " บาท", .width = 42, .money_cols = 10, .qty_cols = 14,
+};
+static receipt_template_t shop_receipt;
+
+// 📡 เปิดโหมดไบนารี: ปิด log ข้อความระดับ INFO และส่งผลเป็นเรคคอร์ดแทน
+// (แต่ละ session ตั้งระดับ log ของ tag ตัวเองใน calculator_init)
+void telemetry_begin(void) {
+#if CONFIG_CALC_OUTPUT_BINARY
+#if !CONFIG_IDF_TARGET_LINUX
+    // ห้าม VFS แปลง '\n' เป็น "\r\n" ในข้อมูลไบนารี
+    uart_vfs_dev_port_set_tx_line_endings(CONFIG_ESP_CONSOLE_UART_NUM, ESP_LINE_ENDINGS_LF);
+#endif
+    esp_log_level_set(TAG, ESP_LOG_WARN);
+#endif
+}
 
-// 📊 enum สำหรับโหมดการทำงาน
-typedef enum {
-    MODE_MAIN_MENU = 0,
-    MODE_BASIC,
-    MODE_ADVANCED,
-    MODE_SHOP,
-    MODE_HISTORY,
-    MODE_EXIT
-} calculator_mode_t;
-
-// 🧮 enum สำหรับการดำเนินการ
-typedef enum {
-    OP_ADD = 1, OP_SUBTRACT, OP_MULTIPLY, OP_DIVIDE,
-    OP_POWER, OP_SQRT, OP_FACTORIAL,
-    OP_AREA_CIRCLE, OP_AREA_RECTANGLE, OP_VOLUME_BOX,
-    OP_PERCENTAGE, OP_DISCOUNT, OP_TAX
-} operation_t;
-
-// 🧾 โครงสร้างประวัติการคำนวณ
-typedef struct {
-    int id;
-    operation_t operation;
-    double operand1;
-    double operand2;
-    double result;
-    char timestamp[20];
-    char description[100];
-} calculation_history_t;
-
-// 🛒 โครงสร้างสินค้า
-typedef struct {
-    int id;
-    char name[50];
-    double price;
-    int quantity;
-    double total;
-} product_t;
-
-// 💾 โครงสร้างข้อมูลเครื่องคิดเลข
-typedef struct {
-    calculation_history_t history[MAX_HISTORY];
-    int history_count;
-    int total_calculations;
-    double total_computation_time;
-    calculator_mode_t current_mode;
-    product_t cart[10];
-    int cart_count;
-    double shop_total;
-    double shop_discount;
-    double shop_tax_rate;
-} calculator_data_t;
-
-// 🌍 ตัวแปรโกลบอล
-static calculator_data_t calc_data = {0};
+// 📏 เริ่มวัดหน่วยความจำ: เฝ้า stack ของ task ที่เรียก และลงทะเบียน static ก้อนใหญ่ของแอป
+// context ของ session (ตัวละหลาย KB), ตารางกฎราคา และ template ใบเสร็จ
+static void memory_begin(size_t sessions_bytes) {
+    memstat_init();
+    memstat_watch_task(NULL, NULL, MEMSTAT_MAIN_STACK_SIZE);  // ชื่อจริงของ task ("main" หรือชื่อ lab ใน 09)
+    memstat_add_static("calc sessions", sessions_bytes);
+    MEMSTAT_ADD_STATIC("pricing", shop_pricing);
+    MEMSTAT_ADD_STATIC("receipt", shop_receipt);
+}
 
 // 🎨 ฟังก์ชันแสดง ASCII Art Logo
 void show_logo(void) {
-    ESP_LOGI(TAG, "╔════════════════════════════════════════════════╗");
+    UI_LOGI(TAG, "╔════════════════════════════════════════════════╗");
     ESP_LOGI(TAG, "║          🧮 เครื่องคิดเลขครบครัน v%s        ║", VERSION);
-    ESP_LOGI(TAG, "║                ESP32 Calculator               ║");
-    ESP_LOGI(TAG, "╠════════════════════════════════════════════════╣");
-    ESP_LOGI(TAG, "║  📱 Modern • 🛡️ Safe • ⚡ Fast • 🎯 Accurate  ║");
-    ESP_LOGI(TAG, "╚════════════════════════════════════════════════╝");
-    ESP_LOGI(TAG, "");
-    ESP_LOGI(TAG, "    🧮    💻    📊    🏪");
-    ESP_LOGI(TAG, "   Basic Advanced Stats Shop");
-    ESP_LOGI(TAG, "");
-}
-
-// ⏰ ฟังก์ชันสร้าง timestamp
-void create_timestamp(char* buffer, size_t size) {
-    time_t now;
-    struct tm timeinfo;
-    time(&now);
-    localtime_r(&now, &timeinfo);
-    strftime(buffer, size, "%Y-%m-%d %H:%M:%S", &timeinfo);
-}
-
-// 💾 ฟังก์ชันบันทึกประวัติ
-void save_to_history(operation_t op, double op1, double op2, double result, const char* desc) {
-    if (calc_data.history_count >= MAX_HISTORY) {
-        // ลบประวัติเก่าที่สุด
-        for (int i = 0; i < MAX_HISTORY - 1; i++) {
-            calc_data.history[i] = calc_data.history[i + 1];
-        }
-        calc_data.history_count = MAX_HISTORY - 1;
-    }
-    
-    calculation_history_t* entry = &calc_data.history[calc_data.history_count];
-    entry->id = calc_data.total_calculations + 1;
-    entry->operation = op;
-    entry->operand1 = op1;
-    entry->operand2 = op2;
-    entry->result = result;
-    strncpy(entry->description, desc, sizeof(entry->description) - 1);
-    create_timestamp(entry->timestamp, sizeof(entry->timestamp));
-    
-    calc_data.history_count++;
-    calc_data.total_calculations++;
-    
-    ESP_LOGI(TAG, "💾 บันทึกประวัติ #%d: %s", entry->id, desc);
-}
-
-// 🔢 ฟังก์ชันการคำนวณพื้นฐาน
-double safe_add(double a, double b) {
-    return a + b;
-}
-
-double safe_subtract(double a, double b) {
-    return a - b;
-}
-
-double safe_multiply(double a, double b) {
-    return a * b;
-}
-
-double safe_divide(double a, double b) {
-    if (b == 0.0) {
-        ESP_LOGE(TAG, "❌ ข้อผิดพลาด: ไม่สามารถหารด้วยศูนย์ได้!");
-        return NAN;
-    }
-    return a / b;
-}
-
-double safe_power(double base, double exponent) {
-    if (base == 0.0 && exponent < 0) {
-        ESP_LOGE(TAG, "❌ ข้อผิดพลาด: 0 ยกกำลังลบไม่ได้!");
-        return NAN;
-    }
-    return pow(base, exponent);
-}
-
-double safe_sqrt(double a) {
-    if (a < 0) {
-        ESP_LOGE(TAG, "❌ ข้อผิดพลาด: ไม่สามารถหารากที่สองของจำนวนลบได้!");
-        return NAN;
-    }
-    return sqrt(a);
-}
-
-double safe_factorial(int n) {
-    if (n < 0) {
-        ESP_LOGE(TAG, "❌ ข้อผิดพลาด: แฟกทอเรียลของจำนวนลบไม่ได้!");
-        return NAN;
-    }
-    if (n > 20) {
-        ESP_LOGW(TAG, "⚠️ เตือน: แฟกทอเรียลใหญ่เกินไป!");
-        return INFINITY;
-    }
-    
-    double result = 1.0;
-    for (int i = 2; i <= n; i++) {
-        result *= i;
-    }
-    return result;
+    UI_LOGI(TAG, "║                ESP32 Calculator               ║");
+    UI_LOGI(TAG, "╠════════════════════════════════════════════════╣");
+    UI_LOGI(TAG, "║  📱 Modern • 🛡️ Safe • ⚡ Fast • 🎯 Accurate  ║");
+    UI_LOGI(TAG, "╚════════════════════════════════════════════════╝");
+    UI_LOGI(TAG, "");
+    UI_LOGI(TAG, "    🧮    💻    📊    🏪");
+    UI_LOGI(TAG, "   Basic Advanced Stats Shop");
+    UI_LOGI(TAG, "");
 }
 
-// 📐 ฟังก์ชันเรขาคณิต
-double calculate_circle_area(double radius) {
-    if (radius < 0) {
-        ESP_LOGE(TAG, "❌ รัศมีไม่สามารถเป็นลบได้!");
-        return NAN;
-    }
-    return PI * radius * radius;
-}
-
-double calculate_rectangle_area(double length, double width) {
-    if (length < 0 || width < 0) {
-        ESP_LOGE(TAG, "❌ ความยาวและความกว้างไม่สามารถเป็นลบได้!");
-        return NAN;
-    }
-    return length * width;
-}
-
-double calculate_box_volume(double length, double width, double height) {
-    if (length < 0 || width < 0 || height < 0) {
-        ESP_LOGE(TAG, "❌ ขนาดทุกด้านต้องเป็นบวก!");
-        return NAN;
-    }
-    return length * width * height;
-}
-
-// 💰 ฟังก์ชันการเงิน
-double calculate_percentage(double value, double percent) {
-    return (value * percent) / 100.0;
-}
-
-double apply_discount(double original_price, double discount_percent) {
-    if (discount_percent < 0 || discount_percent > 100) {
-        ESP_LOGW(TAG, "⚠️ ส่วนลดควรอยู่ระหว่าง 0-100%%");
-        return original_price;
-    }
-    double discount = calculate_percentage(original_price, discount_percent);
-    return original_price - discount;
-}
-
-double apply_tax(double amount, double tax_rate) {
-    if (tax_rate < 0) {
-        ESP_LOGW(TAG, "⚠️ อัตราภาษีไม่ควรเป็นลบ");
-        return amount;
-    }
-    double tax = calculate_percentage(amount, tax_rate);
-    return amount + tax;
-}
-
-// 🎯 ฟังก์ชันประมวลผลการคำนวณ
-double perform_calculation(operation_t op, double op1, double op2) {
-    int64_t start_time = esp_timer_get_time();
-    double result = 0.0;
-    char description[100];
-    
-    switch (op) {
-        case OP_ADD:
-            result = safe_add(op1, op2);
-            sprintf(description, "%.2f + %.2f = %.2f", op1, op2, result);
-            break;
-        case OP_SUBTRACT:
-            result = safe_subtract(op1, op2);
-            sprintf(description, "%.2f - %.2f = %.2f", op1, op2, result);
-            break;
-        case OP_MULTIPLY:
-            result = safe_multiply(op1, op2);
-            sprintf(description, "%.2f × %.2f = %.2f", op1, op2, result);
-            break;
-        case OP_DIVIDE:
-            result = safe_divide(op1, op2);
-            sprintf(description, "%.2f ÷ %.2f = %.2f", op1, op2, result);
-            break;
-        case OP_POWER:
-            result = safe_power(op1, op2);
-            sprintf(description, "%.2f ^ %.2f = %.2f", op1, op2, result);
-            break;
-        case OP_SQRT:
-            result = safe_sqrt(op1);
-            sprintf(description, "√%.2f = %.2f", op1, result);
-            break;
-        case OP_FACTORIAL:
-            result = safe_factorial((int)op1);
-            sprintf(description, "%.0f! = %.0f", op1, result);
-            break;
-        case OP_AREA_CIRCLE:
-            result = calculate_circle_area(op1);
-            sprintf(description, "พื้นที่วงกลม r=%.2f = %.2f", op1, result);
-            break;
-        case OP_AREA_RECTANGLE:
-            result = calculate_rectangle_area(op1, op2);
-            sprintf(description, "พื้นที่สี่เหลี่ยม %.2f×%.2f = %.2f", op1, op2, result);
-            break;
-        case OP_VOLUME_BOX:
-            // ใช้ op1 เป็น length×width, op2 เป็น height
-            result = op1 * op2;
-            sprintf(description, "ปริมาตรกล่อง = %.2f", result);
-            break;
-        case OP_PERCENTAGE:
-            result = calculate_percentage(op1, op2);
-            sprintf(description, "%.2f%% ของ %.2f = %.2f", op2, op1, result);
-            break;
-        case OP_DISCOUNT:
-            result = apply_discount(op1, op2);
-            sprintf(description, "ลด %.2f%% จาก %.2f = %.2f", op2, op1, result);
-            break;
-        case OP_TAX:
-            result = apply_tax(op1, op2);
-            sprintf(description, "ภาษี %.2f%% จาก %.2f = %.2f", op2, op1, result);
-            break;
-        default:
-            ESP_LOGE(TAG, "❌ การดำเนินการไม่รู้จัก!");
-            return NAN;
-    }
-    
-    int64_t end_time = esp_timer_get_time();
-    double computation_time = (end_time - start_time) / 1000.0; // มิลลิวินาที
-    calc_data.total_computation_time += computation_time;
-    
-    if (!isnan(result) && !isinf(result)) {
-        save_to_history(op, op1, op2, result, description);
-        ESP_LOGI(TAG, "✅ %s", description);
-        ESP_LOGI(TAG, "⏱️ ใช้เวลา: %.3f มิลลิวินาที", computation_time);
-    }
-    
-    return result;
-}
 
 // 🖥️ ฟังก์ชันแสดงเมนูหลัก
-void show_main_menu(void) {
-    ESP_LOGI(TAG, "\n╔══════════════════════════════════════════════════╗");
-    ESP_LOGI(TAG, "║                   🧮 เมนูหลัก                   ║");
-    ESP_LOGI(TAG, "╠══════════════════════════════════════════════════╣");
-    ESP_LOGI(TAG, "║ [1] 🔢 โหมดพื้นฐาน - Basic Calculator         ║");
-    ESP_LOGI(TAG, "║ [2] 🔬 โหมดขั้นสูง - Advanced Mathematics     ║");
-    ESP_LOGI(TAG, "║ [3] 🏪 โหมดร้านค้า - Shop POS System          ║");
-    ESP_LOGI(TAG, "║ [4] 📊 โหมดประวัติ - History & Statistics     ║");
-    ESP_LOGI(TAG, "║ [0] 🚪 ออกจากโปรแกรม - Exit                  ║");
-    ESP_LOGI(TAG, "╚══════════════════════════════════════════════════╝");
-    ESP_LOGI(TAG, "");
-    ESP_LOGI(TAG, "📊 สถิติ: %d การคำนวณ | %.2f มิลลิวินาที รวม", 
-             calc_data.total_calculations, calc_data.total_computation_time);
+void show_main_menu(calculator_data_t *calc) {
+    UI_LOGI(calc->tag, "\n╔══════════════════════════════════════════════════╗");
+    UI_LOGI(calc->tag, "║                   🧮 เมนูหลัก                   ║");
+    UI_LOGI(calc->tag, "╠══════════════════════════════════════════════════╣");
+    UI_LOGI(calc->tag, "║ [1] 🔢 โหมดพื้นฐาน - Basic Calculator         ║");
+    UI_LOGI(calc->tag, "║ [2] 🔬 โหมดขั้นสูง - Advanced Mathematics     ║");
+    UI_LOGI(calc->tag, "║ [3] 🏪 โหมดร้านค้า - Shop POS System          ║");
+    UI_LOGI(calc->tag, "║ [4] 📊 โหมดประวัติ - History & Statistics     ║");
+    UI_LOGI(calc->tag, "║ [0] 🚪 ออกจากโปรแกรม - Exit                  ║");
+    UI_LOGI(calc->tag, "╚══════════════════════════════════════════════════╝");
+    UI_LOGI(calc->tag, "");
+    ESP_LOGI(calc->tag, "📊 สถิติ: %d การคำนวณ | %.2f มิลลิวินาที รวม", 
+             calc->total_calculations, calc->total_computation_time);
 }
 
 // 🔢 ฟังก์ชันโหมดพื้นฐาน
-void basic_calculator_mode(void) {
-    ESP_LOGI(TAG, "\n🔢 === โหมดพื้นฐาน ===");
-    ESP_LOGI(TAG, "╔═══════════════════════════════════════╗");
-    ESP_LOGI(TAG, "║         การดำเนินการพื้นฐาน         ║");
-    ESP_LOGI(TAG, "╠═══════════════════════════════════════╣");
-    ESP_LOGI(TAG, "║ [1] ➕ บวก     [2] ➖ ลบ            ║");
-    ESP_LOGI(TAG, "║ [3] ✖️ คูณ      [4] ➗ หาร           ║");
-    ESP_LOGI(TAG, "║ [5] 🔢 ยกกำลัง [6] √ รากที่สอง      ║");
-    ESP_LOGI(TAG, "║ [7] ! แฟกทอเรียล                    ║");
-    ESP_LOGI(TAG, "╚═══════════════════════════════════════╝");
+void basic_calculator_mode(calculator_data_t *calc) {
+    UI_LOGI(calc->tag, "\n🔢 === โหมดพื้นฐาน ===");
+    UI_LOGI(calc->tag, "╔═══════════════════════════════════════╗");
+    UI_LOGI(calc->tag, "║         การดำเนินการพื้นฐาน         ║");
+    UI_LOGI(calc->tag, "╠═══════════════════════════════════════╣");
+    UI_LOGI(calc->tag, "║ [1] ➕ บวก     [2] ➖ ลบ            ║");
+    UI_LOGI(calc->tag, "║ [3] ✖️ คูณ      [4] ➗ หาร           ║");
+    UI_LOGI(calc->tag, "║ [5] 🔢 ยกกำลัง [6] √ รากที่สอง      ║");
+    UI_LOGI(calc->tag, "║ [7] ! แฟกทอเรียล                    ║");
+    UI_LOGI(calc->tag, "╚═══════════════════════════════════════╝");
     
     // จำลองการเลือกและการคำนวณ
     double demo_values[][2] = {
@@ -343,218 +154,547 @@ void basic_calculator_mode(void) {
                                OP_POWER, OP_SQRT, OP_FACTORIAL};
     
     for (int i = 0; i < 7; i++) {
-        vTaskDelay(pdMS_TO_TICKS(1500));
-        ESP_LOGI(TAG, "\n🎯 ตัวอย่างที่ %d:", i + 1);
-        perform_calculation(operations[i], demo_values[i][0], demo_values[i][1]);
+        DEMO_PAUSE(1500);
+        ESP_LOGI(calc->tag, "\n🎯 ตัวอย่างที่ %d:", i + 1);
+        perform_calculation(calc, operations[i], demo_values[i][0], demo_values[i][1]);
+    }
+}
+
+#if CONFIG_CALC_STREAM_WINDOW > 0
+#define STREAM_DEMO_SAMPLES 256
+#define STREAM_DEMO_CHUNK 32
+
+// 🌊 จำลองเซนเซอร์อุณหภูมิ: ค่ามาเป็นชุดละ 32 ค่า (คลื่นช้า + สัญญาณรบกวน และค่าเสียหนึ่งค่า)
+static void stream_demo(calculator_data_t *calc) {
+    double chunk[STREAM_DEMO_CHUNK];
+    uint32_t noise = 2463534242u;
+    stream_snapshot_t snap;
+
+    for (int i = 0; i < STREAM_DEMO_SAMPLES; i += STREAM_DEMO_CHUNK) {
+        for (int k = 0; k < STREAM_DEMO_CHUNK; k++) {
+            noise ^= noise << 13; noise ^= noise >> 17; noise ^= noise << 5;
+            chunk[k] = 25.0 + 2.0 * sin((i + k) * 0.05) + (noise % 100) / 100.0;
+        }
+        if (i == 128) {
+            chunk[7] = NAN;     // เซนเซอร์อ่านพลาด: ขั้นสตรีมทิ้งให้เอง
+        }
+        calculator_stream_push(calc, chunk, STREAM_DEMO_CHUNK);
     }
+    stream_stats_snapshot(&calc->stream, &snap);
+    ESP_LOGI(calc->tag, "🌊 หน้าต่าง %lu ค่าล่าสุด: เฉลี่ย %.2f | SD %.2f | ต่ำสุด %.2f | สูงสุด %.2f | รวม %.2f",
+             (unsigned long)snap.window_count, snap.mean, sqrt(snap.variance), snap.min, snap.max, snap.sum);
+    ESP_LOGI(calc->tag, "📈 ทั้งสาย %llu ค่า (ทิ้ง %llu): เฉลี่ย %.2f | SD %.2f | ต่ำสุด %.2f | สูงสุด %.2f | EWMA %.2f",
+             (unsigned long long)snap.count, (unsigned long long)snap.rejected, snap.total_mean,
+             sqrt(snap.total_variance), snap.total_min, snap.total_max, snap.ewma);
 }
+#endif
 
 // 🔬 ฟังก์ชันโหมดขั้นสูง
-void advanced_calculator_mode(void) {
-    ESP_LOGI(TAG, "\n🔬 === โหมดขั้นสูง ===");
-    ESP_LOGI(TAG, "╔══════════════════════════════════════════╗");
-    ESP_LOGI(TAG, "║            คณิตศาสตร์ขั้นสูง           ║");
-    ESP_LOGI(TAG, "╠══════════════════════════════════════════╣");
-    ESP_LOGI(TAG, "║ 📐 เรขาคณิต และ การคำนวณพิเศษ         ║");
-    ESP_LOGI(TAG, "╚══════════════════════════════════════════╝");
+void advanced_calculator_mode(calculator_data_t *calc) {
+    UI_LOGI(calc->tag, "\n🔬 === โหมดขั้นสูง ===");
+    UI_LOGI(calc->tag, "╔══════════════════════════════════════════╗");
+    UI_LOGI(calc->tag, "║            คณิตศาสตร์ขั้นสูง           ║");
+    UI_LOGI(calc->tag, "╠══════════════════════════════════════════╣");
+    UI_LOGI(calc->tag, "║ 📐 เรขาคณิต และ การคำนวณพิเศษ         ║");
+    UI_LOGI(calc->tag, "╚══════════════════════════════════════════╝");
     
     // ตัวอย่างการคำนวณขั้นสูง
-    vTaskDelay(pdMS_TO_TICKS(1000));
-    ESP_LOGI(TAG, "\n🎯 พื้นที่วงกลม รัศมี 5 เมตร:");
-    perform_calculation(OP_AREA_CIRCLE, 5.0, 0);
-    
-    vTaskDelay(pdMS_TO_TICKS(1000));
-    ESP_LOGI(TAG, "\n🎯 พื้นที่สี่เหลี่ยม 8×6 เมตร:");
-    perform_calculation(OP_AREA_RECTANGLE, 8.0, 6.0);
-    
-    vTaskDelay(pdMS_TO_TICKS(1000));
-    ESP_LOGI(TAG, "\n🎯 15% ของ 200 บาท:");
-    perform_calculation(OP_PERCENTAGE, 200.0, 15.0);
+    DEMO_PAUSE(1000);
+    UI_LOGI(calc->tag, "\n🎯 พื้นที่วงกลม รัศมี 5 เมตร:");
+    perform_calculation(calc, OP_AREA_CIRCLE, 5.0, 0);
+    
+    DEMO_PAUSE(1000);
+    UI_LOGI(calc->tag, "\n🎯 พื้นที่สี่เหลี่ยม 8×6 เมตร:");
+    perform_calculation(calc, OP_AREA_RECTANGLE, 8.0, 6.0);
+    
+    DEMO_PAUSE(1000);
+    ESP_LOGI(calc->tag, "\n🎯 15%% ของ 200 บาท:");
+    perform_calculation(calc, OP_PERCENTAGE, 200.0, 15.0);
+
+#if CONFIG_CALC_STREAM_WINDOW > 0
+    DEMO_PAUSE(1000);
+    UI_LOGI(calc->tag, "\n🎯 อุณหภูมิจากเซนเซอร์ต่อเนื่อง %d ค่า:", STREAM_DEMO_SAMPLES);
+    stream_demo(calc);
+#endif
+}
+
+// 🏷️ ป้าย "ชื่อ 10%:" จากอัตรา basis point (แสดงทศนิยมเฉพาะเมื่อไม่ลงตัว)
+static void percent_label(char *buf, size_t size, const char *name, uint32_t bp) {
+    if (bp % 100 == 0) {
+        snprintf(buf, size, "%s %lu%%:", name, (unsigned long)(bp / 100));
+    } else {
+        snprintf(buf, size, "%s %lu.%02lu%%:", name, (unsigned long)(bp / 100), (unsigned long)(bp % 100));
+    }
+}
+
+// 🧾 วางใบเสร็จทั้งใบลงบัฟเฟอร์ของ session แล้วส่งออก stdout ครั้งเดียว (ไม่มี prefix ของ log)
+static void print_receipt(calculator_data_t *calc, const pricing_line_t *lines,
+                          const pricing_totals_t *t) {
+    receipt_t r;
+    char label[48];
+    int64_t start = esp_timer_get_time();
+    
+    receipt_begin(&r, &shop_receipt, calc->receipt, sizeof(calc->receipt));
+    receipt_text(&r, "🧾 ใบเสร็จ ร้านสะดวกซื้อ \"คิดเก่ง\"");
+    receipt_rule(&r, true);
+    for (int i = 0; i < calc->cart_count; i++) {
+        int64_t line_total;
+        (void)arith_satang_mul(lines[i].unit_price, lines[i].quantity, &line_total); // uint32 × uint32 ไม่ล้น int64
+        receipt_item(&r, catalog_name(&shop_catalog, calc->cart[i].item), lines[i].quantity, lines[i].unit_price,
+                     line_total);
+    }
+    receipt_rule(&r, false);
+    receipt_amount(&r, "ยอดรวม:", 0, t->subtotal);
+    if (t->line_discount != 0) {
+        receipt_amount(&r, "โปรโมชัน:", '-', t->line_discount);
+    }
+    percent_label(label, sizeof(label), "ส่วนลด", t->cart_discount_bp);
+    receipt_amount(&r, label, '-', t->cart_discount);
+    receipt_amount(&r, "หลังหักส่วนลด:", 0, t->net);
+    percent_label(label, sizeof(label), "ภาษี", (uint32_t)llround(calc->shop_tax_rate * 100));
+    receipt_amount(&r, label, '+', t->vat);
+    receipt_rule(&r, true);
+    receipt_amount(&r, "ยอดชำระสุทธิ:", 0, t->total);
+    int64_t laid_out = esp_timer_get_time();
+    
+#if !CONFIG_CALC_OUTPUT_BINARY
+    // โหมดไบนารีใช้ stdout ส่งเฟรม telemetry จึงไม่พิมพ์ใบเสร็จ
+    receipt_emit(&r, receipt_sink_stdio, NULL);
+#endif
+    int64_t sent = esp_timer_get_time();
+    if (r.truncated) {
+        ESP_LOGW(calc->tag, "⚠️ ใบเสร็จยาวเกินบัฟเฟอร์ %u ไบต์ - บางบรรทัดถูกตัด",
+                 (unsigned)sizeof(calc->receipt));
+    }
+    ESP_LOGI(calc->tag, "⏱️ ใบเสร็จ %u บรรทัด %u ไบต์ ใช้เวลาวาง %lld µs ส่ง %lld µs",
+             (unsigned)r.lines, (unsigned)r.len, (long long)(laid_out - start),
+             (long long)(sent - laid_out));
 }
 
 // 🏪 ฟังก์ชันโหมดร้านค้า
-void shop_mode(void) {
-    ESP_LOGI(TAG, "\n🏪 === โหมดร้านค้า ===");
-    ESP_LOGI(TAG, "🛒 ระบบ POS ร้านสะดวกซื้อ \"คิดเก่ง\"");
+void shop_mode(calculator_data_t *calc) {
+    UI_LOGI(calc->tag, "\n🏪 === โหมดร้านค้า ===");
+    UI_LOGI(calc->tag, "🛒 ระบบ POS ร้านสะดวกซื้อ \"คิดเก่ง\"");
     
     // เคลียร์ตะกร้า
-    calc_data.cart_count = 0;
-    calc_data.shop_total = 0;
-    calc_data.shop_discount = 10.0;  // ส่วนลด 10%
-    calc_data.shop_tax_rate = 7.0;   // ภาษี 7%
-    
-    // จำลองการเพิ่มสินค้า
-    product_t demo_products[] = {
-        {1, "น้ำดื่ม", 15.0, 2, 0},
-        {2, "ขนมปัง", 25.0, 1, 0},
-        {3, "กาแฟกระป๋อง", 45.0, 3, 0}
+    calc->cart_count = 0;
+    calc->shop_total = 0;
+    calc->shop_tax_rate = 7.0;   // ภาษี 7% (ส่วนลด/โปรโมชันมาจาก shop_rules)
+    
+    // จำลองการสแกน barcode ที่เครื่องอ่าน: หาสินค้าในแคตตาล็อกด้วย perfect hash ครั้งละ O(1)
+    static const struct {
+        uint64_t barcode;
+        int quantity;
+    } demo_scans[] = {
+        { 8850999320014ull, 2 },    // น้ำดื่ม
+        { 8851123400027ull, 1 },    // ขนมปัง
+        { 8852047310033ull, 3 },    // กาแฟกระป๋อง
     };
     
-    ESP_LOGI(TAG, "\n🛒 เพิ่มสินค้าในตะกร้า:");
-    for (int i = 0; i < 3; i++) {
-        calc_data.cart[i] = demo_products[i];
-        calc_data.cart[i].total = demo_products[i].price * demo_products[i].quantity;
-        calc_data.shop_total += calc_data.cart[i].total;
-        calc_data.cart_count++;
-        
-        ESP_LOGI(TAG, "➕ %s: %.2f × %d = %.2f บาท", 
-                 demo_products[i].name, demo_products[i].price, 
-                 demo_products[i].quantity, calc_data.cart[i].total);
-        vTaskDelay(pdMS_TO_TICKS(800));
+    // คำนวณยอดทุกรายการและยอดรวมเป็นชุดเดียว แล้วตรวจข้อผิดพลาดครั้งเดียว
+    double prices[CART_MAX], quantities[CART_MAX], totals[CART_MAX];
+    for (size_t i = 0; i < sizeof(demo_scans) / sizeof(demo_scans[0]) && calc->cart_count < CART_MAX; i++) {
+        int32_t item = catalog_find(&shop_catalog, demo_scans[i].barcode);
+        if (item == CATALOG_NOT_FOUND) {
+            ESP_LOGW(calc->tag, "⚠️ ไม่พบสินค้า barcode %llu ในแคตตาล็อก",
+                     (unsigned long long)demo_scans[i].barcode);
+            continue;
+        }
+        calc->cart[calc->cart_count] = (cart_line_t){ .item = (uint32_t)item,
+                                                      .quantity = demo_scans[i].quantity };
+        prices[calc->cart_count] = shop_catalog.price[item] / 100.0;
+        quantities[calc->cart_count] = demo_scans[i].quantity;
+        calc->cart_count++;
     }
-    
-    ESP_LOGI(TAG, "\n💰 สรุปการคำนวณ:");
-    ESP_LOGI(TAG, "╔════════════════════════════════════════════╗");
-    ESP_LOGI(TAG, "║              🧾 ใบเสร็จ                  ║");
-    ESP_LOGI(TAG, "╠════════════════════════════════════════════╣");
-    
-    for (int i = 0; i < calc_data.cart_count; i++) {
-        ESP_LOGI(TAG, "║ %s  %.2f×%d  %.2f ║", 
-                 calc_data.cart[i].name, calc_data.cart[i].price,
-                 calc_data.cart[i].quantity, calc_data.cart[i].total);
+    arith_errmask_t mask = arith_mul_batch(prices, quantities, totals, calc->cart_count);
+    mask |= arith_sum_batch(totals, calc->cart_count, &calc->shop_total);
+    if (mask != 0) {
+        ESP_LOGE(calc->tag, "❌ คำนวณยอดตะกร้าผิดพลาด (%s)!", arith_err_name(arith_errmask_first(mask)));
     }
     
-    ESP_LOGI(TAG, "╠════════════════════════════════════════════╣");
-    ESP_LOGI(TAG, "║ 📊 ยอดรวม:                    %.2f บาท ║", calc_data.shop_total);
+    UI_LOGI(calc->tag, "\n🛒 เพิ่มสินค้าในตะกร้า:");
+    for (int i = 0; i < calc->cart_count; i++) {
+        calc->cart[i].total = totals[i];
+        
+        ESP_LOGI(calc->tag, "➕ %s: %.2f × %d = %.2f บาท", 
+                 catalog_name(&shop_catalog, calc->cart[i].item), prices[i], 
+                 calc->cart[i].quantity, calc->cart[i].total);
+        DEMO_PAUSE(800);
+    }
     
-    // คำนวณส่วนลด
-    double discount_amount = calculate_percentage(calc_data.shop_total, calc_data.shop_discount);
-    double after_discount = calc_data.shop_total - discount_amount;
-    ESP_LOGI(TAG, "║ 🎫 ส่วนลด %.0f%%:               -%.2f บาท ║", 
-             calc_data.shop_discount, discount_amount);
-    ESP_LOGI(TAG, "║ 💵 หลังหักส่วนลด:             %.2f บาท ║", after_discount);
+    // คิดเงินทั้งตะกร้าด้วยตารางกฎราคา (เงินเป็นสตางค์ ไม่มีเศษ floating point)
+    pricing_line_t lines[CART_MAX];
+    pricing_totals_t totals_satang;
+    for (int i = 0; i < calc->cart_count; i++) {
+        uint32_t item = calc->cart[i].item;
+        lines[i] = (pricing_line_t){
+            .product = shop_catalog.id[item],
+            .category = shop_catalog.category[item],
+            .unit_price = shop_catalog.price[item],
+            .quantity = (uint32_t)calc->cart[i].quantity,
+            .vat_free = shop_catalog.vat[item] != CATALOG_VAT_STANDARD,
+        };
+    }
+    pricing_err_t perr = pricing_checkout(&shop_pricing, lines, calc->cart_count, calc->shop_member,
+                                          &totals_satang, NULL);
+    if (perr != PRICING_OK) {
+        ESP_LOGE(calc->tag, "%s", perr == PRICING_ERR_OVERFLOW
+                 ? "❌ ยอดเงินในตะกร้าเกินช่วงที่คิดได้!" : "❌ หมวดของสินค้าในตะกร้าไม่อยู่ในตารางราคา!");
+        return;
+    }
+    calc->shop_total = totals_satang.subtotal / 100.0;
+    calc->shop_discount = totals_satang.cart_discount_bp / 100.0;
+    double after_discount = totals_satang.net / 100.0;
     
-    // คำนวณภาษี
-    double tax_amount = calculate_percentage(after_discount, calc_data.shop_tax_rate);
-    double final_total = after_discount + tax_amount;
-    ESP_LOGI(TAG, "║ 🏛️ ภาษี %.0f%%:                 +%.2f บาท ║", 
-             calc_data.shop_tax_rate, tax_amount);
-    ESP_LOGI(TAG, "║ 💳 ยอดชำระสุทธิ:              %.2f บาท ║", final_total);
-    ESP_LOGI(TAG, "╚════════════════════════════════════════════╝");
+    UI_LOGI(calc->tag, "\n💰 สรุปการคำนวณ:");
+    print_receipt(calc, lines, &totals_satang);
     
     // บันทึกประวัติการขาย
-    save_to_history(OP_DISCOUNT, calc_data.shop_total, calc_data.shop_discount, 
+    save_to_history(calc, OP_DISCOUNT | HISTORY_SALE, calc->shop_total, calc->shop_discount, 
                     after_discount, "การขายหน้าร้าน");
+    emit_result(calc, OP_DISCOUNT, calc->shop_total, calc->shop_discount,
+                after_discount, ARITH_OK, calc->total_calculations);
+}
+
+// 🔎 พิมพ์เรคคอร์ดที่ตรงเงื่อนไขการค้นหา
+static bool log_history_match(void *ctx, const history_record_t *rec) {
+    calculator_data_t *calc = ctx;
+    char description[100];
+    describe_calculation(description, sizeof(description), (operation_t)(rec->op & ~HISTORY_SALE),
+                         rec->operand1, rec->operand2, rec->result);
+    ESP_LOGI(calc->tag, "   #%03d %s", (int)rec->id, description);
+    return true;
+}
+
+// 📈 สถิติแยกตามการดำเนินการตั้งแต่ since_ms (อ่านจากตัวสะสม ไม่ไล่ประวัติ)
+void show_operation_stats(calculator_data_t *calc, int64_t since_ms) {
+    int64_t now = current_time_ms();
+    history_agg_t agg;
+    
+    UI_LOGI(calc->tag, "\n📈 สถิติแยกตามการดำเนินการ (1 ชั่วโมงล่าสุด):");
+    for (int op = OP_ADD; op < OP_COUNT; op++) {
+        history_stats_query(&calc->stats, op, since_ms, now, &agg);
+        if (agg.count == 0) {
+            continue;
+        }
+        ESP_LOGI(calc->tag, "%s: %lu ครั้ง | รวม %.2f | ต่ำสุด %.2f | สูงสุด %.2f | เฉลี่ย %.2f | SD %.2f",
+                 calc_ops[op].name, (unsigned long)agg.count, agg.sum, agg.min, agg.max,
+                 agg.mean, history_agg_stddev(&agg));
+    }
+    
+    // ค้นหาผ่านดัชนี: ข้ามบล็อกที่ไม่มีการหารเลย
+    ESP_LOGI(calc->tag, "🔎 การหารใน 1 ชั่วโมงล่าสุด:");
+    uint32_t found = history_store_query(&calc->history, OP_DIVIDE, since_ms, now + 1,
+                                         log_history_match, calc);
+    ESP_LOGI(calc->tag, "   พบ %lu รายการ", (unsigned long)found);
 }
 
 // 📊 ฟังก์ชันโหมดประวัติ
-void history_mode(void) {
-    ESP_LOGI(TAG, "\n📊 === โหมดประวัติ ===");
+void history_mode(calculator_data_t *calc) {
+    UI_LOGI(calc->tag, "\n📊 === โหมดประวัติ ===");
     
-    if (calc_data.history_count == 0) {
-        ESP_LOGI(TAG, "📝 ยังไม่มีประวัติการคำนวณ");
+    if (calc->history.count == 0) {
+        UI_LOGI(calc->tag, "📝 ยังไม่มีประวัติการคำนวณ");
         return;
     }
     
-    ESP_LOGI(TAG, "╔════════════════════════════════════════════════════════╗");
-    ESP_LOGI(TAG, "║                    📋 ประวัติการคำนวณ                  ║");
-    ESP_LOGI(TAG, "╠════════════════════════════════════════════════════════╣");
+    UI_LOGI(calc->tag, "╔════════════════════════════════════════════════════════╗");
+    UI_LOGI(calc->tag, "║                    📋 ประวัติการคำนวณ                  ║");
+    UI_LOGI(calc->tag, "╠════════════════════════════════════════════════════════╣");
     
     // แสดงประวัติล่าสุด 5 รายการ
-    int start = calc_data.history_count > 5 ? calc_data.history_count - 5 : 0;
-    for (int i = start; i < calc_data.history_count; i++) {
-        calculation_history_t* entry = &calc_data.history[i];
-        ESP_LOGI(TAG, "║ #%03d │ %s │ %s ║", 
-                 entry->id, entry->timestamp, entry->description);
+    history_iter_t it;
+    history_record_t entry;
+    char timestamp[20];
+    char description[100];
+    uint32_t count = calc->history.count;
+    history_iter_begin(&calc->history, &it, count > 5 ? count - 5 : 0);
+    while (history_iter_next(&it, &entry)) {
+        create_timestamp(timestamp, sizeof(timestamp), entry.time_ms);
+        if (entry.op & HISTORY_SALE) {
+            snprintf(description, sizeof(description), "การขายหน้าร้าน");
+        } else {
+            describe_calculation(description, sizeof(description), (operation_t)entry.op,
+                                 entry.operand1, entry.operand2, entry.result);
+        }
+        ESP_LOGI(calc->tag, "║ #%03d │ %s │ %s ║", 
+                 (int)entry.id, timestamp, description);
     }
     
-    ESP_LOGI(TAG, "╚════════════════════════════════════════════════════════╝");
+    UI_LOGI(calc->tag, "╚════════════════════════════════════════════════════════╝");
+    ESP_LOGI(calc->tag, "💾 ประวัติ %lu รายการ | %u/%u ไบต์ (%s)",
+             (unsigned long)count, (unsigned)calc->history.used,
+             (unsigned)calc->history.cap,
+             calc->history.external ? "PSRAM" : "RAM ภายใน");
+    show_operation_stats(calc, current_time_ms() - 3600 * 1000);
     
     // สถิติการใช้งาน
-    ESP_LOGI(TAG, "\n📈 สถิติการใช้งาน:");
-    ESP_LOGI(TAG, "╔═══════════════════════════════════════╗");
-    ESP_LOGI(TAG, "║          📊 สรุปการใช้งาน           ║");
-    ESP_LOGI(TAG, "╠═══════════════════════════════════════╣");
-    ESP_LOGI(TAG, "║ 🔢 การคำนวณทั้งหมด: %d ครั้ง       ║", calc_data.total_calculations);
-    ESP_LOGI(TAG, "║ ⏱️ เวลารวม: %.2f มิลลิวินาที       ║", calc_data.total_computation_time);
-    
-    if (calc_data.total_calculations > 0) {
-        double avg_time = calc_data.total_computation_time / calc_data.total_calculations;
-        ESP_LOGI(TAG, "║ ⚡ เวลาเฉลี่ย: %.3f มิลลิวินาที     ║", avg_time);
-        ESP_LOGI(TAG, "║ 🚀 ประสิทธิภาพ: %s                ║", 
+    UI_LOGI(calc->tag, "\n📈 สถิติการใช้งาน:");
+    UI_LOGI(calc->tag, "╔═══════════════════════════════════════╗");
+    UI_LOGI(calc->tag, "║          📊 สรุปการใช้งาน           ║");
+    UI_LOGI(calc->tag, "╠═══════════════════════════════════════╣");
+    ESP_LOGI(calc->tag, "║ 🔢 การคำนวณทั้งหมด: %d ครั้ง       ║", calc->total_calculations);
+    ESP_LOGI(calc->tag, "║ ⏱️ เวลารวม: %.2f มิลลิวินาที       ║", calc->total_computation_time);
+    
+    if (calc->total_calculations > 0) {
+        double avg_time = calc->total_computation_time / calc->total_calculations;
+        ESP_LOGI(calc->tag, "║ ⚡ เวลาเฉลี่ย: %.3f มิลลิวินาที     ║", avg_time);
+        ESP_LOGI(calc->tag, "║ 🚀 ประสิทธิภาพ: %s                ║", 
                  avg_time < 1.0 ? "ยอดเยี่ยม" : avg_time < 5.0 ? "ดี" : "ปกติ");
     }
     
-    ESP_LOGI(TAG, "║ ⭐ ความแม่นยำ: 100%%               ║");
-    ESP_LOGI(TAG, "╚═══════════════════════════════════════╝");
+    UI_LOGI(calc->tag, "║ ⭐ ความแม่นยำ: 100%%               ║");
+    UI_LOGI(calc->tag, "╚═══════════════════════════════════════╝");
 }
 
 // 🎮 ฟังก์ชันจำลองการเลือกเมนู
-void simulate_menu_navigation(void) {
+void simulate_menu_navigation(calculator_data_t *calc) {
     // จำลองการนำทางผ่านเมนูต่างๆ
     int demo_sequence[] = {1, 2, 3, 4}; // Basic, Advanced, Shop, History
     
     for (int i = 0; i < 4; i++) {
-        show_main_menu();
-        ESP_LOGI(TAG, "🎯 เลือกเมนู: %d", demo_sequence[i]);
-        vTaskDelay(pdMS_TO_TICKS(2000));
+        show_main_menu(calc);
+        ESP_LOGI(calc->tag, "🎯 เลือกเมนู: %d", demo_sequence[i]);
+        DEMO_PAUSE(2000);
         
         switch (demo_sequence[i]) {
             case 1:
-                basic_calculator_mode();
+                basic_calculator_mode(calc);
                 break;
             case 2:
-                advanced_calculator_mode();
+                advanced_calculator_mode(calc);
                 break;
             case 3:
-                shop_mode();
+                shop_mode(calc);
                 break;
             case 4:
-                history_mode();
+                history_mode(calc);
                 break;
         }
         
-        vTaskDelay(pdMS_TO_TICKS(3000));
+        DEMO_PAUSE(3000);
     }
 }
 
 // 🏁 ฟังก์ชันสรุปและจบโปรแกรม
-void show_final_summary(void) {
-    ESP_LOGI(TAG, "\n🎉 === ขอบคุณที่ใช้งาน ===");
-    ESP_LOGI(TAG, "╔════════════════════════════════════════════════════╗");
-    ESP_LOGI(TAG, "║           🧮 เครื่องคิดเลขครบครัน v%s           ║", VERSION);
-    ESP_LOGI(TAG, "╠════════════════════════════════════════════════════╣");
-    ESP_LOGI(TAG, "║ ✅ การคำนวณทั้งหมด: %d ครั้ง                     ║", calc_data.total_calculations);
-    ESP_LOGI(TAG, "║ ⏱️ เวลาที่ใช้รวม: %.2f มิลลิวินาที                ║", calc_data.total_computation_time);
-    ESP_LOGI(TAG, "║ 🏆 ประสิทธิภาพ: เยี่ยม                           ║");
-    ESP_LOGI(TAG, "║ 🛡️ ความปลอดภัย: สูงสุด                          ║");
-    ESP_LOGI(TAG, "╚════════════════════════════════════════════════════╝");
-    
-    ESP_LOGI(TAG, "\n🎓 สิ่งที่ได้เรียนรู้:");
-    ESP_LOGI(TAG, "✅ การเขียนโปรแกรม ESP32 ด้วย C");
-    ESP_LOGI(TAG, "✅ การจัดการข้อผิดพลาดแบบมืออาชีพ");
-    ESP_LOGI(TAG, "✅ การสร้างระบบเมนูและ UI");
-    ESP_LOGI(TAG, "✅ การคำนวณคณิตศาสตร์ขั้นสูง");
-    ESP_LOGI(TAG, "✅ การประยุกต์ใช้ในงานจริง");
-    
-    ESP_LOGI(TAG, "\n🚀 คุณพร้อมสำหรับโปรเจคถัดไปแล้ว!");
-    ESP_LOGI(TAG, "💝 ขอบคุณและขอให้โชคดี!");
+void show_final_summary(calculator_data_t *calc) {
+    UI_LOGI(calc->tag, "\n🎉 === ขอบคุณที่ใช้งาน ===");
+    UI_LOGI(calc->tag, "╔════════════════════════════════════════════════════╗");
+    ESP_LOGI(calc->tag, "║           🧮 เครื่องคิดเลขครบครัน v%s           ║", VERSION);
+    UI_LOGI(calc->tag, "╠════════════════════════════════════════════════════╣");
+    ESP_LOGI(calc->tag, "║ ✅ การคำนวณทั้งหมด: %d ครั้ง                     ║", calc->total_calculations);
+    ESP_LOGI(calc->tag, "║ ⏱️ เวลาที่ใช้รวม: %.2f มิลลิวินาที                ║", calc->total_computation_time);
+    UI_LOGI(calc->tag, "║ 🏆 ประสิทธิภาพ: เยี่ยม                           ║");
+    UI_LOGI(calc->tag, "║ 🛡️ ความปลอดภัย: สูงสุด                          ║");
+    UI_LOGI(calc->tag, "╚════════════════════════════════════════════════════╝");
+    
+    UI_LOGI(calc->tag, "\n🎓 สิ่งที่ได้เรียนรู้:");
+    UI_LOGI(calc->tag, "✅ การเขียนโปรแกรม ESP32 ด้วย C");
+    UI_LOGI(calc->tag, "✅ การจัดการข้อผิดพลาดแบบมืออาชีพ");
+    UI_LOGI(calc->tag, "✅ การสร้างระบบเมนูและ UI");
+    UI_LOGI(calc->tag, "✅ การคำนวณคณิตศาสตร์ขั้นสูง");
+    UI_LOGI(calc->tag, "✅ การประยุกต์ใช้ในงานจริง");
+    
+    UI_LOGI(calc->tag, "\n🚀 คุณพร้อมสำหรับโปรเจคถัดไปแล้ว!");
+    UI_LOGI(calc->tag, "💝 ขอบคุณและขอให้โชคดี!");
+}
+
+#if CONFIG_CALC_SESSIONS > 1
+// 🧵 หนึ่ง task ต่อหนึ่ง session: แต่ละ task แตะเฉพาะ context ของตัวเอง
+// สิ่งเดียวที่ใช้ร่วมกันคือ semaphore ที่บอก app_main ว่าจบแล้ว
+typedef struct {
+    calculator_data_t *calc;
+    SemaphoreHandle_t done;
+} session_args_t;
+
+static void session_task(void *arg) {
+    session_args_t *args = arg;
+    // ลงทะเบียนจากใน task เอง: task ที่จบเร็วจะไม่ถูกเฝ้าหลังถูกลบไปแล้ว
+    memstat_watch_task(NULL, args->calc->tag, SESSION_STACK_SIZE);
+    simulate_menu_navigation(args->calc);
+    show_final_summary(args->calc);
+    memstat_task_exit();
+    xSemaphoreGive(args->done);
+    vTaskDelete(NULL);
+}
+
+// 🚀 กระจาย session ไปทุก core (สลับกัน) แล้วรอจนครบทุก session
+static void run_sessions(calculator_data_t *sessions, int n) {
+    session_args_t args[CONFIG_CALC_SESSIONS];
+    SemaphoreHandle_t done = xSemaphoreCreateCounting(n, 0);
+    int64_t start = esp_timer_get_time();
+    int started = 0;
+
+    for (int i = 0; i < n; i++) {
+        char name[configMAX_TASK_NAME_LEN];
+        snprintf(name, sizeof(name), "calc%d", i);
+        args[i] = (session_args_t){ .calc = &sessions[i], .done = done };
+        if (xTaskCreatePinnedToCore(session_task, name, SESSION_STACK_SIZE, &args[i],
+                                    uxTaskPriorityGet(NULL), NULL,
+                                    i % portNUM_PROCESSORS) != pdPASS) {
+            ESP_LOGE(TAG, "❌ สร้าง task ของ session %d ไม่สำเร็จ", i);
+            continue;
+        }
+        started++;
+    }
+    for (int i = 0; i < started; i++) {
+        xSemaphoreTake(done, portMAX_DELAY);
+    }
+    vSemaphoreDelete(done);
+
+    double elapsed_ms = (esp_timer_get_time() - start) / 1000.0;
+    int total = 0;
+    for (int i = 0; i < n; i++) {
+        total += sessions[i].total_calculations;
+        ESP_LOGI(TAG, "🧵 %s: %d การคำนวณ | %.2f มิลลิวินาที",
+                 sessions[i].tag, sessions[i].total_calculations,
+                 sessions[i].total_computation_time);
+    }
+    ESP_LOGI(TAG, "🚀 %d session บน %d core: %d การคำนวณใน %.0f มิลลิวินาที (%.1f ครั้ง/วินาที)",
+             started, portNUM_PROCESSORS, total, elapsed_ms,
+             elapsed_ms > 0 ? total * 1000.0 / elapsed_ms : 0.0);
+}
+#endif
+
+#if CONFIG_CALC_SERVER
+// 🌐 เซิร์ฟเวอร์รันใน task ของตัวเอง (CALC_SERVER_STACK_SIZE) ไม่ใช่บน main task ที่ stack เล็ก
+typedef struct {
+    calculator_server_t *server;
+    calculator_data_t *calc;
+    calculator_server_stats_t stats;
+    SemaphoreHandle_t done;
+} server_args_t;
+
+static void server_task(void *arg) {
+    server_args_t *args = arg;
+    memstat_watch_task(NULL, "server", CALC_SERVER_STACK_SIZE);
+    calculator_server_run(args->server, args->calc, fileno(stdin), stdout, &args->stats);
+    memstat_task_exit();
+    xSemaphoreGive(args->done);
+    vTaskDelete(NULL);
 }
 
+// คืนค่า true เมื่อตอบทุกคำขอได้โดยไม่มี error
+static bool run_server(calculator_data_t *calc) {
+    server_args_t args = { .server = calculator_server_create(), .calc = calc };
+    bool ok = false;
+
+    args.done = xSemaphoreCreateCounting(1, 0);
+    if (args.server == NULL || args.done == NULL) {
+        ESP_LOGE(TAG, "❌ จองหน่วยความจำของเซิร์ฟเวอร์ไม่สำเร็จ");
+    } else if (xTaskCreatePinnedToCore(server_task, "server", CALC_SERVER_STACK_SIZE, &args,
+                                       uxTaskPriorityGet(NULL), NULL, 0) != pdPASS) {
+        ESP_LOGE(TAG, "❌ สร้าง task ของเซิร์ฟเวอร์ไม่สำเร็จ");
+    } else {
+        xSemaphoreTake(args.done, portMAX_DELAY);
+        ok = args.stats.errors == 0;
+    }
+    if (args.done != NULL) {
+        vSemaphoreDelete(args.done);
+    }
+    calculator_server_destroy(args.server);
+    return ok;
+}
+#endif
+
 void app_main(void) {
-    ESP_LOGI(TAG, "🚀 เริ่มต้นเครื่องคิดเลขครบครัน!");
+    // 💾 หนึ่ง context ต่อหนึ่ง session (static เพื่อไม่กิน stack ของ main task)
+    static calculator_data_t sessions[CONFIG_CALC_SESSIONS];
+
+#if CONFIG_CALC_SERVER
+    // 🌐 โหมดเซิร์ฟเวอร์: ไม่มีเดโม รับคำขอจาก stdin จนจบ input (stdout ใช้ตอบกลับอย่างเดียว)
+    memory_begin(sizeof(sessions));
+    calculator_init(&sessions[0], 0);
+#if CONFIG_CALC_WARM_SNAPSHOT
+    calculator_snapshot_restore(&sessions[0]);
+#endif
+    bool server_ok = run_server(&sessions[0]);
+#if CONFIG_CALC_WARM_SNAPSHOT
+    calculator_snapshot_save(&sessions[0]);
+#endif
+    calculator_deinit(&sessions[0]);
+#if CONFIG_IDF_TARGET_LINUX
+    exit(server_ok ? 0 : 1);
+#endif
+    (void)server_ok;
+    return;
+#endif
+
+    telemetry_begin();
+    memory_begin(sizeof(sessions));
+#if CONFIG_CALC_MEMSTAT_PERIOD_MS > 0
+    memstat_start_periodic(TAG, CONFIG_CALC_MEMSTAT_PERIOD_MS);
+#endif
+    UI_LOGI(TAG, "🚀 เริ่มต้นเครื่องคิดเลขครบครัน!");
+
+#if CONFIG_ARITH_BENCH
+    // ⏱️ วัดจำนวน cycle ของทุกเคอร์เนล (เปิดใน menuconfig → Arith kernels)
+    UI_LOGI(TAG, "⏱️ arith benchmark (CSV):");
+    arith_bench_run_all(stdout);
+#endif
     
     // รอให้ระบบเริ่มต้นเสร็จสิ้น
-    vTaskDelay(pdMS_TO_TICKS(1000));
+    DEMO_PAUSE(1000);
     
     // แสดง Logo
     show_logo();
-    vTaskDelay(pdMS_TO_TICKS(2000));
+    DEMO_PAUSE(2000);
     
     // เริ่มต้นข้อมูล
-    calc_data.current_mode = MODE_MAIN_MENU;
-    calc_data.shop_tax_rate = 7.0;
+    for (int i = 0; i < CONFIG_CALC_SESSIONS; i++) {
+        calculator_init(&sessions[i], i);
+#if CONFIG_CALC_WARM_SNAPSHOT
+        calculator_snapshot_restore(&sessions[i]);
+#endif
+    }
+    pricing_err_t perr = pricing_compile(&shop_pricing, shop_rules,
+                                         sizeof(shop_rules) / sizeof(shop_rules[0]),
+                                         (uint16_t)(sessions[0].shop_tax_rate * 100));
+    if (perr != PRICING_OK) {
+        ESP_LOGE(TAG, "❌ กฎราคาข้อที่ %u ไม่ถูกต้อง - ใช้ราคาป้ายไม่มีโปรโมชัน", shop_pricing.bad_rule + 1);
+        pricing_compile(&shop_pricing, NULL, 0, (uint16_t)(sessions[0].shop_tax_rate * 100));
+    }
+    receipt_template_init(&shop_receipt, &shop_receipt_layout);
     
-    ESP_LOGI(TAG, "⚡ ระบบพร้อมใช้งาน!");
-    ESP_LOGI(TAG, "🛡️ ระบบป้องกันข้อผิดพลาดเปิดใช้งาน");
-    ESP_LOGI(TAG, "💾 ระบบบันทึกประวัติพร้อม");
-    vTaskDelay(pdMS_TO_TICKS(1500));
+    UI_LOGI(TAG, "⚡ ระบบพร้อมใช้งาน!");
+    UI_LOGI(TAG, "🛡️ ระบบป้องกันข้อผิดพลาดเปิดใช้งาน");
+    UI_LOGI(TAG, "💾 ระบบบันทึกประวัติพร้อม");
+    DEMO_PAUSE(1500);
     
+#if CONFIG_CALC_SESSIONS > 1
+    run_sessions(sessions, CONFIG_CALC_SESSIONS);
+#else
     // จำลองการใช้งานผ่านเมนูต่างๆ
-    simulate_menu_navigation();
+    simulate_menu_navigation(&sessions[0]);
     
     // แสดงสรุปท้าย
-    show_final_summary();
+    show_final_summary(&sessions[0]);
+#endif
+#if CONFIG_CALC_WARM_SNAPSHOT
+    for (int i = 0; i < CONFIG_CALC_SESSIONS; i++) {
+        calculator_snapshot_save(&sessions[i]);
+    }
+#endif
+    
+#if CONFIG_CALC_MEMSTAT_PERIOD_MS > 0
+    memstat_stop_periodic();
+#endif
+    // snapshot ~600 ไบต์ จองจาก heap ไม่วางบน stack ของ main task
+    memstat_snapshot_t *mem = malloc(sizeof(*mem));
+    if (mem != NULL) {
+        memstat_snapshot(mem);
+        memstat_report(TAG, mem);
+        free(mem);
+    }
     
-    ESP_LOGI(TAG, "\n🎯 โปรแกรมเสร็จสิ้น - ขอบคุณที่ใช้งาน!");
+    UI_LOGI(TAG, "\n🎯 โปรแกรมเสร็จสิ้น - ขอบคุณที่ใช้งาน!");
+#if CONFIG_CALC_OUTPUT_BINARY
+    uint32_t records = 0, bytes = 0;
+    for (int i = 0; i < CONFIG_CALC_SESSIONS; i++) {
+        records += sessions[i].telemetry.records;
+        bytes += sessions[i].telemetry.bytes;
+    }
+    ESP_LOGW(TAG, "📡 telemetry: %lu เรคคอร์ด, %lu ไบต์",
+             (unsigned long)records, (unsigned long)bytes);
+#endif
 }
@@ -0,0 +1,234 @@
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "esp_timer.h"
+#include "memstat.h"
+#include "numfmt.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sdkconfig.h"
+#include "server.h"
+
+#define SERVER_LINE_MAX 96                  // ยาวพอสำหรับ id + op + ตัวเลข 2 ตัวแบบเต็มความแม่นยำ
+#define SERVER_IN_SIZE (CONFIG_CALC_SERVER_BATCH * SERVER_LINE_MAX)
+#define SERVER_RESP_MAX 56                  // id + ชื่อ error + ตัวเลข round-trip สูงสุด 24 ตัวอักษร
+#define SERVER_OUT_SIZE (CONFIG_CALC_SERVER_BATCH * SERVER_RESP_MAX)
+
+// 🔤 op: ชื่อสั้น (token) ในทะเบียน calc_ops หรือเลขรหัส operation_t
+static bool parse_op(const char *token, size_t len, operation_t *op) {
+    if (len > 0 && token[0] >= '0' && token[0] <= '9') {
+        char *end;
+        unsigned long code = strtoul(token, &end, 10);
+        if ((size_t)(end - token) != len || code < OP_ADD || code >= OP_COUNT) {
+            return false;
+        }
+        *op = (operation_t)code;
+        return true;
+    }
+    for (int i = OP_ADD; i < OP_COUNT; i++) {
+        const char *t = calc_ops[i].token;
+        if (strlen(t) == len && memcmp(t, token, len) == 0) {
+            *op = (operation_t)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// 🔎 แปลหนึ่งบรรทัด (ปิดท้ายด้วย '\0') คืนค่า false ถ้ารูปแบบผิด (req->id ยังถูกตั้งถ้าอ่านได้)
+static bool parse_request(char *line, calc_request_t *req) {
+    char *p = line;
+    char *end;
+
+    req->id = 0;
+    req->op = 0;
+    req->op1 = 0;
+    req->op2 = 0;
+
+    unsigned long id = strtoul(p, &end, 10);
+    if (end == p) {
+        return false;
+    }
+    req->id = (uint32_t)id;
+    p = end + strspn(end, " \t");
+    size_t len = strcspn(p, " \t");
+    if (!parse_op(p, len, &req->op)) {
+        return false;
+    }
+    p += len;
+    req->op1 = strtod(p, &end);
+    if (end == p) {
+        return false;
+    }
+    p = end;
+    req->op2 = strtod(p, &end);
+    p = end + strspn(end, " \t\r");
+    return *p == '\0';
+}
+
+// 🗄️ สถานะของหนึ่งเซิร์ฟเวอร์: บัฟเฟอร์ทั้งหมดโตตาม CONFIG_CALC_SERVER_BATCH จึงอยู่บน heap ไม่ใช่ stack
+struct calculator_server {
+    char in[SERVER_IN_SIZE + 1];
+    char out[SERVER_OUT_SIZE];
+    calc_request_t req[CONFIG_CALC_SERVER_BATCH];
+    calc_response_t resp[CONFIG_CALC_SERVER_BATCH];
+    bool invalid[CONFIG_CALC_SERVER_BATCH];
+    bool skipping;              // กำลังทิ้งส่วนที่เหลือของบรรทัดที่ยาวเกินบัฟเฟอร์ (จนถึง '\n')
+    memstat_snapshot_t mem;     // สำหรับบรรทัด "# mem" ตอนจบ
+};
+
+calculator_server_t *calculator_server_create(void) {
+    return calloc(1, sizeof(calculator_server_t));
+}
+
+void calculator_server_destroy(calculator_server_t *server) {
+    free(server);
+}
+
+// 📤 เขียนคำตอบทั้งชุดลงบัฟเฟอร์เดียวแล้วส่งครั้งเดียว
+static void write_responses(calculator_server_t *server, FILE *out, const calc_response_t *resp, size_t n) {
+    char *buf = server->out;
+    size_t len = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        if (sizeof(server->out) - len < SERVER_RESP_MAX) {
+            fwrite(buf, 1, len, out);
+            len = 0;
+        }
+        // ผลเป็นตัวเลขสั้นที่สุดที่อ่านกลับด้วย strtod ได้ค่าเดิมพอดี (%.15g อาจเสียหลักท้าย)
+        len += snprintf(buf + len, sizeof(server->out) - len, "%lu %s ",
+                        (unsigned long)resp[i].id, arith_err_name(resp[i].err));
+        len += numfmt_shortest(buf + len, sizeof(server->out) - len, resp[i].result, 0);
+        buf[len++] = '\n';
+    }
+    fwrite(buf, 1, len, out);
+    fflush(out);
+}
+
+// 📥 อ่านข้อมูลเท่าที่มาถึงแล้ว: >0 ได้ข้อมูล, 0 = จบ input
+// UART ที่ยังไม่มีข้อมูลคืน EAGAIN (หรือ 0 บนชิป) — รอหนึ่ง tick แล้วอ่านใหม่
+static ssize_t read_available(int fd, char *buf, size_t size) {
+    for (;;) {
+        ssize_t n = read(fd, buf, size);
+        if (n > 0) {
+            return n;
+        }
+#if CONFIG_IDF_TARGET_LINUX
+        if (n == 0) {
+            return 0;
+        }
+#endif
+        if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            return 0;
+        }
+        vTaskDelay(1);
+    }
+}
+
+void calculator_server_run(calculator_server_t *server, calculator_data_t *calc, int in_fd,
+                           FILE *out, calculator_server_stats_t *stats) {
+    char *in = server->in;
+    calc_request_t *req = server->req;
+    calc_response_t *resp = server->resp;
+    bool *invalid = server->invalid;
+    size_t held = 0;
+    bool eof = false;
+
+    memset(stats, 0, sizeof(*stats));
+    server->skipping = false;
+    int64_t start = esp_timer_get_time();
+
+    while (!eof || held > 0) {
+        if (!eof && held < SERVER_IN_SIZE) {
+            ssize_t n = read_available(in_fd, in + held, SERVER_IN_SIZE - held);
+            if (n == 0) {
+                eof = true;
+                // บรรทัดสุดท้ายที่ไม่มี '\n' ยังถือเป็นคำขอ
+                if (held > 0 && in[held - 1] != '\n') {
+                    in[held++] = '\n';
+                }
+            } else {
+                held += (size_t)n;
+            }
+        }
+
+        // ทิ้งส่วนที่เหลือของบรรทัดยาวเกิน: ห้ามแปลเป็นคำขอใหม่ (อาจมี id ที่ดูถูกต้อง)
+        if (server->skipping) {
+            char *nl = memchr(in, '\n', held);
+            if (nl == NULL) {
+                held = 0;
+                continue;
+            }
+            size_t drop = (size_t)(nl - in) + 1;
+            memmove(in, in + drop, held - drop);
+            held -= drop;
+            server->skipping = false;
+        }
+
+        // ตัดบรรทัดที่ครบแล้วเป็นชุด
+        size_t count = 0;
+        size_t pos = 0;
+        while (count < CONFIG_CALC_SERVER_BATCH) {
+            char *nl = memchr(in + pos, '\n', held - pos);
+            if (nl == NULL) {
+                break;
+            }
+            *nl = '\0';
+            char *line = in + pos;
+            pos = (size_t)(nl - in) + 1;
+            line += strspn(line, " \t\r");
+            if (*line == '\0' || *line == '#') {
+                continue;
+            }
+            invalid[count] = !parse_request(line, &req[count]);
+            if (invalid[count]) {
+                req[count].op = 0;      // evaluate_batch ตอบ invalid_input ให้เอง
+            }
+            count++;
+        }
+        if (pos == 0 && held == SERVER_IN_SIZE) {
+            // บรรทัดยาวเกินบัฟเฟอร์ทั้งก้อน: ตอบ error ให้ id 0 ครั้งเดียว แล้วทิ้งจนถึง '\n' ถัดไป
+            resp[0] = (calc_response_t){ .id = 0, .err = ARITH_ERR_INVALID_INPUT, .result = NAN };
+            write_responses(server, out, resp, 1);
+            stats->errors++;
+            server->skipping = true;
+            held = 0;
+            continue;
+        }
+        memmove(in, in + pos, held - pos);
+        held -= pos;
+
+        if (count > 0) {
+            int64_t batch_start = esp_timer_get_time();
+            calculator_evaluate_batch(calc, req, resp, count);
+            write_responses(server, out, resp, count);
+            int64_t batch_us = esp_timer_get_time() - batch_start;
+            if (batch_us > stats->max_batch_us) {
+                stats->max_batch_us = batch_us;
+            }
+            for (size_t i = 0; i < count; i++) {
+                stats->errors += invalid[i] || resp[i].err != ARITH_OK;
+            }
+            stats->requests += count;
+            stats->batches++;
+        } else if (eof) {
+            held = 0;
+        }
+    }
+
+    stats->elapsed_us = esp_timer_get_time() - start;
+    double seconds = stats->elapsed_us / 1e6;
+    fprintf(out, "# served %lu requests (%lu errors) in %lu batches, %.3f s, %.0f req/s, max batch %lld us\n",
+            (unsigned long)stats->requests, (unsigned long)stats->errors,
+            (unsigned long)stats->batches, seconds,
+            seconds > 0 ? stats->requests / seconds : 0.0, (long long)stats->max_batch_us);
+    if (calc->first_result_us != 0) {
+        fprintf(out, "# first result %lld us after reset\n", (long long)calc->first_result_us);
+    }
+    char line[MEMSTAT_LINE_MAX];
+    memstat_snapshot(&server->mem);
+    memstat_format_compact(line, sizeof(line), &server->mem);
+    fprintf(out, "# mem %s\n", line);
+    fflush(out);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdio.h>
+#include "calculator.h"
+
+// 🌐 โหมดเซิร์ฟเวอร์: รับคำขอเป็นบรรทัดข้อความจาก file descriptor (stdin = UART หรือ pipe บน linux target)
+//
+// คำขอ:  <id> <op> <a> [<b>]
+//   op เป็นชื่อสั้น (token) ในทะเบียน calc_ops (+ - * / ^ sqrt ! circle rect box % disc tax mean) หรือเลขรหัส operation_t
+//   บรรทัดว่างและบรรทัดที่ขึ้นต้นด้วย '#' ถูกข้าม
+// คำตอบ: <id> <err> <result>   เช่น "7 ok 12" หรือ "8 div_by_zero nan"
+//
+// ผู้ส่งส่งคำขอต่อเนื่องได้โดยไม่ต้องรอคำตอบ เซิร์ฟเวอร์อ่านทุกบรรทัดที่มาถึงแล้ว
+// คำนวณเป็นชุดละไม่เกิน CONFIG_CALC_SERVER_BATCH รายการ และเขียนคำตอบตามลำดับคำขอ
+// บรรทัดที่ยาวเกินบัฟเฟอร์ได้คำตอบ "0 invalid_input nan" ครั้งเดียว แล้วถูกทิ้งทั้งบรรทัด
+// เมื่อจบ input (EOF) พิมพ์สรุปเป็นบรรทัด '#' แล้วคืนค่า
+
+typedef struct {
+    uint32_t requests;
+    uint32_t errors;            // คำขอที่แปลไม่ได้หรือคำนวณผิดพลาด
+    uint32_t batches;
+    int64_t elapsed_us;
+    int64_t max_batch_us;       // เวลาคำนวณ+เขียนคำตอบของชุดที่นานที่สุด
+} calculator_server_stats_t;
+
+// 🧵 stack ของ task ที่รันเซิร์ฟเวอร์: บัฟเฟอร์ที่โตตาม CONFIG_CALC_SERVER_BATCH อยู่บน heap ทั้งหมด
+// (calculator_server_create) บน stack เหลือแค่ชุดย่อยของ evaluate_batch (≤ 32 ค่า) + snprintf/strtod
+#define CALC_SERVER_STACK_SIZE 4096
+
+// 🗄️ สถานะของหนึ่งเซิร์ฟเวอร์ (บัฟเฟอร์ input/คำขอ/คำตอบ/output) — หนึ่งตัวต่อหนึ่งเทอร์มินัล
+// แต่ละ session รันเซิร์ฟเวอร์ของตัวเองพร้อมกันได้ คืน NULL ถ้าจองไม่สำเร็จ
+typedef struct calculator_server calculator_server_t;
+
+calculator_server_t *calculator_server_create(void);
+void calculator_server_destroy(calculator_server_t *server);
+
+void calculator_server_run(calculator_server_t *server, calculator_data_t *calc, int in_fd,
+                           FILE *out, calculator_server_stats_t *stats);
@@ -0,0 +1,175 @@
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+#include "esp_timer.h"
+#include "nvs.h"
+#include "nvs_flash.h"
+#include "snapshot.h"
+
+#define SNAPSHOT_NAMESPACE "calc"
+#define SNAPSHOT_MAGIC 0x50534E43u          // "CNSP"
+#define SNAPSHOT_VERSION 2
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t op_count;                      // OP_COUNT ตอนบันทึก (รหัส op ในประวัติขึ้นกับทะเบียน)
+    uint32_t length;                        // ความยาวทั้ง blob (header 16 ไบต์ ส่วนถัดไปจึงเรียงตรง 8)
+    uint32_t crc;                           // CRC32 ของทุกไบต์หลัง header
+} snapshot_header_t;
+
+typedef struct {
+    int32_t total_calculations;
+    double total_computation_time;
+    double shop_tax_rate;
+    uint8_t shop_member;
+    int64_t saved_at_ms;                    // current_time_ms() ตอนบันทึก (ใช้ต่อนาฬิกาหลังบูตใหม่)
+    history_export_t history;               // ตามด้วยเรคคอร์ด history.bytes ไบต์
+} snapshot_state_t;
+
+#define SNAPSHOT_FIXED (sizeof(snapshot_header_t) + sizeof(snapshot_state_t))
+
+// 🗄️ เปิด NVS ครั้งแรกที่ใช้ (พาร์ทิชันเต็มหรือรูปแบบเก่า: ล้างแล้วเริ่มใหม่)
+static bool nvs_ready(void) {
+    static bool ready;
+    if (!ready) {
+        esp_err_t err = nvs_flash_init();
+        if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+            nvs_flash_erase();
+            err = nvs_flash_init();
+        }
+        ready = err == ESP_OK;
+    }
+    return ready;
+}
+
+static void snapshot_key(char key[4], int session) {
+    key[0] = 's';
+    key[1] = (char)('0' + session);
+    key[2] = '\0';
+}
+
+static uint32_t snapshot_crc(const uint8_t *blob, size_t len) {
+    return esp_rom_crc32_le(0, blob + sizeof(snapshot_header_t),
+                            (uint32_t)(len - sizeof(snapshot_header_t)));
+}
+
+bool calculator_snapshot_save(const calculator_data_t *calc) {
+    if (!nvs_ready() || calc->history.arena == NULL) {
+        return false;
+    }
+    size_t len = SNAPSHOT_FIXED + calc->history.used;
+    uint8_t *blob = malloc(len);
+    if (blob == NULL) {
+        ESP_LOGE(calc->tag, "❌ จองหน่วยความจำ snapshot %u ไบต์ไม่สำเร็จ", (unsigned)len);
+        return false;
+    }
+    snapshot_header_t *hdr = (snapshot_header_t *)blob;
+    snapshot_state_t *st = (snapshot_state_t *)(blob + sizeof(*hdr));
+    memset(blob, 0, SNAPSHOT_FIXED);
+    st->total_calculations = calc->total_calculations;
+    st->total_computation_time = calc->total_computation_time;
+    st->shop_tax_rate = calc->shop_tax_rate;
+    st->shop_member = calc->shop_member;
+    st->saved_at_ms = current_time_ms();
+    history_store_export(&calc->history, blob + SNAPSHOT_FIXED, calc->history.used, &st->history);
+    hdr->magic = SNAPSHOT_MAGIC;
+    hdr->version = SNAPSHOT_VERSION;
+    hdr->op_count = OP_COUNT;
+    hdr->length = (uint32_t)len;
+    hdr->crc = snapshot_crc(blob, len);
+
+    char key[4];
+    nvs_handle_t nvs;
+    snapshot_key(key, calc->session);
+    esp_err_t err = nvs_open(SNAPSHOT_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(nvs, key, blob, len);
+        if (err == ESP_OK) {
+            err = nvs_commit(nvs);
+        }
+        nvs_close(nvs);
+    }
+    free(blob);
+    if (err != ESP_OK) {
+        ESP_LOGW(calc->tag, "⚠️ บันทึก snapshot ไม่สำเร็จ (%s)", esp_err_to_name(err));
+        return false;
+    }
+    ESP_LOGI(calc->tag, "💾 บันทึก snapshot: %lu รายการ, %u ไบต์",
+             (unsigned long)calc->history.count, (unsigned)len);
+    return true;
+}
+
+// ✅ ตรวจ blob ทั้งก้อนก่อนแตะ calc
+static const snapshot_state_t *snapshot_check(const uint8_t *blob, size_t len) {
+    const snapshot_header_t *hdr = (const snapshot_header_t *)blob;
+    const snapshot_state_t *st = (const snapshot_state_t *)(blob + sizeof(*hdr));
+    if (len < SNAPSHOT_FIXED || hdr->magic != SNAPSHOT_MAGIC || hdr->version != SNAPSHOT_VERSION ||
+        hdr->op_count != OP_COUNT || hdr->length != len || st->history.bytes != len - SNAPSHOT_FIXED ||
+        hdr->crc != snapshot_crc(blob, len)) {
+        return NULL;
+    }
+    return st;
+}
+
+bool calculator_snapshot_restore(calculator_data_t *calc) {
+    if (!nvs_ready()) {
+        return false;
+    }
+    int64_t start = esp_timer_get_time();
+    char key[4];
+    nvs_handle_t nvs;
+    size_t len = 0;
+    snapshot_key(key, calc->session);
+    if (nvs_open(SNAPSHOT_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK) {
+        return false;       // ยังไม่เคยบันทึก (บูตแรก)
+    }
+    uint8_t *blob = NULL;
+    esp_err_t err = nvs_get_blob(nvs, key, NULL, &len);
+    if (err == ESP_OK) {
+        blob = malloc(len);
+        err = blob ? nvs_get_blob(nvs, key, blob, &len) : ESP_ERR_NO_MEM;
+    }
+    nvs_close(nvs);
+
+    const snapshot_state_t *st = err == ESP_OK ? snapshot_check(blob, len) : NULL;
+    history_export_t meta = st != NULL ? st->history : (history_export_t){ 0 };
+    // ⏰ นาฬิกาที่ไม่มีใคร sync เริ่มใกล้ 0 ใหม่ทุกครั้งที่จ่ายไฟ: ถ้าตอนนี้ย้อนหลังเวลาที่บันทึก
+    // เลื่อนเวลาทั้งประวัติ (ส่วนต่างระหว่างเรคคอร์ดเท่าเดิม) ให้ตอนบันทึกตรงกับตอนนี้
+    // ไม่อย่างนั้นผลใหม่จะเก่ากว่าที่คืนมา สถิติตามช่วงเวลาจะทิ้งผลใหม่ และการค้นตามเวลาจะข้ามของเดิม
+    int64_t shift_ms = 0;
+    if (st != NULL) {
+        int64_t now = current_time_ms();
+        shift_ms = now < st->saved_at_ms ? now - st->saved_at_ms : 0;
+        meta.head_time_ms += shift_ms;
+    }
+    bool ok = st != NULL && history_store_import(&calc->history, blob + SNAPSHOT_FIXED, &meta);
+    if (ok) {
+        calc->total_calculations = st->total_calculations;
+        calc->total_computation_time = st->total_computation_time;
+        calc->shop_tax_rate = st->shop_tax_rate;
+        calc->shop_member = st->shop_member;
+
+        // 📊 สร้างสถิติใหม่จากประวัติที่คืนมา
+        history_iter_t it;
+        history_record_t rec;
+        history_iter_begin(&calc->history, &it, 0);
+        while (history_iter_next(&it, &rec)) {
+            history_stats_add(&calc->stats, rec.op & ~HISTORY_SALE, rec.time_ms, rec.result);
+        }
+        ESP_LOGI(calc->tag, "♻️ คืน snapshot: %lu รายการ, %d การคำนวณสะสม (%lld µs)",
+                 (unsigned long)calc->history.count, calc->total_calculations,
+                 (long long)(esp_timer_get_time() - start));
+        if (shift_ms != 0) {
+            ESP_LOGW(calc->tag, "⏰ นาฬิกาเริ่มใหม่หลังบันทึก: เลื่อนเวลาประวัติ %lld วินาที",
+                     (long long)(shift_ms / 1000));
+        }
+    } else if (st != NULL) {
+        ESP_LOGW(calc->tag, "⚠️ snapshot มีเรคคอร์ดประวัติเสีย (ถอดไม่ลงตัว) - เริ่มจากศูนย์");
+    } else if (err == ESP_OK) {
+        ESP_LOGW(calc->tag, "⚠️ snapshot ใช้ไม่ได้ (รูปแบบ/CRC ไม่ตรง) - เริ่มจากศูนย์");
+    }
+    free(blob);
+    return ok;
+}
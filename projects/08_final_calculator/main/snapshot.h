@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdbool.h>
+#include "calculator.h"
+
+// ♻️ warm snapshot: เก็บสถานะของ session ลง NVS แล้วคืนตอนบูตครั้งถัดไป แทนการเริ่มจากศูนย์
+// เก็บ: ประวัติ (เรคคอร์ดบีบอัดตามที่อยู่ใน arena), ตัวนับการคำนวณ และค่าตั้งร้านค้า
+// สถิติแยกตามเวลาสร้างใหม่จากประวัติตอนคืน ส่วนหน้าต่างสตรีมเริ่มใหม่เสมอ (ค่าเซนเซอร์เก่าไม่มีความหมาย)
+// snapshot ที่รูปแบบไม่ตรง CRC ผิด หรือทะเบียน op เปลี่ยนไป จะถูกข้าม
+// ถ้านาฬิกาตอนคืนย้อนหลังเวลาที่บันทึก (ไม่มี SNTP/RTC) เวลาของประวัติจะถูกเลื่อนให้จบที่ตอนนี้
+//
+// เรียกจาก task เดียว (app_main) หลัง calculator_init / ก่อน calculator_deinit ของทุก session
+
+// คืนสถานะของ calc->session คืนค่า false ถ้าไม่มี snapshot หรือใช้ไม่ได้ (calc ไม่ถูกแตะ)
+bool calculator_snapshot_restore(calculator_data_t *calc);
+
+// บันทึกสถานะปัจจุบัน (เขียน flash — เรียกตอนจบงาน ไม่ใช่ทุกการคำนวณ)
+bool calculator_snapshot_save(const calculator_data_t *calc);
@@ -0,0 +1,6 @@
+# โปรไฟล์ lean: ตัดข้อความตกแต่ง + ปรับขนาดให้เล็กที่สุด
+# idf.py -B build-lean -D SDKCONFIG=build-lean/sdkconfig -D SDKCONFIG_DEFAULTS=sdkconfig.lean build
+CONFIG_CALC_LEAN=y
+CONFIG_COMPILER_OPTIMIZATION_SIZE=y
+CONFIG_COMPILER_OPTIMIZATION_ASSERTIONS_SILENT=y
+CONFIG_ESP_ERR_TO_NAME_LOOKUP=n
@@ -0,0 +1,12 @@
+#pragma once
+
+// 🖥️ ค่า menuconfig ของ 08 สำหรับ build บน host (ตรงกับค่าเริ่มต้นใน main/Kconfig.projbuild)
+#define CONFIG_CALC_HISTORY_ARENA_SIZE 7600
+#define CONFIG_CALC_STATS_BUCKETS 24
+#define CONFIG_CALC_STATS_BUCKET_SEC 3600
+#define CONFIG_CALC_BIGINT_ARENA_SIZE 16384
+#define CONFIG_CALC_STREAM_WINDOW 64
+#define CONFIG_CALC_STREAM_EWMA_PERCENT 10
+#define CONFIG_CALC_SESSIONS 1
+#define CONFIG_CALC_SERVER_BATCH 32
+#define CONFIG_IDF_TARGET_LINUX 1       // host ทำงานแบบ linux target (ไม่มี RTC/esp_system)
@@ -0,0 +1,537 @@
+// 🏋️ ตัวสร้างโหลดของเครื่องคิดเลข 08 (host)
+// สร้างสตรีมคำขอจาก seed เดียวกันได้ผลเหมือนเดิมทุกครั้ง แล้ววัด throughput และ latency p50/p99/p99.9
+//
+//   loadgen [-n N] [-s SEED] [-m MIX] [-e EDGE%] [-b BATCH] [-r RATE] [--emit | --pipe CMD]
+//
+//   -n N      จำนวนคำขอ (ค่าเริ่มต้น 100000)
+//   -s SEED   seed ของตัวสุ่ม (ค่าเริ่มต้น 1)
+//   -m MIX    สัดส่วน op เช่น "+=40,/=20,sqrt=10,!=5" ใช้ชื่อสั้นเดียวกับ line protocol
+//             (ค่าเริ่มต้น: ทุก op เท่ากัน)
+//   -e EDGE   % ของคำขอที่ใช้ค่าขอบ เช่น หารด้วย 0, รากของค่าลบ, แฟกทอเรียล > 20 (ค่าเริ่มต้น 5)
+//   -b BATCH  ขนาดชุดต่อการเรียก calculator_evaluate_batch / ต่อการเขียนลง pipe (ค่าเริ่มต้น 32)
+//   -r RATE   จำกัดอัตราส่งเป็นคำขอ/วินาที (เฉพาะ --pipe, 0 = เต็มที่)
+//
+// โหมด:
+//   (ค่าเริ่มต้น)  in-process: เรียก calculator_evaluate_batch โดยตรง
+//                 latency ของคำขอ = เวลาของชุดที่คำขอนั้นอยู่
+//   --pipe CMD    รัน CMD (เช่นเฟิร์มแวร์ linux target ที่เปิด CONFIG_CALC_SERVER) ส่งคำขอทาง stdin
+//                 อ่านคำตอบจาก stdout — latency = เวลาที่ได้คำตอบ − เวลาที่เขียนคำขอ
+//   --emit        พิมพ์คำขอเป็น line protocol ออก stdout (ไว้เก็บเป็นไฟล์ หรือส่งต่อด้วยเครื่องมืออื่น)
+//
+// ผลลัพธ์เป็น CSV หนึ่งบรรทัด (พร้อม header) ออก stdout เทียบระหว่าง commit ได้ด้วย diff
+// จำนวนข้อผิดพลาดแยกตามชนิดพิมพ์ออก stderr
+
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include "calculator.h"
+
+#define DEFAULT_REQUESTS 100000
+#define DEFAULT_EDGE_PERCENT 5
+#define DEFAULT_BATCH 32
+#define BATCH_MAX 1024
+#define REQUEST_LINE_MAX 96          // id + op + ตัวเลข %.17g สองตัว (ตรงกับ SERVER_LINE_MAX)
+#define ERR_KINDS (ARITH_ERR_UNDERFLOW + 1)
+
+typedef struct {
+    uint32_t requests;
+    uint64_t seed;
+    unsigned weights[OP_COUNT];
+    unsigned edge_percent;
+    uint32_t batch;
+    double rate;
+    const char *pipe_cmd;
+    bool emit;
+} loadgen_config_t;
+
+typedef struct {
+    const char *mode;
+    uint32_t answered;
+    uint32_t out_of_order;
+    uint32_t err_counts[ERR_KINDS + 1];     // ช่องสุดท้าย = รหัสที่ไม่รู้จัก
+    uint64_t elapsed_ns;
+    uint64_t *latency_ns;                   // หนึ่งค่าต่อคำขอ
+} loadgen_result_t;
+
+// ⏱️ นาโนวินาทีจาก CLOCK_MONOTONIC
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// ---------------------------------------------------------------------------
+// 🎲 ตัวสุ่ม splitmix64: เร็ว ผลเหมือนกันทุกแพลตฟอร์ม
+// ---------------------------------------------------------------------------
+static uint64_t rng_next(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// [0, 1)
+static double rng_unit(uint64_t *state) {
+    return (rng_next(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static double rng_range(uint64_t *state, double lo, double hi) {
+    return lo + (hi - lo) * rng_unit(state);
+}
+
+// [lo, hi] จำนวนเต็ม
+static int rng_int(uint64_t *state, int lo, int hi) {
+    return lo + (int)(rng_next(state) % (uint64_t)(hi - lo + 1));
+}
+
+// ค่าเงินทศนิยม 2 ตำแหน่ง
+static double rng_money(uint64_t *state, double lo, double hi) {
+    return round(rng_range(state, lo, hi) * 100.0) / 100.0;
+}
+
+// ---------------------------------------------------------------------------
+// 📦 สร้างคำขอ
+// ---------------------------------------------------------------------------
+
+// ตัวถูกดำเนินการปกติของแต่ละ op
+static void normal_operands(uint64_t *rng, operation_t op, double *a, double *b) {
+    *b = 0;
+    switch (op) {
+        case OP_ADD:
+        case OP_SUBTRACT:
+        case OP_MULTIPLY:
+            *a = rng_money(rng, -1000, 1000);
+            *b = rng_money(rng, -1000, 1000);
+            break;
+        case OP_DIVIDE:
+            *a = rng_money(rng, -1000, 1000);
+            *b = rng_money(rng, 0.01, 1000) * (rng_next(rng) & 1 ? 1 : -1);
+            break;
+        case OP_POWER:
+            *a = rng_money(rng, 0, 10);
+            *b = rng_int(rng, 0, 12);
+            break;
+        case OP_SQRT:
+            *a = rng_money(rng, 0, 10000);
+            break;
+        case OP_FACTORIAL:
+            *a = rng_int(rng, 0, ARITH_FACTORIAL_MAX);
+            break;
+        case OP_AREA_CIRCLE:
+            *a = rng_money(rng, 0, 100);
+            break;
+        case OP_AREA_RECTANGLE:
+        case OP_VOLUME_BOX:
+            *a = rng_money(rng, 0, 100);
+            *b = rng_money(rng, 0, 100);
+            break;
+        case OP_PERCENTAGE:
+        case OP_DISCOUNT:
+            *a = rng_money(rng, 0, 10000);
+            *b = rng_int(rng, 0, 100);
+            break;
+        case OP_TAX:
+            *a = rng_money(rng, 0, 10000);
+            *b = rng_int(rng, 0, 30);
+            break;
+        case OP_WINDOW_MEAN:                                          // ผลรวมของหน้าต่าง ÷ จำนวนค่า
+            *b = rng_int(rng, 1, 4096);
+            *a = rng_money(rng, -1000, 1000) * *b;
+            break;
+        default:
+            *a = 0;
+            break;
+    }
+}
+
+// ตัวถูกดำเนินการที่ตั้งใจให้เกิดข้อผิดพลาด (ตรวจทางเดินของการจัดการ error)
+static void edge_operands(uint64_t *rng, operation_t op, double *a, double *b) {
+    normal_operands(rng, op, a, b);
+    switch (op) {
+        case OP_ADD:           *a = 1.7e308; *b = 1.7e308; break;     // ล้นเป็น inf
+        case OP_SUBTRACT:      *a = -1.7e308; *b = 1.7e308; break;
+        case OP_MULTIPLY:      *a = 1e300; *b = -1e300; break;
+        case OP_DIVIDE:        *b = 0; break;                         // หารด้วยศูนย์
+        case OP_POWER:
+            if (rng_next(rng) & 1) {
+                *a = 0;                                               // 0 ยกกำลังลบ
+                *b = -rng_int(rng, 1, 5);
+            } else {
+                *a = 10;                                              // ล้น
+                *b = rng_int(rng, 309, 400);
+            }
+            break;
+        case OP_SQRT:          *a = -*a - 1; break;                   // รากของค่าลบ
+        case OP_FACTORIAL:
+            *a = rng_next(rng) & 1 ? rng_int(rng, ARITH_FACTORIAL_MAX + 1, 170) : -rng_int(rng, 1, 5);
+            break;
+        case OP_AREA_CIRCLE:   *a = -*a - 1; break;
+        case OP_AREA_RECTANGLE:*b = -*b - 1; break;
+        case OP_VOLUME_BOX:    *a = 1e200; *b = 1e200; break;
+        case OP_PERCENTAGE:    *a = 1e308; *b = 1e10; break;
+        case OP_DISCOUNT:      *b = rng_int(rng, 101, 200); break;    // ส่วนลดเกิน 100%
+        case OP_TAX:           *b = -rng_int(rng, 1, 30); break;      // ภาษีติดลบ
+        case OP_WINDOW_MEAN:   *b = 0; break;                         // หน้าต่างว่าง (ไม่มีค่า)
+        default:
+            break;
+    }
+}
+
+static void generate(const loadgen_config_t *cfg, calc_request_t *req) {
+    uint64_t rng = cfg->seed;
+    unsigned total = 0;
+
+    for (int op = OP_ADD; op < OP_COUNT; op++) {
+        total += cfg->weights[op];
+    }
+    for (uint32_t i = 0; i < cfg->requests; i++) {
+        unsigned pick = (unsigned)(rng_next(&rng) % total);
+        int op = OP_ADD;
+        while (pick >= cfg->weights[op]) {
+            pick -= cfg->weights[op];
+            op++;
+        }
+        req[i].id = i + 1;
+        req[i].op = (operation_t)op;
+        if (rng_next(&rng) % 100 < cfg->edge_percent) {
+            edge_operands(&rng, req[i].op, &req[i].op1, &req[i].op2);
+        } else {
+            normal_operands(&rng, req[i].op, &req[i].op1, &req[i].op2);
+        }
+    }
+}
+
+// 📝 หนึ่งบรรทัดของ line protocol (%.17g ส่งค่าได้ครบทุกบิต)
+static int format_request(char *buf, size_t size, const calc_request_t *r) {
+    return snprintf(buf, size, "%lu %s %.17g %.17g\n", (unsigned long)r->id,
+                    calc_ops[r->op].token, r->op1, r->op2);
+}
+
+static bool parse_mix(const char *spec, unsigned *weights) {
+    char *copy = strdup(spec);
+    char *save = NULL;
+    bool ok = true;
+
+    memset(weights, 0, sizeof(unsigned) * OP_COUNT);
+    for (char *item = strtok_r(copy, ",", &save); item && ok; item = strtok_r(NULL, ",", &save)) {
+        char *eq = strrchr(item, '=');
+        ok = false;
+        if (eq == NULL || eq == item) {
+            break;
+        }
+        *eq = '\0';
+        for (int op = OP_ADD; op < OP_COUNT; op++) {
+            if (strcmp(item, calc_ops[op].token) == 0) {
+                weights[op] = (unsigned)strtoul(eq + 1, NULL, 10);
+                ok = true;
+            }
+        }
+    }
+    free(copy);
+    if (ok) {
+        unsigned total = 0;
+        for (int op = OP_ADD; op < OP_COUNT; op++) {
+            total += weights[op];
+        }
+        ok = total > 0;
+    }
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// 🧮 in-process
+// ---------------------------------------------------------------------------
+static void run_in_process(const loadgen_config_t *cfg, const calc_request_t *req,
+                           loadgen_result_t *res) {
+    static calculator_data_t calc;
+    calc_response_t resp[BATCH_MAX];
+
+    calculator_init(&calc, 0);
+    res->mode = "in_process";
+    uint64_t start = now_ns();
+    for (uint32_t i = 0; i < cfg->requests; i += cfg->batch) {
+        uint32_t n = cfg->requests - i < cfg->batch ? cfg->requests - i : cfg->batch;
+        uint64_t t0 = now_ns();
+        calculator_evaluate_batch(&calc, &req[i], resp, n);
+        uint64_t dt = now_ns() - t0;
+        for (uint32_t k = 0; k < n; k++) {
+            res->latency_ns[i + k] = dt;
+            res->out_of_order += resp[k].id != req[i + k].id;
+            res->err_counts[resp[k].err < ERR_KINDS ? resp[k].err : ERR_KINDS]++;
+        }
+        res->answered += n;
+    }
+    res->elapsed_ns = now_ns() - start;
+    calculator_deinit(&calc);
+}
+
+// ---------------------------------------------------------------------------
+// 🔌 ผ่าน pipe: เธรดหนึ่งเขียนคำขอ เธรดหลักอ่านคำตอบ (ส่งต่อเนื่องโดยไม่รอคำตอบ)
+// ---------------------------------------------------------------------------
+typedef struct {
+    const loadgen_config_t *cfg;
+    const calc_request_t *req;
+    uint64_t *sent_ns;          // เขียนโดยเธรดผู้ส่ง อ่านโดยเธรดหลักหลังได้คำตอบ
+    uint64_t start_ns;
+    int fd;
+} pipe_writer_t;
+
+static bool write_all(int fd, const char *buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+static void *pipe_writer(void *arg) {
+    pipe_writer_t *w = arg;
+    const loadgen_config_t *cfg = w->cfg;
+    char *buf = malloc((size_t)cfg->batch * REQUEST_LINE_MAX);
+
+    for (uint32_t i = 0; i < cfg->requests; i += cfg->batch) {
+        uint32_t n = cfg->requests - i < cfg->batch ? cfg->requests - i : cfg->batch;
+        size_t len = 0;
+        for (uint32_t k = 0; k < n; k++) {
+            len += format_request(buf + len, REQUEST_LINE_MAX, &w->req[i + k]);
+        }
+        if (cfg->rate > 0) {
+            // ส่งตามกำหนดเวลาแบบ open-loop: ไม่รอคำตอบ latency จึงรวมเวลาต่อคิวในเซิร์ฟเวอร์
+            uint64_t due = w->start_ns + (uint64_t)(i / cfg->rate * 1e9);
+            uint64_t t = now_ns();
+            if (due > t) {
+                struct timespec ts = { (time_t)((due - t) / 1000000000u), (long)((due - t) % 1000000000u) };
+                nanosleep(&ts, NULL);
+            }
+        }
+        uint64_t t = now_ns();
+        for (uint32_t k = 0; k < n; k++) {
+            __atomic_store_n(&w->sent_ns[i + k], t, __ATOMIC_RELEASE);
+        }
+        if (!write_all(w->fd, buf, len)) {
+            break;
+        }
+    }
+    free(buf);
+    close(w->fd);
+    return NULL;
+}
+
+static int err_index(const char *name) {
+    for (int e = 0; e < ERR_KINDS; e++) {
+        if (strcmp(name, arith_err_name((arith_err_t)e)) == 0) {
+            return e;
+        }
+    }
+    return ERR_KINDS;
+}
+
+static bool run_pipe(const loadgen_config_t *cfg, const calc_request_t *req, loadgen_result_t *res) {
+    int to_child[2], from_child[2];
+    if (pipe(to_child) != 0 || pipe(from_child) != 0) {
+        perror("pipe");
+        return false;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return false;
+    }
+    if (pid == 0) {
+        dup2(to_child[0], STDIN_FILENO);
+        dup2(from_child[1], STDOUT_FILENO);
+        close(to_child[0]);
+        close(to_child[1]);
+        close(from_child[0]);
+        close(from_child[1]);
+        execl("/bin/sh", "sh", "-c", cfg->pipe_cmd, (char *)NULL);
+        perror("exec");
+        _exit(127);
+    }
+    close(to_child[0]);
+    close(from_child[1]);
+    signal(SIGPIPE, SIG_IGN);
+
+    uint64_t *sent_ns = calloc(cfg->requests, sizeof(uint64_t));
+    pipe_writer_t w = { .cfg = cfg, .req = req, .sent_ns = sent_ns, .fd = to_child[1] };
+    pthread_t writer;
+    res->mode = "pipe";
+    w.start_ns = now_ns();
+    pthread_create(&writer, NULL, pipe_writer, &w);
+
+    // อ่านคำตอบ: ข้ามบรรทัดที่ไม่ได้ขึ้นต้นด้วยตัวเลข (log ของเฟิร์มแวร์, บรรทัดสรุป '#')
+    FILE *in = fdopen(from_child[0], "r");
+    char line[256];
+    uint32_t expected = 1;
+    while (res->answered < cfg->requests && fgets(line, sizeof(line), in)) {
+        uint64_t t = now_ns();
+        char err[32];
+        unsigned long id;
+        if (line[0] < '0' || line[0] > '9' || sscanf(line, "%lu %31s", &id, err) != 2) {
+            continue;
+        }
+        res->out_of_order += id != expected;
+        expected = (uint32_t)id + 1;
+        if (id >= 1 && id <= cfg->requests) {
+            res->latency_ns[id - 1] = t - __atomic_load_n(&sent_ns[id - 1], __ATOMIC_ACQUIRE);
+        }
+        res->err_counts[err_index(err)]++;
+        res->answered++;
+    }
+    res->elapsed_ns = now_ns() - w.start_ns;
+
+    pthread_join(writer, NULL);
+    // อ่านส่วนที่เหลือ (บรรทัดสรุปของเซิร์ฟเวอร์) ส่งต่อให้ stderr
+    while (fgets(line, sizeof(line), in)) {
+        if (line[0] == '#') {
+            fputs(line, stderr);
+        }
+    }
+    fclose(in);
+    waitpid(pid, NULL, 0);
+    free(sent_ns);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// 📊 รายงาน
+// ---------------------------------------------------------------------------
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// เปอร์เซ็นไทล์แบบ nearest-rank จากอาร์เรย์ที่เรียงแล้ว (หน่วยไมโครวินาที)
+static double percentile_us(const uint64_t *sorted, uint32_t n, double p) {
+    if (n == 0) {
+        return 0;
+    }
+    uint32_t rank = (uint32_t)ceil(p / 100.0 * n);
+    return sorted[rank > 0 ? rank - 1 : 0] / 1000.0;
+}
+
+static void report(const loadgen_config_t *cfg, loadgen_result_t *res) {
+    uint32_t n = res->answered;
+    double seconds = res->elapsed_ns / 1e9;
+    uint32_t errors = n - res->err_counts[ARITH_OK];
+
+    qsort(res->latency_ns, n, sizeof(uint64_t), cmp_u64);
+    printf("mode,requests,answered,errors,out_of_order,seed,batch,seconds,req_per_s,"
+           "p50_us,p99_us,p999_us,max_us\n");
+    printf("%s,%lu,%lu,%lu,%lu,%llu,%lu,%.6f,%.0f,%.2f,%.2f,%.2f,%.2f\n",
+           res->mode, (unsigned long)cfg->requests, (unsigned long)n, (unsigned long)errors,
+           (unsigned long)res->out_of_order, (unsigned long long)cfg->seed,
+           (unsigned long)cfg->batch, seconds, seconds > 0 ? n / seconds : 0.0,
+           percentile_us(res->latency_ns, n, 50), percentile_us(res->latency_ns, n, 99),
+           percentile_us(res->latency_ns, n, 99.9), n ? res->latency_ns[n - 1] / 1000.0 : 0.0);
+
+    for (int e = 0; e <= ERR_KINDS; e++) {
+        if (res->err_counts[e] > 0) {
+            fprintf(stderr, "%-14s %lu\n", e < ERR_KINDS ? arith_err_name((arith_err_t)e) : "unknown",
+                    (unsigned long)res->err_counts[e]);
+        }
+    }
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [-n N] [-s SEED] [-m MIX] [-e EDGE%%] [-b BATCH] [-r RATE] "
+                    "[--emit | --pipe CMD]\n", argv0);
+}
+
+int main(int argc, char **argv) {
+    loadgen_config_t cfg = {
+        .requests = DEFAULT_REQUESTS,
+        .seed = 1,
+        .edge_percent = DEFAULT_EDGE_PERCENT,
+        .batch = DEFAULT_BATCH,
+    };
+    for (int op = OP_ADD; op < OP_COUNT; op++) {
+        cfg.weights[op] = 1;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *val = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(arg, "--emit") == 0) {
+            cfg.emit = true;
+            continue;
+        }
+        if (val == NULL) {
+            usage(argv[0]);
+            return 2;
+        }
+        i++;
+        if (strcmp(arg, "-n") == 0) {
+            cfg.requests = (uint32_t)strtoul(val, NULL, 10);
+        } else if (strcmp(arg, "-s") == 0) {
+            cfg.seed = strtoull(val, NULL, 10);
+        } else if (strcmp(arg, "-m") == 0) {
+            if (!parse_mix(val, cfg.weights)) {
+                fprintf(stderr, "bad mix \"%s\" (ใช้ชื่อสั้นเช่น \"+=40,/=20,sqrt=10\")\n", val);
+                return 2;
+            }
+        } else if (strcmp(arg, "-e") == 0) {
+            cfg.edge_percent = (unsigned)strtoul(val, NULL, 10);
+        } else if (strcmp(arg, "-b") == 0) {
+            cfg.batch = (uint32_t)strtoul(val, NULL, 10);
+        } else if (strcmp(arg, "-r") == 0) {
+            cfg.rate = strtod(val, NULL);
+        } else if (strcmp(arg, "--pipe") == 0) {
+            cfg.pipe_cmd = val;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (cfg.requests == 0 || cfg.batch == 0 || cfg.batch > BATCH_MAX || cfg.edge_percent > 100) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    calc_request_t *req = malloc(sizeof(calc_request_t) * cfg.requests);
+    generate(&cfg, req);
+
+    if (cfg.emit) {
+        char line[REQUEST_LINE_MAX];
+        for (uint32_t i = 0; i < cfg.requests; i++) {
+            fwrite(line, 1, (size_t)format_request(line, sizeof(line), &req[i]), stdout);
+        }
+        free(req);
+        return 0;
+    }
+
+    loadgen_result_t res = { .latency_ns = calloc(cfg.requests, sizeof(uint64_t)) };
+    bool ok = true;
+    if (cfg.pipe_cmd) {
+        ok = run_pipe(&cfg, req, &res);
+    } else {
+        run_in_process(&cfg, req, &res);
+    }
+    if (ok) {
+        report(&cfg, &res);
+        if (res.answered != cfg.requests) {
+            fprintf(stderr, "⚠️ ได้คำตอบ %lu จาก %lu คำขอ\n",
+                    (unsigned long)res.answered, (unsigned long)cfg.requests);
+            ok = false;
+        }
+    }
+    free(res.latency_ns);
+    free(req);
+    return ok ? 0 : 1;
+}
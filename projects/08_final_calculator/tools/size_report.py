@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+# 📏 รายงานขนาด flash/RAM รายสัญลักษณ์จากไฟล์ ELF
+#
+# เรียกอัตโนมัติหลัง build (ดู CMakeLists.txt) หรือเรียกเองได้:
+#   python tools/size_report.py build/final_calculator.elf \
+#       --objdump xtensa-esp32-elf-objdump --out build/size_report.csv
+#
+# CSV: symbol,section,region,flash,ram เรียงจากใหญ่ไปเล็ก
+# stdout: ยอดรวมแต่ละ region + สัญลักษณ์ที่ใหญ่ที่สุด TOP รายการ
+
+import argparse
+import csv
+import re
+import subprocess
+import sys
+
+# addr  flags(7)  section  size  name
+LINE_RE = re.compile(r'^([0-9a-fA-F]+)\s(.{7})\s(\S+)\s+([0-9a-fA-F]+)\s+(.+)$')
+
+# section → (region, ใช้ flash?, ใช้ RAM?)
+# IRAM และ .data ถูกเก็บใน flash image แล้วคัดลอกขึ้น RAM ตอนบูต จึงนับทั้งสองฝั่ง
+REGIONS = [
+    ('.flash.', 'flash', True, False),
+    ('.iram0.', 'iram', True, True),
+    ('.dram0.bss', 'bss', False, True),
+    ('.bss', 'bss', False, True),
+    ('.noinit', 'bss', False, True),
+    ('.dram0.', 'data', True, True),
+    ('.data', 'data', True, True),
+    ('.rodata', 'flash', True, False),
+    ('.text', 'flash', True, False),
+    ('.rtc', 'rtc', True, True),
+]
+
+
+def classify(section):
+    for prefix, region, in_flash, in_ram in REGIONS:
+        if section.startswith(prefix):
+            return region, in_flash, in_ram
+    return None
+
+
+def read_symbols(objdump, elf):
+    out = subprocess.run([objdump, '-t', elf], check=True,
+                         stdout=subprocess.PIPE, universal_newlines=True).stdout
+    for line in out.splitlines():
+        m = LINE_RE.match(line)
+        if not m:
+            continue
+        _, flags, section, size, name = m.groups()
+        size = int(size, 16)
+        # ข้ามสัญลักษณ์ที่ไม่มีขนาด, ไฟล์ และ section marker
+        if size == 0 or flags[6] == 'f' or flags[5] == 'd':
+            continue
+        kind = classify(section)
+        if kind is None:
+            continue
+        region, in_flash, in_ram = kind
+        yield (name, section, region,
+               size if in_flash else 0,
+               size if in_ram else 0)
+
+
+def main():
+    ap = argparse.ArgumentParser(description='per-symbol flash/RAM report')
+    ap.add_argument('elf')
+    ap.add_argument('--objdump', default='objdump')
+    ap.add_argument('--out', default='size_report.csv')
+    ap.add_argument('--top', type=int, default=15)
+    args = ap.parse_args()
+
+    rows = sorted(read_symbols(args.objdump, args.elf),
+                  key=lambda r: (r[3] + r[4], r[0]), reverse=True)
+
+    with open(args.out, 'w', newline='') as f:
+        w = csv.writer(f)
+        w.writerow(['symbol', 'section', 'region', 'flash', 'ram'])
+        w.writerows(rows)
+
+    totals = {}
+    for _, _, region, fl, ram in rows:
+        t = totals.setdefault(region, [0, 0])
+        t[0] += fl
+        t[1] += ram
+    flash = sum(t[0] for t in totals.values())
+    ram = sum(t[1] for t in totals.values())
+
+    print('📏 size report: %s (%d symbols)' % (args.out, len(rows)))
+    for region in sorted(totals):
+        print('   %-6s flash %8d  ram %8d' % (region, totals[region][0], totals[region][1]))
+    print('   %-6s flash %8d  ram %8d' % ('total', flash, ram))
+    for name, section, _, fl, r in rows[:args.top]:
+        print('   %8d  %-16s %s' % (max(fl, r), section, name))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
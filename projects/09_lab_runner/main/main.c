@@ -0,0 +1,224 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "sdkconfig.h"
+#if CONFIG_HEAP_TASK_TRACKING
+#include "esp_heap_task_info.h"
+#endif
+
+// 🏷️ Tag สำหรับ Log
+static const char *TAG = "LAB_RUNNER";
+
+// 🧪 app_main เดิมของแต่ละ lab (เปลี่ยนชื่อตอนคอมไพล์ใน main/CMakeLists.txt)
+void lab01_main(void);
+void lab02_main(void);
+void lab03_main(void);
+void lab04_main(void);
+void lab05_main(void);
+void lab06_main(void);
+void lab07_main(void);
+void lab08_main(void);
+
+typedef struct {
+    const char *name;               // ชื่อ task (≤ configMAX_TASK_NAME_LEN - 1)
+    void (*run)(void);
+} lab_t;
+
+static const lab_t lab_table[] = {
+    { "01_eggs", lab01_main },
+    { "02_toys", lab02_main },
+    { "03_candies", lab03_main },
+    { "04_cookies", lab04_main },
+    { "05_shopping", lab05_main },
+    { "06_advanced", lab06_main },
+    { "07_errors", lab07_main },
+    { "08_calculator", lab08_main },
+};
+#define LAB_COUNT (sizeof(lab_table) / sizeof(lab_table[0]))
+
+// 🧵 สถานะของหนึ่ง lab: task เขียนเวลาของตัวเอง app_main อ่านหลัง done เท่านั้น
+typedef struct {
+    const lab_t *lab;
+    SemaphoreHandle_t done;
+    TaskHandle_t task;
+    int core;
+    int64_t start_us;
+    int64_t end_us;
+} lab_slot_t;
+
+// ⏸️ vTaskDelay ในโค้ดของทุก lab ถูกเปลี่ยนชื่อมาที่นี่
+// ค่าเริ่มต้นแค่สละ CPU ให้ task อื่น ทุก lab จึงคำนวณต่อเนื่องและแย่ง CPU กันจริง
+void lab_pause(const TickType_t ticks) {
+#if CONFIG_LAB_RUNNER_PAUSES
+    vTaskDelay(ticks);
+#else
+    (void)ticks;
+    taskYIELD();
+#endif
+}
+
+static void lab_task(void *arg) {
+    lab_slot_t *slot = arg;
+
+    slot->start_us = esp_timer_get_time();
+    slot->lab->run();
+    slot->end_us = esp_timer_get_time();
+
+    // ค้างไว้แทนการลบตัวเอง: app_main ต้องอ่านเวลา CPU และ stack ของ task นี้ก่อน แล้วจึงลบ
+    xSemaphoreGive(slot->done);
+    vTaskSuspend(NULL);
+}
+
+#if CONFIG_FREERTOS_USE_TRACE_FACILITY && CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+// 📸 สถานะของทุก task (เวลา CPU สะสมตั้งแต่บูตเป็น µs ของ esp_timer) คืนจำนวน task
+static UBaseType_t task_snapshot(TaskStatus_t **out) {
+    UBaseType_t cap = uxTaskGetNumberOfTasks() + 4;
+    *out = malloc(cap * sizeof(TaskStatus_t));
+    return *out ? uxTaskGetSystemState(*out, cap, NULL) : 0;
+}
+
+static const TaskStatus_t *find_task(const TaskStatus_t *st, UBaseType_t n, TaskHandle_t task) {
+    for (UBaseType_t i = 0; i < n; i++) {
+        if (st[i].xHandle == task) {
+            return &st[i];
+        }
+    }
+    return NULL;
+}
+
+static uint32_t idle_runtime(const TaskStatus_t *st, UBaseType_t n, int core) {
+    const TaskStatus_t *t = find_task(st, n, xTaskGetIdleTaskHandleForCore(core));
+    return t ? t->ulRunTimeCounter : 0;
+}
+#endif
+
+#if CONFIG_HEAP_TASK_TRACKING
+// 💾 heap ที่แต่ละ task ยังถืออยู่ (จองแล้วยังไม่คืน)
+static heap_task_totals_t heap_totals[LAB_COUNT + 16];
+static size_t heap_totals_count;
+
+static void heap_snapshot(void) {
+    heap_task_info_params_t params = { 0 };
+    params.caps[0] = MALLOC_CAP_8BIT;
+    params.mask[0] = MALLOC_CAP_8BIT;
+    params.totals = heap_totals;
+    params.num_totals = &heap_totals_count;
+    params.max_totals = sizeof(heap_totals) / sizeof(heap_totals[0]);
+    heap_totals_count = 0;
+    heap_caps_get_per_task_info(&params);
+}
+
+static size_t heap_held(TaskHandle_t task) {
+    for (size_t i = 0; i < heap_totals_count; i++) {
+        if (heap_totals[i].task == task) {
+            return heap_totals[i].size[0];
+        }
+    }
+    return 0;
+}
+#endif
+
+// 📊 ตารางสรุปราย lab: เวลาจริง, เวลา CPU (สัดส่วนของ core ที่ task ถูก pin ไว้ตลอดช่วงรัน),
+// stack ที่ไม่เคยถูกใช้ และ heap ที่ยังถืออยู่ ตามด้วยเวลาว่างของแต่ละ core
+static void report(const lab_slot_t *slots, int64_t elapsed_us, const uint32_t idle_before[],
+                   size_t heap_free_before) {
+    ESP_LOGI(TAG, "📊 lab            core   จริง ms    CPU ms   CPU%%  stack เหลือ  heap ถือ");
+#if CONFIG_FREERTOS_USE_TRACE_FACILITY && CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    TaskStatus_t *st;
+    UBaseType_t n = task_snapshot(&st);
+#if CONFIG_HEAP_TASK_TRACKING
+    heap_snapshot();
+#endif
+    for (size_t i = 0; i < LAB_COUNT; i++) {
+        const lab_slot_t *s = &slots[i];
+        const TaskStatus_t *t = find_task(st, n, s->task);
+        uint32_t cpu_us = t ? t->ulRunTimeCounter : 0;
+#if CONFIG_HEAP_TASK_TRACKING
+        size_t held = heap_held(s->task);
+#else
+        size_t held = 0;
+#endif
+        ESP_LOGI(TAG, "   %-14s %4d %9.1f %9.1f %6.1f %11lu %9u", s->lab->name, s->core,
+                 (s->end_us - s->start_us) / 1000.0, cpu_us / 1000.0,
+                 elapsed_us > 0 ? cpu_us * 100.0 / elapsed_us : 0.0,
+                 (unsigned long)(t ? t->usStackHighWaterMark : 0), (unsigned)held);
+    }
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        uint32_t idle = idle_runtime(st, n, core) - idle_before[core];
+        ESP_LOGI(TAG, "💤 core %d ว่าง %.1f%% ของ %.1f ms", core,
+                 elapsed_us > 0 ? idle * 100.0 / elapsed_us : 0.0, elapsed_us / 1000.0);
+    }
+    free(st);
+#else
+    (void)idle_before;
+    for (size_t i = 0; i < LAB_COUNT; i++) {
+        ESP_LOGI(TAG, "   %-14s %4d %9.1f", slots[i].lab->name, slots[i].core,
+                 (slots[i].end_us - slots[i].start_us) / 1000.0);
+    }
+    ESP_LOGW(TAG, "⚠️ เปิด CONFIG_FREERTOS_USE_TRACE_FACILITY และ CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS เพื่อดูเวลา CPU/stack");
+#endif
+    size_t min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    ESP_LOGI(TAG, "💾 heap ว่างก่อนรัน %u ไบต์ | ต่ำสุดระหว่างรัน %u ไบต์ (ใช้สูงสุด %u ไบต์)",
+             (unsigned)heap_free_before, (unsigned)min_free,
+             (unsigned)(heap_free_before > min_free ? heap_free_before - min_free : 0));
+}
+
+void app_main(void) {
+    static lab_slot_t slots[LAB_COUNT];
+    uint32_t idle_before[portNUM_PROCESSORS] = { 0 };
+
+    ESP_LOGI(TAG, "🚀 รันทั้ง %u lab พร้อมกันบน %d core", (unsigned)LAB_COUNT, portNUM_PROCESSORS);
+#if CONFIG_FREERTOS_USE_TRACE_FACILITY && CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    TaskStatus_t *st;
+    UBaseType_t n = task_snapshot(&st);
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        idle_before[core] = idle_runtime(st, n, core);
+    }
+    free(st);
+#endif
+    size_t heap_free_before = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+
+    // 🧵 หนึ่ง task ต่อหนึ่ง lab กระจายสลับ core ลำดับความสำคัญเท่ากับ app_main
+    SemaphoreHandle_t done = xSemaphoreCreateCounting(LAB_COUNT, 0);
+    int64_t start = esp_timer_get_time();
+    int started = 0;
+    for (size_t i = 0; i < LAB_COUNT; i++) {
+        lab_slot_t *s = &slots[i];
+        s->lab = &lab_table[i];
+        s->done = done;
+        s->core = (int)(i % portNUM_PROCESSORS);
+        if (xTaskCreatePinnedToCore(lab_task, s->lab->name, CONFIG_LAB_RUNNER_STACK_SIZE, s,
+                                    uxTaskPriorityGet(NULL), &s->task, s->core) != pdPASS) {
+            ESP_LOGE(TAG, "❌ สร้าง task ของ %s ไม่สำเร็จ", s->lab->name);
+            s->task = NULL;
+            continue;
+        }
+        started++;
+    }
+    for (int i = 0; i < started; i++) {
+        xSemaphoreTake(done, portMAX_DELAY);
+    }
+    int64_t elapsed_us = esp_timer_get_time() - start;
+
+    // รอจน task สุดท้ายพักตัวเองจริง (อาจยังอยู่ระหว่าง xSemaphoreGive กับ vTaskSuspend)
+    for (size_t i = 0; i < LAB_COUNT; i++) {
+        while (slots[i].task != NULL && eTaskGetState(slots[i].task) != eSuspended) {
+            vTaskDelay(1);
+        }
+    }
+    report(slots, elapsed_us, idle_before, heap_free_before);
+
+    for (size_t i = 0; i < LAB_COUNT; i++) {
+        if (slots[i].task != NULL) {
+            vTaskDelete(slots[i].task);
+        }
+    }
+    vSemaphoreDelete(done);
+    ESP_LOGI(TAG, "🎯 ครบทุก lab ใน %.1f มิลลิวินาที", elapsed_us / 1000.0);
+}
@@ -0,0 +1,114 @@
+#include "arith.h"
+
+// 📋 n! สำหรับ n = 0..20 (คำนวณไว้ล่วงหน้า ทุกค่าแทนได้พอดีใน double)
+static const double factorial_table[ARITH_FACTORIAL_MAX + 1] = {
+    1.0, 1.0, 2.0, 6.0, 24.0, 120.0, 720.0, 5040.0, 40320.0, 362880.0,
+    3628800.0, 39916800.0, 479001600.0, 6227020800.0, 87178291200.0,
+    1307674368000.0, 20922789888000.0, 355687428096000.0,
+    6402373705728000.0, 121645100408832000.0, 2432902008176640000.0,
+};
+
+const char *arith_err_name(arith_err_t err) {
+    switch (err) {
+        case ARITH_OK:                return "ok";
+        case ARITH_ERR_DIV_BY_ZERO:   return "div_by_zero";
+        case ARITH_ERR_INVALID_INPUT: return "invalid_input";
+        case ARITH_ERR_OUT_OF_RANGE:  return "out_of_range";
+        case ARITH_ERR_NEGATIVE:      return "negative";
+        case ARITH_ERR_OVERFLOW:      return "overflow";
+        case ARITH_ERR_UNDERFLOW:     return "underflow";
+    }
+    return "unknown";
+}
+
+arith_err_t arith_div(double a, double b, double *out) {
+    if (b == 0.0) {
+        *out = NAN;
+        return ARITH_ERR_DIV_BY_ZERO;
+    }
+    *out = a / b;
+    return isinf(*out) ? ARITH_ERR_OVERFLOW : ARITH_OK;
+}
+
+arith_err_t arith_sqrt(double a, double *out) {
+    if (a < 0) {
+        *out = NAN;
+        return ARITH_ERR_NEGATIVE;
+    }
+    *out = sqrt(a);
+    return ARITH_OK;
+}
+
+arith_err_t arith_factorial(int n, double *out) {
+    if (n < 0) {
+        *out = NAN;
+        return ARITH_ERR_NEGATIVE;
+    }
+    if (n > ARITH_FACTORIAL_MAX) {
+        *out = INFINITY;
+        return ARITH_ERR_OVERFLOW;
+    }
+    *out = factorial_table[n];
+    return ARITH_OK;
+}
+
+double arith_circle_area(double radius) {
+    return radius < 0 ? NAN : ARITH_PI * radius * radius;
+}
+
+double arith_circle_circumference(double radius) {
+    return radius < 0 ? NAN : 2.0 * ARITH_PI * radius;
+}
+
+double arith_rectangle_area(double length, double width) {
+    return (length < 0 || width < 0) ? NAN : length * width;
+}
+
+double arith_rectangle_perimeter(double length, double width) {
+    return (length < 0 || width < 0) ? NAN : 2.0 * (length + width);
+}
+
+double arith_box_volume(double length, double width, double height) {
+    return (length < 0 || width < 0 || height < 0) ? NAN : length * width * height;
+}
+
+double arith_box_surface(double length, double width, double height) {
+    if (length < 0 || width < 0 || height < 0) {
+        return NAN;
+    }
+    return 2.0 * (length * width + width * height + length * height);
+}
+
+double arith_triangle_area(double base, double height) {
+    return (base < 0 || height < 0) ? NAN : 0.5 * base * height;
+}
+
+double arith_cone_volume(double radius, double height) {
+    return (radius < 0 || height < 0) ? NAN : ARITH_PI * radius * radius * height * (1.0 / 3.0);
+}
+
+double arith_cone_surface(double radius, double height) {
+    if (radius < 0 || height < 0) {
+        return NAN;
+    }
+    double slant = sqrt(radius * radius + height * height);
+    return ARITH_PI * radius * (radius + slant);
+}
+
+arith_err_t arith_discount_percent(double price, double percent, double *out) {
+    if (percent < 0 || percent > 100) {
+        *out = price;
+        return ARITH_ERR_OUT_OF_RANGE;
+    }
+    *out = price - arith_percentage(price, percent);
+    return ARITH_OK;
+}
+
+arith_err_t arith_add_tax(double amount, double rate_percent, double *out) {
+    if (rate_percent < 0) {
+        *out = amount;
+        return ARITH_ERR_NEGATIVE;
+    }
+    *out = amount + arith_percentage(amount, rate_percent);
+    return ARITH_OK;
+}
@@ -0,0 +1,61 @@
+#include "arith_batch.h"
+
+// 🔢 ลูปจำนวนเต็ม: OR ธงล้นของทุกตัวเข้าด้วยกัน แปลงเป็น mask ครั้งเดียวตอนจบ
+#define INT_BATCH(name, builtin)                                                    \
+    arith_errmask_t name(const int *a, const int *b, int *out, size_t n) {          \
+        uint32_t overflow = 0;                                                      \
+        for (size_t i = 0; i < n; i++) {                                            \
+            overflow |= builtin(a[i], b[i], &out[i]);                               \
+        }                                                                           \
+        return overflow ? ARITH_ERR_BIT(ARITH_ERR_OVERFLOW) : 0;                    \
+    }
+
+INT_BATCH(arith_add_int_batch, __builtin_add_overflow)
+INT_BATCH(arith_sub_int_batch, __builtin_sub_overflow)
+INT_BATCH(arith_mul_int_batch, __builtin_mul_overflow)
+
+// ➕ ลูป double: ตรวจแค่ "มีค่าไม่จำกัดหรือไม่" ด้วย x - x (ค่าจำกัดได้ 0, inf/NaN ได้ NaN)
+// ไม่ใช้ธง FPU เพราะ double บน ESP32 คำนวณด้วยซอฟต์แวร์ ไม่มีธง fenv ให้อ่าน
+// ถ้าพบค่าผิด (กรณีน้อย) ค่อยไล่ทั้งชุดอีกรอบเพื่อแยกว่าเป็น inf หรือ NaN
+static arith_errmask_t classify(const double *out, size_t n) {
+    arith_errmask_t mask = 0;
+    for (size_t i = 0; i < n; i++) {
+        mask |= arith_value_mask(out[i]);
+    }
+    return mask;
+}
+
+#define DOUBLE_BATCH(name, op)                                                      \
+    arith_errmask_t name(const double *a, const double *b, double *out, size_t n) { \
+        uint32_t bad = 0;                                                           \
+        for (size_t i = 0; i < n; i++) {                                            \
+            out[i] = a[i] op b[i];                                                  \
+            bad |= (out[i] - out[i]) != 0.0;                                        \
+        }                                                                           \
+        return bad ? classify(out, n) : 0;                                          \
+    }
+
+DOUBLE_BATCH(arith_add_batch, +)
+DOUBLE_BATCH(arith_sub_batch, -)
+DOUBLE_BATCH(arith_mul_batch, *)
+
+arith_errmask_t arith_div_batch(const double *a, const double *b, double *out, size_t n) {
+    uint32_t bad = 0;
+    uint32_t zero = 0;
+    for (size_t i = 0; i < n; i++) {
+        zero |= b[i] == 0.0;
+        out[i] = a[i] / b[i];
+        bad |= (out[i] - out[i]) != 0.0;
+    }
+    arith_errmask_t mask = bad ? classify(out, n) : 0;
+    return mask | (zero ? ARITH_ERR_BIT(ARITH_ERR_DIV_BY_ZERO) : 0);
+}
+
+arith_errmask_t arith_sum_batch(const double *a, size_t n, double *out) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        sum += a[i];
+    }
+    *out = sum;
+    return arith_value_mask(sum);
+}
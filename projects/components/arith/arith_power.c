@@ -0,0 +1,99 @@
+#include "arith.h"
+#include "arith_batch.h"
+
+#include <stdbool.h>
+
+// 🔢 ยกกำลัง: pow() ของ double บน ESP32 เป็นซอฟต์แวร์ล้วนและช้ามาก
+// แต่เลขชี้กำลังที่ใช้จริงเกือบทั้งหมดเป็นจำนวนเต็ม (กำลังสอง, กำลังสาม, จำนวนงวดดอกเบี้ย)
+// จึงแยกกรณีจำนวนเต็มไปคูณซ้ำแทน — ความคลาดเคลื่อนสะสมทุกครั้งที่ยกกำลังสอง
+// (วัดเทียบ powl: |n| ≤ 64 → 6e-15, ≤ 1024 → 9e-14, แต่ 2³⁰ → 8e-8) จึงใช้เฉพาะ |n| ≤ ARITH_POWI_MAX
+
+double arith_powi(double base, int n) {
+    switch (n) {
+        case 0:  return 1.0;
+        case 1:  return base;
+        case 2:  return base * base;
+        case 3:  return base * base * base;
+        case -1: return 1.0 / base;
+        default: break;
+    }
+    unsigned e = n < 0 ? 0u - (unsigned)n : (unsigned)n;
+    if (e > ARITH_POWI_MAX) {
+        return pow(base, n);
+    }
+    double result = 1.0;
+    double x = base;
+    while (e) {
+        if (e & 1) {
+            result *= x;
+        }
+        x *= x;
+        e >>= 1;
+    }
+    return n < 0 ? 1.0 / result : result;
+}
+
+// เลขชี้กำลังเป็นจำนวนเต็มที่ใส่ int ได้หรือไม่ (NaN/inf ตกไปที่ pow())
+static inline bool integral_exponent(double exponent, int *n) {
+    if (!(fabs(exponent) <= ARITH_POWI_MAX) || exponent != (double)(int)exponent) {
+        return false;
+    }
+    *n = (int)exponent;
+    return true;
+}
+
+arith_err_t arith_power(double base, double exponent, double *out) {
+    if (base == 0.0 && exponent < 0) {
+        *out = NAN;
+        return ARITH_ERR_DIV_BY_ZERO;
+    }
+    int n;
+    *out = integral_exponent(exponent, &n) ? arith_powi(base, n) : pow(base, exponent);
+    // ตรงกับ arith_value_mask ของแบบชุด: NaN (ฐานติดลบกับเลขชี้กำลังไม่เต็ม, ข้อมูลเป็น NaN) = ข้อมูลไม่ถูกต้อง
+    if (isnan(*out)) {
+        return ARITH_ERR_INVALID_INPUT;
+    }
+    return isinf(*out) ? ARITH_ERR_OVERFLOW : ARITH_OK;
+}
+
+// 📦 ชุดข้อมูล: เลือกลูปตามเลขชี้กำลังครั้งเดียว แต่ละลูปไม่มีการแตกแขนงตาม exponent
+arith_errmask_t arith_power_batch(const double *bases, double exponent, double *out, size_t n) {
+    arith_errmask_t mask = 0;
+    uint32_t zero = 0;
+    int k;
+
+    if (exponent == 2.0) {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = bases[i] * bases[i];
+            mask |= arith_value_mask(out[i]);
+        }
+    } else if (exponent == 3.0) {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = bases[i] * bases[i] * bases[i];
+            mask |= arith_value_mask(out[i]);
+        }
+    } else if (exponent == 0.5) {
+        // sqrt ต่างจาก pow(x, 0.5) แค่ที่ -0 และ -inf
+        for (size_t i = 0; i < n; i++) {
+            double r = fabs(sqrt(bases[i]));
+            out[i] = bases[i] == -INFINITY ? INFINITY : r;
+            mask |= arith_value_mask(out[i]);
+        }
+    } else if (integral_exponent(exponent, &k)) {
+        for (size_t i = 0; i < n; i++) {
+            zero |= bases[i] == 0.0;
+            out[i] = arith_powi(bases[i], k);
+            mask |= arith_value_mask(out[i]);
+        }
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            zero |= bases[i] == 0.0;
+            out[i] = pow(bases[i], exponent);
+            mask |= arith_value_mask(out[i]);
+        }
+    }
+    if (zero && exponent < 0) {
+        mask |= ARITH_ERR_BIT(ARITH_ERR_DIV_BY_ZERO);
+    }
+    return mask;
+}
@@ -0,0 +1,163 @@
+#include "arith_bench.h"
+
+#include "arith.h"
+#include "arith_batch.h"
+#include "bench.h"
+
+#define N_INPUTS 64
+
+// 📥 ข้อมูลทดสอบ (บวก, มีทศนิยม) และ sink กันคอมไพเลอร์ตัดโค้ดทิ้ง
+static double in_a[N_INPUTS];
+static double in_b[N_INPUTS];
+static int in_i[N_INPUTS];
+static volatile double sink_d;
+static volatile int sink_i;
+static double out_d[N_INPUTS];
+static int out_i[N_INPUTS];
+
+static void fill_inputs(void) {
+    uint32_t x = 2463534242u;   // xorshift32 — ได้ข้อมูลชุดเดิมทุกครั้ง
+    for (int i = 0; i < N_INPUTS; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        in_a[i] = (x % 100000) / 100.0 + 1.0;
+        in_b[i] = ((x >> 8) % 10000) / 100.0 + 0.5;
+        in_i[i] = (int)(x % 1000);
+    }
+}
+
+// 🧩 สร้างฟังก์ชันวัดจากนิพจน์ (a, b, n คือข้อมูลทดสอบของรอบนั้น)
+#define KERNEL_D(id, expr)                                          \
+    static void bench_##id(void *ctx, uint32_t iters) {             \
+        (void)ctx;                                                  \
+        double acc = 0;                                             \
+        for (uint32_t k = 0; k < iters; k++) {                      \
+            double a = in_a[k % N_INPUTS], b = in_b[k % N_INPUTS];  \
+            (void)a; (void)b;                                       \
+            acc += (expr);                                          \
+        }                                                           \
+        sink_d = acc;                                               \
+    }
+
+#define KERNEL_ERR(id, call)                                        \
+    static void bench_##id(void *ctx, uint32_t iters) {             \
+        (void)ctx;                                                  \
+        double acc = 0, o;                                          \
+        for (uint32_t k = 0; k < iters; k++) {                      \
+            double a = in_a[k % N_INPUTS], b = in_b[k % N_INPUTS];  \
+            (void)a; (void)b;                                       \
+            call;                                                   \
+            acc += o;                                               \
+        }                                                           \
+        sink_d = acc;                                               \
+    }
+
+#define KERNEL_INT(id, fn)                                          \
+    static void bench_##id(void *ctx, uint32_t iters) {             \
+        (void)ctx;                                                  \
+        int acc = 0, o;                                             \
+        for (uint32_t k = 0; k < iters; k++) {                      \
+            fn(in_i[k % N_INPUTS], in_i[(k + 1) % N_INPUTS], &o);   \
+            acc ^= o;                                               \
+        }                                                           \
+        sink_i = acc;                                               \
+    }
+
+// 📦 batch: เรียกทีละ N_INPUTS ตัว เวลาที่ได้จึงเป็นต่อ 1 ตัวเหมือนเคอร์เนลเดี่ยว
+#define KERNEL_BATCH(id, type, call)                                \
+    static void bench_##id(void *ctx, uint32_t iters) {             \
+        (void)ctx;                                                  \
+        arith_errmask_t mask = 0;                                   \
+        for (uint32_t k = 0; k < iters; k += N_INPUTS) {            \
+            size_t n = iters - k < N_INPUTS ? iters - k : N_INPUTS; \
+            mask |= call;                                           \
+        }                                                           \
+        sink_##type = (int)mask;                                    \
+    }
+
+KERNEL_INT(add_int, arith_add_int)
+KERNEL_INT(sub_int, arith_sub_int)
+KERNEL_INT(mul_int, arith_mul_int)
+KERNEL_D(add, arith_add(a, b))
+KERNEL_D(sub, arith_sub(a, b))
+KERNEL_D(mul, arith_mul(a, b))
+KERNEL_ERR(div, arith_div(a, b, &o))
+KERNEL_ERR(power, arith_power(a, b * 0.1, &o))
+KERNEL_D(pow_libm_int, pow(a, (double)(in_i[k % N_INPUTS] % 12)))
+KERNEL_ERR(power_int, arith_power(a, (double)(in_i[k % N_INPUTS] % 12), &o))
+KERNEL_D(powi, arith_powi(a, in_i[k % N_INPUTS] % 12))
+KERNEL_D(compound_amount, arith_compound_amount(a, b * 0.1, 12))
+KERNEL_ERR(sqrt, arith_sqrt(a, &o))
+KERNEL_ERR(factorial, arith_factorial(in_i[k % N_INPUTS] % 21, &o))
+KERNEL_D(circle_area, arith_circle_area(a))
+KERNEL_D(circle_circumference, arith_circle_circumference(a))
+KERNEL_D(rectangle_area, arith_rectangle_area(a, b))
+KERNEL_D(rectangle_perimeter, arith_rectangle_perimeter(a, b))
+KERNEL_D(box_volume, arith_box_volume(a, b, a))
+KERNEL_D(box_surface, arith_box_surface(a, b, a))
+KERNEL_D(triangle_area, arith_triangle_area(a, b))
+KERNEL_D(cone_volume, arith_cone_volume(a, b))
+KERNEL_D(cone_surface, arith_cone_surface(a, b))
+KERNEL_D(sqm_to_rai, arith_sqm_to_rai(a))
+KERNEL_D(percentage, arith_percentage(a, b))
+KERNEL_ERR(discount_percent, arith_discount_percent(a, b, &o))
+KERNEL_D(discount_amount, arith_discount_amount(a, b))
+KERNEL_ERR(add_tax, arith_add_tax(a, b, &o))
+KERNEL_D(simple_interest, arith_simple_interest(a, b, 5))
+KERNEL_D(round_satang, arith_round_satang(a * 1.0001))
+// 🆚 แบบเดิม: ตรวจทีละตัวด้วยการแตกแขนง (เทียบกับ add_batch)
+static void bench_add_checked(void *ctx, uint32_t iters) {
+    (void)ctx;
+    arith_err_t err = ARITH_OK;
+    for (uint32_t k = 0; k < iters; k++) {
+        double r = arith_add(in_a[k % N_INPUTS], in_b[k % N_INPUTS]);
+        if (isinf(r)) {
+            err = ARITH_ERR_OVERFLOW;
+        } else if (isnan(r)) {
+            err = ARITH_ERR_INVALID_INPUT;
+        }
+        out_d[k % N_INPUTS] = r;
+    }
+    sink_i = err;
+}
+
+KERNEL_BATCH(add_int_batch, i, arith_add_int_batch(in_i, in_i, out_i, n))
+KERNEL_BATCH(mul_int_batch, i, arith_mul_int_batch(in_i, in_i, out_i, n))
+KERNEL_BATCH(add_batch, d, arith_add_batch(in_a, in_b, out_d, n))
+KERNEL_BATCH(sub_batch, d, arith_sub_batch(in_a, in_b, out_d, n))
+KERNEL_BATCH(mul_batch, d, arith_mul_batch(in_a, in_b, out_d, n))
+KERNEL_BATCH(div_batch, d, arith_div_batch(in_a, in_b, out_d, n))
+KERNEL_BATCH(power_batch_sq, d, arith_power_batch(in_a, 2.0, out_d, n))
+KERNEL_BATCH(power_batch_int, d, arith_power_batch(in_a, 12.0, out_d, n))
+KERNEL_BATCH(power_batch_frac, d, arith_power_batch(in_a, 1.5, out_d, n))
+KERNEL_BATCH(sum_batch, d, arith_sum_batch(in_a, n, &out_d[0]))
+
+#define CASE(id) { .name = "arith_" #id, .fn = bench_##id, .ctx = NULL }
+
+static const bench_case_t cases[] = {
+    CASE(add_int), CASE(sub_int), CASE(mul_int),
+    CASE(add), CASE(sub), CASE(mul), CASE(div),
+    CASE(power), CASE(pow_libm_int), CASE(power_int), CASE(powi),
+    CASE(sqrt), CASE(factorial),
+    CASE(circle_area), CASE(circle_circumference),
+    CASE(rectangle_area), CASE(rectangle_perimeter),
+    CASE(box_volume), CASE(box_surface), CASE(triangle_area),
+    CASE(cone_volume), CASE(cone_surface), CASE(sqm_to_rai),
+    CASE(percentage), CASE(discount_percent), CASE(discount_amount),
+    CASE(add_tax), CASE(simple_interest), CASE(round_satang),
+    CASE(add_checked), CASE(add_batch), CASE(sub_batch), CASE(mul_batch),
+    CASE(div_batch), CASE(sum_batch), CASE(compound_amount),
+    CASE(power_batch_sq), CASE(power_batch_int), CASE(power_batch_frac), CASE(add_int_batch), CASE(mul_int_batch),
+};
+
+void arith_bench_run_all(FILE *out) {
+    bench_config_t cfg = BENCH_CONFIG_DEFAULT;
+    bench_result_t r;
+
+    fill_inputs();
+    bench_calibrate(&cfg);
+    bench_print_csv_header(out);
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        bench_run(&cases[i], &cfg, &r);
+        bench_print_csv(out, &r);
+    }
+}
@@ -0,0 +1,359 @@
+// ✅ ทดสอบ arith บนเครื่อง host (ctest) — พิมพ์เฉพาะกรณีที่ผิด คืนค่า 1 ถ้ามีกรณีผิด
+// ครอบคลุมจุดที่พฤติกรรมเปลี่ยนตอนย้ายโค้ดของแต่ละโปรเจคมาใช้ arith:
+// การล้นของ int, หารด้วยศูนย์ (NAN แทน 0 แบบเดิมของ 07), ผล NaN ของการยกกำลัง, ขอบตารางแฟกทอเรียล,
+// ช่วงของส่วนลด/ภาษี (double และสตางค์ int64) และการปัดเศษของ *0.01 / *(1.0/3.0) ที่แทน /100 / /3
+// ส่วนแบบชุด (arith_batch.h) เทียบทุกตัวและทุกบิตของ mask กับเคอร์เนลเดี่ยว
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "arith.h"
+#include "arith_batch.h"
+
+static int failures;
+
+#define CHECK(cond) do {                                                \
+        if (!(cond)) {                                                  \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);      \
+            failures++;                                                 \
+        }                                                               \
+    } while (0)
+
+// |a - b| ไม่เกิน ulps หน่วยของหลักสุดท้าย (เทียบกับค่าที่ใหญ่กว่า)
+static int within_ulps(double a, double b, int ulps) {
+    double scale = fmax(fabs(a), fabs(b));
+    return fabs(a - b) <= ulps * DBL_EPSILON * scale;
+}
+
+static void test_int_overflow(void) {
+    int out;
+    CHECK(arith_add_int(2, 3, &out) == ARITH_OK && out == 5);
+    CHECK(arith_add_int(INT_MAX, 1, &out) == ARITH_ERR_OVERFLOW);
+    CHECK(arith_add_int(INT_MIN, -1, &out) == ARITH_ERR_OVERFLOW);
+    CHECK(arith_sub_int(10, 4, &out) == ARITH_OK && out == 6);
+    CHECK(arith_sub_int(INT_MIN, 1, &out) == ARITH_ERR_OVERFLOW);
+    CHECK(arith_sub_int(INT_MAX, -1, &out) == ARITH_ERR_OVERFLOW);
+    CHECK(arith_mul_int(-7, 6, &out) == ARITH_OK && out == -42);
+    CHECK(arith_mul_int(INT_MAX, 2, &out) == ARITH_ERR_OVERFLOW);
+    CHECK(arith_mul_int(INT_MIN, -1, &out) == ARITH_ERR_OVERFLOW);
+    CHECK(arith_mul_int(65536, 32768, &out) == ARITH_ERR_OVERFLOW);
+}
+
+static void test_divide(void) {
+    double out;
+    CHECK(arith_div(7.0, 2.0, &out) == ARITH_OK && out == 3.5);
+    CHECK(arith_div(1.0, 0.0, &out) == ARITH_ERR_DIV_BY_ZERO && isnan(out));
+    CHECK(arith_div(0.0, -0.0, &out) == ARITH_ERR_DIV_BY_ZERO && isnan(out));
+    CHECK(arith_div(DBL_MAX, 0.5, &out) == ARITH_ERR_OVERFLOW && isinf(out));
+}
+
+static void test_power(void) {
+    double out;
+    CHECK(arith_power(2.0, 10.0, &out) == ARITH_OK && out == 1024.0);
+    CHECK(arith_power(0.0, -1.0, &out) == ARITH_ERR_DIV_BY_ZERO && isnan(out));
+    CHECK(arith_power(10.0, 400.0, &out) == ARITH_ERR_OVERFLOW && isinf(out));
+    // NaN ได้รหัสเดียวกับ arith_value_mask ของ arith_power_batch
+    CHECK(arith_power(-8.0, 0.5, &out) == ARITH_ERR_INVALID_INPUT && isnan(out));
+    CHECK(arith_power(NAN, 2.0, &out) == ARITH_ERR_INVALID_INPUT && isnan(out));
+    CHECK(arith_power(2.0, NAN, &out) == ARITH_ERR_INVALID_INPUT && isnan(out));
+
+    // เลขชี้กำลังจำนวนเต็มไม่เกิน ARITH_POWI_MAX คลาดจาก powl ไม่เกิน 1e-13 ที่เกินจากนั้นได้ผลเดียวกับ pow()
+    for (int n = 4; n <= ARITH_POWI_MAX; n += 13) {
+        for (int sign = -1; sign <= 1; sign += 2) {
+            double base = exp(sign * 600.0 / n * 0.7071);
+            long double ref = powl(base, sign * n);
+            CHECK(arith_power(base, sign * n, &out) == ARITH_OK && fabsl((out - ref) / ref) <= 1e-13L);
+        }
+    }
+    CHECK(arith_power(1.0000001, ARITH_POWI_MAX + 1.0, &out) == ARITH_OK &&
+          out == pow(1.0000001, ARITH_POWI_MAX + 1.0));
+    CHECK(arith_power(1.0000001, 1e6, &out) == ARITH_OK && out == pow(1.0000001, 1e6));
+    CHECK(arith_powi(0.9999999, -(1 << 30)) == pow(0.9999999, -(1 << 30)));
+}
+
+static void test_factorial(void) {
+    double out;
+    CHECK(arith_factorial(0, &out) == ARITH_OK && out == 1.0);
+    CHECK(arith_factorial(10, &out) == ARITH_OK && out == 3628800.0);
+    CHECK(arith_factorial(ARITH_FACTORIAL_MAX, &out) == ARITH_OK && out == 2432902008176640000.0);
+    CHECK(arith_factorial(ARITH_FACTORIAL_MAX + 1, &out) == ARITH_ERR_OVERFLOW && isinf(out));
+    CHECK(arith_factorial(-1, &out) == ARITH_ERR_NEGATIVE && isnan(out));
+    // ทุกค่าในตารางต้องเท่ากับผลคูณสะสม (แทนได้พอดีใน double จนถึง 20!)
+    double expect = 1.0;
+    for (int n = 1; n <= ARITH_FACTORIAL_MAX; n++) {
+        expect *= n;
+        CHECK(arith_factorial(n, &out) == ARITH_OK && out == expect);
+    }
+}
+
+static void test_discount_tax(void) {
+    double out;
+    CHECK(arith_discount_percent(200.0, 0.0, &out) == ARITH_OK && out == 200.0);
+    CHECK(arith_discount_percent(200.0, 100.0, &out) == ARITH_OK && out == 0.0);
+    CHECK(arith_discount_percent(200.0, 15.0, &out) == ARITH_OK && within_ulps(out, 170.0, 1));
+    CHECK(arith_discount_percent(200.0, 100.5, &out) == ARITH_ERR_OUT_OF_RANGE && out == 200.0);
+    CHECK(arith_discount_percent(200.0, -0.5, &out) == ARITH_ERR_OUT_OF_RANGE && out == 200.0);
+    CHECK(arith_add_tax(100.0, 7.0, &out) == ARITH_OK && within_ulps(out, 107.0, 1));
+    CHECK(arith_add_tax(100.0, 0.0, &out) == ARITH_OK && out == 100.0);
+    CHECK(arith_add_tax(100.0, -7.0, &out) == ARITH_ERR_NEGATIVE && out == 100.0);
+}
+
+// 🪙 ยอดสตางค์ int64: ปัดครึ่งสตางค์ขึ้น ตรวจการล้น และไม่เปลี่ยนยอดเมื่อผิดพลาด
+static void test_satang(void) {
+    int64_t out;
+    CHECK(arith_satang_mul(2500, 6, &out) == ARITH_OK && out == 15000);
+    CHECK(arith_satang_mul(INT64_MAX / 2 + 1, 2, &out) == ARITH_ERR_OVERFLOW);
+    CHECK(arith_satang_percent(26200, 700, &out) == ARITH_OK && out == 1834);
+    CHECK(arith_satang_percent(50, 100, &out) == ARITH_OK && out == 1);         // 0.5 สตางค์ปัดขึ้น
+    CHECK(arith_satang_percent(49, 100, &out) == ARITH_OK && out == 0);
+    CHECK(arith_satang_percent(-1, 700, &out) == ARITH_ERR_NEGATIVE && out == 0);
+    CHECK(arith_satang_percent(INT64_MAX / 10000 + 1, 10000, &out) == ARITH_ERR_OVERFLOW && out == 0);
+    CHECK(arith_satang_discount_bp(20000, 1500, &out) == ARITH_OK && out == 17000);
+    CHECK(arith_satang_discount_bp(20000, ARITH_BP_FULL, &out) == ARITH_OK && out == 0);
+    CHECK(arith_satang_discount_bp(20000, ARITH_BP_FULL + 1, &out) == ARITH_ERR_OUT_OF_RANGE && out == 20000);
+    CHECK(arith_satang_discount_bp(INT64_MAX, 1, &out) == ARITH_ERR_OVERFLOW && out == INT64_MAX);
+    CHECK(arith_satang_discount(28200, 2000, &out) == ARITH_OK && out == 26200);
+    CHECK(arith_satang_discount(28200, 28200, &out) == ARITH_OK && out == 0);
+    CHECK(arith_satang_discount(28200, 28201, &out) == ARITH_ERR_OUT_OF_RANGE && out == 28200);
+    CHECK(arith_satang_discount(28200, -1, &out) == ARITH_ERR_NEGATIVE && out == 28200);
+    CHECK(arith_satang_prorate(10000, 26200, 28200, &out) == ARITH_OK && out == 9291);
+    CHECK(arith_satang_prorate(1, 1, 2, &out) == ARITH_OK && out == 1);
+    CHECK(arith_satang_prorate(10000, 1, 0, &out) == ARITH_ERR_DIV_BY_ZERO && out == 0);
+    CHECK(arith_satang_prorate(10000, -1, 3, &out) == ARITH_ERR_NEGATIVE && out == 0);
+    CHECK(arith_satang_prorate(INT64_MAX, 2, 3, &out) == ARITH_ERR_OVERFLOW && out == 0);
+
+    // ตรงกับสูตร double + ปัดครั้งเดียวทุกยอดที่ double แทนได้ตรง
+    for (int64_t amount = 0; amount <= 200000; amount += 37) {
+        for (uint32_t bp = 0; bp <= ARITH_BP_FULL; bp += 125) {
+            CHECK(arith_satang_percent(amount, bp, &out) == ARITH_OK &&
+                  out == (int64_t)floor(amount * (double)bp / ARITH_BP_FULL + 0.5));
+        }
+    }
+}
+
+// 📦 แบบชุด ---------------------------------------------------------------
+
+// ค่าเดียวกันทุกบิต (NaN ถือว่าเท่ากันทุกตัว)
+static bool same_double(double a, double b) {
+    return (isnan(a) && isnan(b)) || memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+static arith_errmask_t scalar_bit(arith_err_t err) {
+    return err == ARITH_OK ? 0 : ARITH_ERR_BIT(err);
+}
+
+static const double batch_values[] = {
+    0.0, -0.0, 1.0, -2.5, 3.0, 0.5, 1e-310, DBL_MAX, -DBL_MAX, 1e200, -1e-200,
+    INFINITY, -INFINITY, NAN, -NAN, 7.25, -4.0,
+};
+#define N_BATCH (sizeof(batch_values) / sizeof(batch_values[0]))
+
+static void test_batch_mask(void) {
+    CHECK(arith_errmask_first(0) == ARITH_OK);
+    for (arith_err_t err = ARITH_ERR_DIV_BY_ZERO; err <= ARITH_ERR_UNDERFLOW; err++) {
+        CHECK(arith_errmask_first(ARITH_ERR_BIT(err)) == err);
+        // บิตที่มากกว่าไม่บังบิตที่น้อยกว่า
+        CHECK(arith_errmask_first(ARITH_ERR_BIT(err) | ARITH_ERR_BIT(ARITH_ERR_UNDERFLOW)) == err);
+    }
+    CHECK(arith_errmask_first(ARITH_ERR_BIT(ARITH_ERR_OVERFLOW) | ARITH_ERR_BIT(ARITH_ERR_DIV_BY_ZERO)) ==
+          ARITH_ERR_DIV_BY_ZERO);
+
+    CHECK(arith_value_mask(0.0) == 0 && arith_value_mask(-0.0) == 0);
+    CHECK(arith_value_mask(1e-310) == 0 && arith_value_mask(DBL_MAX) == 0);
+    CHECK(arith_value_mask(INFINITY) == ARITH_ERR_BIT(ARITH_ERR_OVERFLOW));
+    CHECK(arith_value_mask(-INFINITY) == ARITH_ERR_BIT(ARITH_ERR_OVERFLOW));
+    CHECK(arith_value_mask(NAN) == ARITH_ERR_BIT(ARITH_ERR_INVALID_INPUT));
+    CHECK(arith_value_mask(-NAN) == ARITH_ERR_BIT(ARITH_ERR_INVALID_INPUT));
+}
+
+// ทุกคู่ (a, b) จาก batch_values: ทีละตัวต้องตรงกับเคอร์เนลเดี่ยว และ mask ของทั้งชุด = OR ของทีละตัว
+static void test_batch_int(void) {
+    static const int ints[] = {0, 1, -1, 7, -42, 65536, 32768, INT_MAX, INT_MIN, INT_MAX / 2 + 1};
+    enum { NI = sizeof(ints) / sizeof(ints[0]), NP = NI * NI };
+    int a[NP], b[NP], out[NP];
+    arith_errmask_t expect[3] = {0};
+    for (int i = 0; i < NP; i++) {
+        a[i] = ints[i / NI];
+        b[i] = ints[i % NI];
+    }
+    arith_errmask_t (*const batch[3])(const int *, const int *, int *, size_t) = {
+        arith_add_int_batch, arith_sub_int_batch, arith_mul_int_batch,
+    };
+    for (int op = 0; op < 3; op++) {
+        arith_errmask_t whole = batch[op](a, b, out, NP);
+        for (int i = 0; i < NP; i++) {
+            int single, scalar;
+            arith_err_t err = op == 0 ? arith_add_int(a[i], b[i], &scalar)
+                            : op == 1 ? arith_sub_int(a[i], b[i], &scalar)
+                                      : arith_mul_int(a[i], b[i], &scalar);
+            arith_errmask_t mask = batch[op](&a[i], &b[i], &single, 1);
+            CHECK(mask == scalar_bit(err));
+            CHECK(single == scalar && out[i] == scalar);    // ล้นก็ได้ค่า wrap-around เดียวกัน
+            expect[op] |= mask;
+        }
+        CHECK(whole == expect[op]);
+        CHECK(whole == ARITH_ERR_BIT(ARITH_ERR_OVERFLOW));
+        CHECK(batch[op](a, b, out, 0) == 0);
+    }
+}
+
+static void test_batch_double(void) {
+    enum { NP = N_BATCH * N_BATCH };
+    double a[NP], b[NP], out[NP];
+    for (size_t i = 0; i < NP; i++) {
+        a[i] = batch_values[i / N_BATCH];
+        b[i] = batch_values[i % N_BATCH];
+    }
+    arith_errmask_t (*const batch[4])(const double *, const double *, double *, size_t) = {
+        arith_add_batch, arith_sub_batch, arith_mul_batch, arith_div_batch,
+    };
+    for (int op = 0; op < 4; op++) {
+        arith_errmask_t whole = batch[op](a, b, out, NP);
+        arith_errmask_t expect = 0;
+        for (size_t i = 0; i < NP; i++) {
+            double single;
+            arith_errmask_t mask = batch[op](&a[i], &b[i], &single, 1);
+            CHECK(same_double(single, out[i]));
+            if (op < 3) {
+                double scalar = op == 0 ? arith_add(a[i], b[i])
+                              : op == 1 ? arith_sub(a[i], b[i]) : arith_mul(a[i], b[i]);
+                CHECK(same_double(single, scalar));
+                CHECK(mask == arith_value_mask(scalar));
+            } else if (b[i] == 0.0) {
+                // ตัวหารเป็น 0: บิตหารด้วยศูนย์ติดเสมอ บวกบิตของ inf/NaN ที่ probe x - x เจอ
+                double scalar;
+                CHECK(arith_div(a[i], b[i], &scalar) == ARITH_ERR_DIV_BY_ZERO);
+                CHECK(mask == (ARITH_ERR_BIT(ARITH_ERR_DIV_BY_ZERO) | arith_value_mask(a[i] / b[i])));
+            } else {
+                double scalar;
+                arith_err_t err = arith_div(a[i], b[i], &scalar);
+                CHECK(same_double(single, scalar));
+                CHECK((mask & ARITH_ERR_BIT(ARITH_ERR_OVERFLOW)) == scalar_bit(err));
+                CHECK(mask == arith_value_mask(scalar));
+            }
+            expect |= mask;
+        }
+        CHECK(whole == expect);
+    }
+
+    // mask ติดค้าง: ตัวผิดตัวเดียวกลางชุดที่เหลือปกติทั้งหมด
+    double x[64], y[64], r[64];
+    for (int i = 0; i < 64; i++) {
+        x[i] = i + 1.0;
+        y[i] = 2.0;
+    }
+    CHECK(arith_div_batch(x, y, r, 64) == 0 && r[63] == 32.0);
+    y[17] = 0.0;
+    CHECK(arith_div_batch(x, y, r, 64) ==
+          (ARITH_ERR_BIT(ARITH_ERR_DIV_BY_ZERO) | ARITH_ERR_BIT(ARITH_ERR_OVERFLOW)));
+    CHECK(isinf(r[17]) && r[16] == 8.5 && r[18] == 9.5);
+    x[17] = 0.0;
+    CHECK(arith_div_batch(x, y, r, 64) ==
+          (ARITH_ERR_BIT(ARITH_ERR_DIV_BY_ZERO) | ARITH_ERR_BIT(ARITH_ERR_INVALID_INPUT)));
+    y[17] = -0.0;
+    x[40] = DBL_MAX;
+    y[40] = 0.5;
+    CHECK(arith_div_batch(x, y, r, 64) == (ARITH_ERR_BIT(ARITH_ERR_DIV_BY_ZERO) |
+                                           ARITH_ERR_BIT(ARITH_ERR_INVALID_INPUT) |
+                                           ARITH_ERR_BIT(ARITH_ERR_OVERFLOW)));
+    CHECK(arith_mul_batch(x, y, r, 64) == 0);
+    CHECK(arith_div_batch(x, y, r, 0) == 0);
+
+    double sum;
+    CHECK(arith_sum_batch(x, 0, &sum) == 0 && sum == 0.0);
+    CHECK(arith_sum_batch(y, 4, &sum) == 0 && sum == 8.0);
+    const double big[] = {DBL_MAX, DBL_MAX};
+    CHECK(arith_sum_batch(big, 2, &sum) == ARITH_ERR_BIT(ARITH_ERR_OVERFLOW) && isinf(sum));
+    const double cancel[] = {INFINITY, 1.0, -INFINITY};
+    CHECK(arith_sum_batch(cancel, 3, &sum) == ARITH_ERR_BIT(ARITH_ERR_INVALID_INPUT) && isnan(sum));
+}
+
+// ยกกำลังแบบชุดทุกเส้นทาง (2, 3, 0.5, จำนวนเต็ม, จำนวนเต็มเกิน ARITH_POWI_MAX, ไม่เต็ม) เทียบ arith_power
+static void test_batch_power(void) {
+    static const double exponents[] = {
+        2.0, 3.0, 0.5, 0.0, 1.0, -1.0, 7.0, -2.0, ARITH_POWI_MAX, -(ARITH_POWI_MAX + 1.0),
+        1e6, 1.5, -0.5, INFINITY, NAN,
+    };
+    double out[N_BATCH];
+    for (size_t e = 0; e < sizeof(exponents) / sizeof(exponents[0]); e++) {
+        double exponent = exponents[e];
+        arith_errmask_t whole = arith_power_batch(batch_values, exponent, out, N_BATCH);
+        arith_errmask_t expect = 0;
+        for (size_t i = 0; i < N_BATCH; i++) {
+            double single, scalar;
+            arith_errmask_t mask = arith_power_batch(&batch_values[i], exponent, &single, 1);
+            arith_err_t err = arith_power(batch_values[i], exponent, &scalar);
+            CHECK(same_double(single, out[i]));
+            if (batch_values[i] == 0.0 && exponent < 0) {
+                // เคอร์เนลเดี่ยวคืน NaN ส่วนแบบชุดได้ ±inf ตาม IEEE และติดทั้งสองบิต
+                CHECK(err == ARITH_ERR_DIV_BY_ZERO);
+                CHECK(mask == (ARITH_ERR_BIT(ARITH_ERR_DIV_BY_ZERO) | ARITH_ERR_BIT(ARITH_ERR_OVERFLOW)));
+                CHECK(isinf(single));
+            } else {
+                if (!same_double(single, scalar)) {
+                    printf("FAIL power_batch(%g, %g) = %.17g != arith_power %.17g\n",
+                           batch_values[i], exponent, single, scalar);
+                    failures++;
+                }
+                CHECK(mask == scalar_bit(err));
+            }
+            expect |= mask;
+        }
+        CHECK(whole == expect);
+    }
+    CHECK(arith_power_batch(batch_values, -1.0, out, 0) == 0);
+}
+
+// *0.01 และ *(1.0/3.0) ต่างจากการหารตรงได้ไม่เกินหลักสุดท้าย 2 หน่วย
+// ผลที่พิมพ์เป็นสตางค์ (%.2f) ต่างกันได้เฉพาะค่าที่อยู่กึ่งกลางพอดี (x.xx5 บาท) ซึ่งทั้งสองแบบ
+// เก็บเป็น double ได้ไม่ตรงอยู่แล้ว — ที่เหลือทุกค่าต้องพิมพ์ออกมาเหมือนเดิม
+static void test_rounding(void) {
+    char a[64], b[64];
+    for (int satang = 0; satang <= 200000; satang += 7) {
+        double value = satang / 100.0;
+        for (int quarters = 0; quarters <= 400; quarters += 3) {
+            double percent = quarters * 0.25;
+            double fast = arith_percentage(value, percent);
+            double exact = value * percent / 100.0;
+            CHECK(within_ulps(fast, exact, 2));
+            // ผลจริง = satang × quarters / 400 สตางค์ กึ่งกลางพอดีเมื่อเศษเป็นครึ่งหนึ่ง
+            bool tie = (2LL * satang * quarters) % 800 == 400;
+            snprintf(a, sizeof(a), "%.2f", fast);
+            snprintf(b, sizeof(b), "%.2f", exact);
+            if (!tie && strcmp(a, b) != 0) {
+                printf("FAIL %.2f%% ของ %.2f: %s != %s\n", percent, value, a, b);
+                failures++;
+            }
+        }
+    }
+    CHECK(arith_percentage(200.0, 15.0) == 30.0);
+    CHECK(arith_percentage(1000.0, 7.0) == 70.0);
+
+    for (int r = 0; r <= 200; r++) {
+        for (int h = 0; h <= 200; h += 3) {
+            double radius = r * 0.5, height = h * 0.25;
+            double fast = arith_cone_volume(radius, height);
+            double exact = ARITH_PI * radius * radius * height / 3.0;
+            CHECK(within_ulps(fast, exact, 2));
+        }
+    }
+    CHECK(isnan(arith_cone_volume(-1.0, 2.0)));
+}
+
+int main(void) {
+    test_int_overflow();
+    test_divide();
+    test_power();
+    test_factorial();
+    test_discount_tax();
+    test_satang();
+    test_batch_mask();
+    test_batch_int();
+    test_batch_double();
+    test_batch_power();
+    test_rounding();
+    printf("arith_test: %s (%d failures)\n", failures ? "FAIL" : "ok", failures);
+    return failures ? 1 : 0;
+}
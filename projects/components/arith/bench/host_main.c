@@ -0,0 +1,8 @@
+// 🖥️ ตัวรัน benchmark ของ arith บนเครื่อง host — พิมพ์ CSV ออก stdout
+#include <stdio.h>
+#include "arith_bench.h"
+
+int main(void) {
+    arith_bench_run_all(stdout);
+    return 0;
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+// 🧮 arith: เคอร์เนลคำนวณที่ใช้ร่วมกันทุกโปรเจค (01-08)
+// ฟังก์ชันในนี้ไม่พิมพ์ log เอง — คืนรหัสข้อผิดพลาดให้ผู้เรียกตัดสินใจ
+
+#define ARITH_PI 3.14159265358979323846
+#define ARITH_SQM_PER_RAI 1600.0        // 1 ไร่ = 1,600 ตร.ม.
+#define ARITH_FACTORIAL_MAX 20          // 21! เกินความแม่นยำของ double
+
+// 🚨 รหัสข้อผิดพลาด (ลำดับตรงกับ error_code_t ของโปรเจค 07)
+typedef enum {
+    ARITH_OK = 0,
+    ARITH_ERR_DIV_BY_ZERO,      // หารด้วยศูนย์ / 0 ยกกำลังลบ
+    ARITH_ERR_INVALID_INPUT,    // ข้อมูลไม่ใช่ตัวเลข / NaN
+    ARITH_ERR_OUT_OF_RANGE,     // เกินขอบเขตที่กำหนด
+    ARITH_ERR_NEGATIVE,         // ค่าติดลบในที่ที่ห้ามติดลบ
+    ARITH_ERR_OVERFLOW,         // ผลลัพธ์ล้น
+    ARITH_ERR_UNDERFLOW,        // ผลลัพธ์ต่ำเกินไป
+} arith_err_t;
+
+// ข้อความสั้นๆ ของแต่ละรหัส (ภาษาอังกฤษ ไว้ใช้ใน log/telemetry)
+const char *arith_err_name(arith_err_t err);
+
+// ---------------------------------------------------------------------------
+// 🔢 จำนวนเต็ม int (ตรวจการล้นด้วย compiler builtin)
+// ---------------------------------------------------------------------------
+static inline arith_err_t arith_add_int(int a, int b, int *out) {
+    return __builtin_add_overflow(a, b, out) ? ARITH_ERR_OVERFLOW : ARITH_OK;
+}
+
+static inline arith_err_t arith_sub_int(int a, int b, int *out) {
+    return __builtin_sub_overflow(a, b, out) ? ARITH_ERR_OVERFLOW : ARITH_OK;
+}
+
+static inline arith_err_t arith_mul_int(int a, int b, int *out) {
+    return __builtin_mul_overflow(a, b, out) ? ARITH_ERR_OVERFLOW : ARITH_OK;
+}
+
+// ---------------------------------------------------------------------------
+// ➕ พื้นฐาน (double)
+// ---------------------------------------------------------------------------
+static inline double arith_add(double a, double b) { return a + b; }
+static inline double arith_sub(double a, double b) { return a - b; }
+static inline double arith_mul(double a, double b) { return a * b; }
+
+// หาร: b == 0 → ARITH_ERR_DIV_BY_ZERO, ผลเป็น inf → ARITH_ERR_OVERFLOW
+arith_err_t arith_div(double a, double b, double *out);
+
+// ยกกำลัง: 0 ยกกำลังลบ → ARITH_ERR_DIV_BY_ZERO, ผลเป็น NaN (เช่น (-8)^0.5) → ARITH_ERR_INVALID_INPUT
+// เลขชี้กำลังเป็นจำนวนเต็ม (|n| ≤ ARITH_POWI_MAX) ใช้ arith_powi แทน pow() (ดู arith_power.c)
+arith_err_t arith_power(double base, double exponent, double *out);
+
+// ยกกำลังจำนวนเต็มด้วยการยกกำลังสองซ้ำ (≤ 2·log2|n| ครั้งคูณ) n = 0..3 คูณตรงๆ
+// ความคลาดเคลื่อนโตตาม |n| (วัดเทียบ powl: ราว 0.4·|n| ulp, |n| = 1024 ≤ 9e-14)
+// |n| > ARITH_POWI_MAX จึงส่งต่อให้ pow() ซึ่งปัดถูกเกือบทุกค่า
+#define ARITH_POWI_MAX 1024
+double arith_powi(double base, int n);
+
+// รากที่สอง: ค่าลบ → ARITH_ERR_NEGATIVE
+arith_err_t arith_sqrt(double a, double *out);
+
+// แฟกทอเรียล (ตารางค่าคำนวณไว้แล้ว): n < 0 → ARITH_ERR_NEGATIVE,
+// n > ARITH_FACTORIAL_MAX → ARITH_ERR_OVERFLOW และ *out = INFINITY
+arith_err_t arith_factorial(int n, double *out);
+
+// ---------------------------------------------------------------------------
+// 📐 เรขาคณิต — ขนาดติดลบคืนค่า NAN
+// ---------------------------------------------------------------------------
+double arith_circle_area(double radius);
+double arith_circle_circumference(double radius);
+double arith_rectangle_area(double length, double width);
+double arith_rectangle_perimeter(double length, double width);
+double arith_box_volume(double length, double width, double height);
+double arith_box_surface(double length, double width, double height);
+double arith_triangle_area(double base, double height);
+double arith_cone_volume(double radius, double height);
+double arith_cone_surface(double radius, double height);
+
+static inline double arith_sqm_to_rai(double square_meters) {
+    return square_meters * (1.0 / ARITH_SQM_PER_RAI);
+}
+
+// ---------------------------------------------------------------------------
+// 💰 การเงิน
+// ---------------------------------------------------------------------------
+// percent% ของ value
+static inline double arith_percentage(double value, double percent) {
+    return value * percent * 0.01;
+}
+
+// ลดราคาเป็นเปอร์เซ็นต์ (โปรเจค 08): percent นอกช่วง 0-100 → ARITH_ERR_OUT_OF_RANGE, *out = ราคาเดิม
+arith_err_t arith_discount_percent(double price, double percent, double *out);
+
+// ลดราคาเป็นจำนวนเงิน (double) — ยอดสตางค์ใช้ arith_satang_discount
+static inline double arith_discount_amount(double total, double amount) {
+    return total - amount;
+}
+
+// บวกภาษี/VAT: อัตราติดลบ → ARITH_ERR_NEGATIVE, *out = ยอดเดิม
+arith_err_t arith_add_tax(double amount, double rate_percent, double *out);
+
+// ดอกเบี้ยแบบง่าย (คืนเฉพาะดอกเบี้ย)
+static inline double arith_simple_interest(double principal, double rate_percent, int years) {
+    return principal * rate_percent * 0.01 * years;
+}
+
+// ยอดเงินรวมดอกเบี้ยทบต้น: principal × (1 + rate/100)^periods
+static inline double arith_compound_amount(double principal, double rate_percent, int periods) {
+    return principal * arith_powi(1.0 + rate_percent * 0.01, periods);
+}
+
+// ปัดเป็นสตางค์ (ทศนิยม 2 ตำแหน่ง)
+static inline double arith_round_satang(double amount) {
+    return round(amount * 100.0) * 0.01;
+}
+
+// ---------------------------------------------------------------------------
+// 🪙 เงินเป็นสตางค์ (int64) อัตราเป็น basis point (700 = 7%)
+// ไม่ผ่าน double ปัดครึ่งสตางค์ขึ้นครั้งเดียว ล้น → ARITH_ERR_OVERFLOW
+// ---------------------------------------------------------------------------
+#define ARITH_BP_FULL 10000             // 100% = 10000 bp
+
+// ราคาต่อหน่วย × จำนวน
+static inline arith_err_t arith_satang_mul(int64_t unit, int64_t quantity, int64_t *out) {
+    return __builtin_mul_overflow(unit, quantity, out) ? ARITH_ERR_OVERFLOW : ARITH_OK;
+}
+
+// bp ของ amount (ส่วนลด/VAT เป็นเงิน): amount ติดลบ → ARITH_ERR_NEGATIVE, *out = 0
+static inline arith_err_t arith_satang_percent(int64_t amount, uint32_t bp, int64_t *out) {
+    int64_t scaled;
+    *out = 0;
+    if (amount < 0) {
+        return ARITH_ERR_NEGATIVE;
+    }
+    if (__builtin_mul_overflow(amount, (int64_t)bp, &scaled) ||
+        __builtin_add_overflow(scaled, ARITH_BP_FULL / 2, &scaled)) {
+        return ARITH_ERR_OVERFLOW;
+    }
+    *out = scaled / ARITH_BP_FULL;
+    return ARITH_OK;
+}
+
+// ลดราคา bp: เกิน 100% → ARITH_ERR_OUT_OF_RANGE, ผิดพลาดทุกกรณี *out = ยอดเดิม
+static inline arith_err_t arith_satang_discount_bp(int64_t amount, uint32_t bp, int64_t *out) {
+    int64_t off;
+    arith_err_t err = bp > ARITH_BP_FULL ? ARITH_ERR_OUT_OF_RANGE : arith_satang_percent(amount, bp, &off);
+    *out = err == ARITH_OK ? amount - off : amount;
+    return err;
+}
+
+// ลดราคาเป็นจำนวนเงิน: ส่วนลดติดลบ → ARITH_ERR_NEGATIVE, เกินยอด → ARITH_ERR_OUT_OF_RANGE
+// ผิดพลาดทุกกรณี *out = ยอดเดิม
+static inline arith_err_t arith_satang_discount(int64_t total, int64_t discount, int64_t *out) {
+    *out = total;
+    if (discount < 0) {
+        return ARITH_ERR_NEGATIVE;
+    }
+    if (discount > total) {
+        return ARITH_ERR_OUT_OF_RANGE;
+    }
+    *out = total - discount;
+    return ARITH_OK;
+}
+
+// amount × part / whole ปัดครึ่งสตางค์ขึ้น (เฉลี่ยส่วนลดท้ายบิลลงบางรายการ)
+// whole ≤ 0 → ARITH_ERR_DIV_BY_ZERO, ค่าติดลบ → ARITH_ERR_NEGATIVE, *out = 0
+static inline arith_err_t arith_satang_prorate(int64_t amount, int64_t part, int64_t whole, int64_t *out) {
+    int64_t scaled;
+    *out = 0;
+    if (whole <= 0) {
+        return ARITH_ERR_DIV_BY_ZERO;
+    }
+    if (amount < 0 || part < 0) {
+        return ARITH_ERR_NEGATIVE;
+    }
+    if (__builtin_mul_overflow(amount, part, &scaled) ||
+        __builtin_add_overflow(scaled, whole / 2, &scaled)) {
+        return ARITH_ERR_OVERFLOW;
+    }
+    *out = scaled / whole;
+    return ARITH_OK;
+}
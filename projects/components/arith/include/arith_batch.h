@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "arith.h"
+
+// 📦 arith_batch: คำนวณทั้งอาร์เรย์ แล้วตรวจข้อผิดพลาดครั้งเดียวต่อชุด
+// ทุกเคอร์เนลคืน "error mask" แบบ sticky: บิตของทุกข้อผิดพลาดที่เกิดในชุดถูก OR รวมกัน
+// ในลูปไม่มีการแตกแขนงหรือพิมพ์ข้อความ ผู้เรียกเช็ก mask == 0 ครั้งเดียวหลังจบชุด
+//
+// ผลในอาร์เรย์ out เป็นค่าตามมาตรฐาน IEEE / wrap-around ของจำนวนเต็ม
+// ถ้า mask ไม่เป็น 0 และต้องการรู้ว่าตัวไหนผิด ให้ไล่ตรวจด้วยเคอร์เนลเดี่ยวใน arith.h
+
+typedef uint32_t arith_errmask_t;
+
+#define ARITH_ERR_BIT(err) ((arith_errmask_t)1u << (err))
+
+// รหัสข้อผิดพลาดแรก (ค่าน้อยสุด) ใน mask หรือ ARITH_OK ถ้า mask == 0
+static inline arith_err_t arith_errmask_first(arith_errmask_t mask) {
+    return mask ? (arith_err_t)__builtin_ctz(mask) : ARITH_OK;
+}
+
+// 🚩 ตรวจค่า double หนึ่งค่าโดยดูบิต exponent ตรงๆ (ไม่แตกแขนง)
+// NaN → ARITH_ERR_INVALID_INPUT, ±inf → ARITH_ERR_OVERFLOW, ค่าปกติ → 0
+static inline arith_errmask_t arith_value_mask(double v) {
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    uint32_t special = ((bits >> 52) & 0x7FF) == 0x7FF;
+    uint32_t has_mantissa = (bits & 0xFFFFFFFFFFFFFull) != 0;
+    return ((special & has_mantissa) << ARITH_ERR_INVALID_INPUT) |
+           ((special & (has_mantissa ^ 1)) << ARITH_ERR_OVERFLOW);
+}
+
+// 🔢 จำนวนเต็ม int: ล้น → ARITH_ERR_OVERFLOW (ตรวจด้วย compiler builtin)
+arith_errmask_t arith_add_int_batch(const int *a, const int *b, int *out, size_t n);
+arith_errmask_t arith_sub_int_batch(const int *a, const int *b, int *out, size_t n);
+arith_errmask_t arith_mul_int_batch(const int *a, const int *b, int *out, size_t n);
+
+// ➕ double: ผลเป็น inf → ARITH_ERR_OVERFLOW, NaN → ARITH_ERR_INVALID_INPUT
+// หาร: ตัวหารเป็น 0 → ARITH_ERR_DIV_BY_ZERO (พร้อมบิตของ inf/NaN ที่ได้)
+arith_errmask_t arith_add_batch(const double *a, const double *b, double *out, size_t n);
+arith_errmask_t arith_sub_batch(const double *a, const double *b, double *out, size_t n);
+arith_errmask_t arith_mul_batch(const double *a, const double *b, double *out, size_t n);
+arith_errmask_t arith_div_batch(const double *a, const double *b, double *out, size_t n);
+
+// Σ a[i] ผลรวมเก็บใน *out
+arith_errmask_t arith_sum_batch(const double *a, size_t n, double *out);
+
+// 🔢 ยกกำลังทั้งชุดด้วยเลขชี้กำลังเดียวกัน (เช่น ทบต้น N งวด หลายยอดเงิน)
+// เลือกวิธีคำนวณครั้งเดียวต่อชุด: 0-3 และ 0.5 คูณ/ถอดรากตรงๆ, จำนวนเต็มใช้ arith_powi, ที่เหลือ pow()
+// 0 ยกกำลังลบ → ARITH_ERR_DIV_BY_ZERO
+arith_errmask_t arith_power_batch(const double *bases, double exponent, double *out, size_t n);
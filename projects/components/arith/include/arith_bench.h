@@ -0,0 +1,8 @@
+#pragma once
+
+#include <stdio.h>
+
+// ⏱️ ชุด benchmark ของทุกเคอร์เนลใน arith (safe_*, เรขาคณิต, การเงิน)
+// ใช้ได้ทั้งบน ESP32 (เปิด CONFIG_ARITH_BENCH) และบน host (arith/bench)
+// พิมพ์ผลเป็น CSV หน่วย cycle ต่อการเรียก 1 ครั้ง
+void arith_bench_run_all(FILE *out);
@@ -0,0 +1,126 @@
+#include "bench.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(ESP_PLATFORM)
+#include "sdkconfig.h"
+#endif
+
+#if defined(ESP_PLATFORM) && !CONFIG_IDF_TARGET_LINUX
+#include "esp_cpu.h"
+#define BENCH_UNIT "cycles"
+uint64_t bench_now(void) {
+    return esp_cpu_get_cycle_count();
+}
+
+// CCOUNT กว้าง 32 บิต (วนรอบทุก ~18 วินาทีที่ 240 MHz) ลบกันแบบ 32 บิตจึงได้ช่วงที่ถูกแม้ข้ามรอบ
+uint64_t bench_elapsed(uint64_t t0, uint64_t t1) {
+    return (uint32_t)((uint32_t)t1 - (uint32_t)t0);
+}
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "cycles"
+uint64_t bench_now(void) {
+    return __rdtsc();
+}
+#else
+#include <time.h>
+#define BENCH_UNIT "ns"
+uint64_t bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+#if !defined(ESP_PLATFORM) || CONFIG_IDF_TARGET_LINUX
+uint64_t bench_elapsed(uint64_t t0, uint64_t t1) {
+    return t1 - t0;
+}
+#endif
+
+// overhead ต่อรอบของตัววัด (หน่วยเดียวกับ bench_now)
+static double overhead_per_rep;
+
+const char *bench_unit(void) {
+    return BENCH_UNIT;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// 🔁 วัดดิบ: คืนจำนวน sample ที่เก็บได้ (เรียงจากน้อยไปมาก)
+static uint32_t collect(const bench_case_t *c, const bench_config_t *cfg, uint64_t *samples) {
+    uint32_t reps = cfg->reps < BENCH_MAX_REPS ? cfg->reps : BENCH_MAX_REPS;
+
+    for (uint32_t i = 0; i < cfg->warmup_reps; i++) {
+        c->fn(c->ctx, cfg->inner_iters);
+    }
+    for (uint32_t i = 0; i < reps; i++) {
+        uint64_t t0 = bench_now();
+        c->fn(c->ctx, cfg->inner_iters);
+        uint64_t t1 = bench_now();
+        samples[i] = bench_elapsed(t0, t1);
+    }
+    qsort(samples, reps, sizeof(samples[0]), compare_u64);
+    return reps;
+}
+
+static void empty_kernel(void *ctx, uint32_t iters) {
+    (void)ctx;
+    (void)iters;
+}
+
+void bench_calibrate(const bench_config_t *cfg) {
+    uint64_t samples[BENCH_MAX_REPS];
+    bench_case_t empty = { .name = "empty", .fn = empty_kernel, .ctx = NULL };
+    overhead_per_rep = 0;
+    uint32_t n = collect(&empty, cfg, samples);
+    overhead_per_rep = (double)samples[n / 2];
+}
+
+void bench_run(const bench_case_t *c, const bench_config_t *cfg, bench_result_t *out) {
+    uint64_t samples[BENCH_MAX_REPS];
+    uint32_t n = collect(c, cfg, samples);
+    double per_call = 1.0 / (cfg->inner_iters ? cfg->inner_iters : 1);
+
+    // ตัดค่าสุดโต่งออกข้างละ trim_percent %
+    uint32_t trim = (uint32_t)((uint64_t)n * cfg->trim_percent / 100);
+    if (2 * trim >= n) {
+        trim = (n - 1) / 2;
+    }
+    uint32_t lo = trim, hi = n - trim;
+
+    double sum = 0;
+    for (uint32_t i = lo; i < hi; i++) {
+        sum += (double)samples[i] - overhead_per_rep;
+    }
+    double mean = sum / (hi - lo);
+    double var = 0;
+    for (uint32_t i = lo; i < hi; i++) {
+        double d = (double)samples[i] - overhead_per_rep - mean;
+        var += d * d;
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->name = c->name;
+    out->reps = n;
+    out->min = ((double)samples[0] - overhead_per_rep) * per_call;
+    out->median = ((double)samples[n / 2] - overhead_per_rep) * per_call;
+    out->trimmed_mean = mean * per_call;
+    out->max = ((double)samples[n - 1] - overhead_per_rep) * per_call;
+    out->stddev = sqrt(var / (hi - lo)) * per_call;
+}
+
+void bench_print_csv_header(FILE *f) {
+    fprintf(f, "kernel,unit,reps,min,median,trimmed_mean,max,stddev\n");
+}
+
+void bench_print_csv(FILE *f, const bench_result_t *r) {
+    fprintf(f, "%s,%s,%lu,%.2f,%.2f,%.2f,%.2f,%.2f\n", r->name, bench_unit(),
+            (unsigned long)r->reps, r->min, r->median, r->trimmed_mean, r->max, r->stddev);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+// ⏱️ bench: ตัววัดเวลาแบบนับรอบ CPU สำหรับเคอร์เนลเล็กๆ (ไม่กี่ร้อย cycle)
+// - บน ESP32: ใช้ CPU cycle counter (CCOUNT)
+// - บน host x86: ใช้ rdtsc, สถาปัตยกรรมอื่นใช้ clock_gettime (หน่วย ns)
+// ขั้นตอน: warm-up → วัดซ้ำหลายรอบ → ตัดค่าสุดโต่งออก → สรุปเป็น CSV
+
+#define BENCH_MAX_REPS 101
+
+// ฟังก์ชันที่ถูกวัด: ทำงาน iters ครั้งต่อการเรียกหนึ่งครั้ง
+typedef void (*bench_fn_t)(void *ctx, uint32_t iters);
+
+typedef struct {
+    const char *name;
+    bench_fn_t fn;
+    void *ctx;
+} bench_case_t;
+
+typedef struct {
+    uint32_t warmup_reps;   // รอบอุ่นเครื่อง (ไม่นับ)
+    uint32_t reps;          // รอบที่วัดจริง (≤ BENCH_MAX_REPS)
+    uint32_t inner_iters;   // จำนวนครั้งที่เรียกเคอร์เนลต่อรอบ
+    uint8_t trim_percent;   // ตัดค่าต่ำ/สูงสุดออกข้างละกี่ %
+} bench_config_t;
+
+#define BENCH_CONFIG_DEFAULT { .warmup_reps = 5, .reps = 51, .inner_iters = 256, .trim_percent = 10 }
+
+// ผลลัพธ์ต่อการเรียกเคอร์เนล 1 ครั้ง (หน่วยตาม bench_unit())
+typedef struct {
+    const char *name;
+    uint32_t reps;
+    double min;
+    double median;
+    double trimmed_mean;
+    double max;
+    double stddev;          // ของชุดที่ตัดแล้ว
+} bench_result_t;
+
+// ค่านับปัจจุบัน และชื่อหน่วย ("cycles" หรือ "ns")
+// บน ESP32 ค่านับเป็น CCOUNT 32 บิตที่วนรอบได้ — หาช่วงเวลาด้วย bench_elapsed เสมอ ห้ามลบตรงๆ
+uint64_t bench_now(void);
+uint64_t bench_elapsed(uint64_t t0, uint64_t t1);
+const char *bench_unit(void);
+
+// วัด loop เปล่าเพื่อหักค่า overhead ของตัววัดเอง (เรียกครั้งเดียวก่อน bench_run)
+void bench_calibrate(const bench_config_t *cfg);
+
+void bench_run(const bench_case_t *c, const bench_config_t *cfg, bench_result_t *out);
+
+void bench_print_csv_header(FILE *f);
+void bench_print_csv(FILE *f, const bench_result_t *r);
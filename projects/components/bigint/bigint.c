@@ -0,0 +1,414 @@
+#include "bigint.h"
+
+#include <math.h>
+#include <string.h>
+
+#define LIMB_BITS 32
+#define DECIMAL_CHUNK 1000000000u      // 10⁹ ใส่ limb เดียวได้
+#define DECIMAL_CHUNK_DIGITS 9
+#define FACTORIAL_LEAF 16               // ผลคูณเลขคี่ช่วงสั้นกว่านี้คูณทีละตัว
+
+// ---------------------------------------------------------------------------
+// 🧱 arena
+// ---------------------------------------------------------------------------
+void bigint_arena_init(bigint_arena_t *arena, void *buf, size_t size) {
+    arena->base = buf;
+    arena->size = buf ? size : 0;
+    arena->used = 0;
+    arena->peak = 0;
+}
+
+void *bigint_arena_alloc(bigint_arena_t *arena, size_t bytes) {
+    size_t start = (arena->used + sizeof(bigint_limb_t) - 1) & ~(sizeof(bigint_limb_t) - 1);
+    if (start > arena->size || bytes > arena->size - start) {
+        return NULL;
+    }
+    arena->used = start + bytes;
+    if (arena->used > arena->peak) {
+        arena->peak = arena->used;
+    }
+    return arena->base + start;
+}
+
+static inline bigint_limb_t *arena_alloc(bigint_arena_t *arena, size_t limbs) {
+    return bigint_arena_alloc(arena, limbs * sizeof(bigint_limb_t));
+}
+
+// ค่าที่อยู่บนสุดของ arena หรือไม่ (ขยายต่อได้)
+static bool arena_top(const bigint_arena_t *arena, const bigint_t *a) {
+    return (uint8_t *)(a->limb + a->len) == arena->base + arena->used;
+}
+
+// ย้ายค่า (ที่อยู่สูงกว่า) ลงมาที่ตำแหน่ง mark แล้วปล่อยทุกอย่างที่อยู่เหนือมัน
+static void arena_compact(bigint_arena_t *arena, size_t mark, bigint_t *v) {
+    mark = (mark + sizeof(bigint_limb_t) - 1) & ~(sizeof(bigint_limb_t) - 1);
+    bigint_limb_t *dst = (bigint_limb_t *)(arena->base + mark);
+    memmove(dst, v->limb, v->len * sizeof(bigint_limb_t));
+    v->limb = dst;
+    arena->used = mark + v->len * sizeof(bigint_limb_t);
+}
+
+static size_t normalize(const bigint_limb_t *a, size_t n) {
+    while (n > 0 && a[n - 1] == 0) {
+        n--;
+    }
+    return n;
+}
+
+// ---------------------------------------------------------------------------
+// ➕ ตัวช่วยระดับ limb (ทุกอาร์เรย์เรียงจากหลักต่ำ)
+// ---------------------------------------------------------------------------
+
+// r[0..na] = a + b (na ≥ nb) คืน carry สุดท้าย
+static bigint_limb_t add_n(bigint_limb_t *r, const bigint_limb_t *a, size_t na,
+                           const bigint_limb_t *b, size_t nb) {
+    uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < nb; i++) {
+        carry += (uint64_t)a[i] + b[i];
+        r[i] = (bigint_limb_t)carry;
+        carry >>= LIMB_BITS;
+    }
+    for (; i < na; i++) {
+        carry += a[i];
+        r[i] = (bigint_limb_t)carry;
+        carry >>= LIMB_BITS;
+    }
+    return (bigint_limb_t)carry;
+}
+
+// r[0..nr) += s[0..ns) (ns ≤ nr, ผู้เรียกรับประกันว่าไม่ล้น nr)
+static void add_into(bigint_limb_t *r, size_t nr, const bigint_limb_t *s, size_t ns) {
+    uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < ns; i++) {
+        carry += (uint64_t)r[i] + s[i];
+        r[i] = (bigint_limb_t)carry;
+        carry >>= LIMB_BITS;
+    }
+    for (; carry && i < nr; i++) {
+        carry += r[i];
+        r[i] = (bigint_limb_t)carry;
+        carry >>= LIMB_BITS;
+    }
+}
+
+// r[0..nr) -= s[0..ns) (r ≥ s)
+static void sub_into(bigint_limb_t *r, size_t nr, const bigint_limb_t *s, size_t ns) {
+    int64_t borrow = 0;
+    size_t i = 0;
+    for (; i < ns; i++) {
+        int64_t d = (int64_t)r[i] - s[i] - borrow;
+        borrow = d < 0;
+        r[i] = (bigint_limb_t)d;
+    }
+    for (; borrow && i < nr; i++) {
+        borrow = r[i] == 0;
+        r[i]--;
+    }
+}
+
+// out[0..na+nb) = a × b แบบตั้งหลัก
+static void mul_schoolbook(const bigint_limb_t *a, size_t na, const bigint_limb_t *b, size_t nb,
+                           bigint_limb_t *out) {
+    memset(out, 0, (na + nb) * sizeof(bigint_limb_t));
+    for (size_t i = 0; i < na; i++) {
+        uint64_t carry = 0;
+        uint64_t ai = a[i];
+        if (ai == 0) {
+            continue;
+        }
+        for (size_t j = 0; j < nb; j++) {
+            carry += ai * b[j] + out[i + j];
+            out[i + j] = (bigint_limb_t)carry;
+            carry >>= LIMB_BITS;
+        }
+        out[i + nb] = (bigint_limb_t)carry;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// ✖️ Karatsuba: a·b = z2·B²ᵐ + (z1 − z2 − z0)·Bᵐ + z0 เมื่อ z1 = (a0+a1)(b0+b1)
+// ---------------------------------------------------------------------------
+static bool mul_rec(bigint_arena_t *arena, const bigint_limb_t *a, size_t na,
+                    const bigint_limb_t *b, size_t nb, bigint_limb_t *out) {
+    if (na < nb) {
+        const bigint_limb_t *t = a; a = b; b = t;
+        size_t tn = na; na = nb; nb = tn;
+    }
+    if (nb < BIGINT_KARATSUBA_CUTOFF) {
+        mul_schoolbook(a, na, b, nb, out);
+        return true;
+    }
+
+    size_t m = (na + 1) / 2;
+    size_t mark = bigint_arena_mark(arena);
+    bool ok = false;
+
+    if (nb <= m) {
+        // ขนาดต่างกันมาก: ตัด a เป็นสองท่อนแล้วคูณกับ b ทั้งตัว
+        size_t nt = na - m + nb;
+        bigint_limb_t *t = arena_alloc(arena, nt);
+        if (t && mul_rec(arena, a, m, b, nb, out) && mul_rec(arena, a + m, na - m, b, nb, t)) {
+            memset(out + m + nb, 0, (na - m) * sizeof(bigint_limb_t));
+            add_into(out + m, na + nb - m, t, nt);
+            ok = true;
+        }
+        bigint_arena_release(arena, mark);
+        return ok;
+    }
+
+    // z0 → out[0..2m), z2 → out[2m..na+nb)
+    const bigint_limb_t *a0 = a, *a1 = a + m, *b0 = b, *b1 = b + m;
+    size_t na1 = na - m, nb1 = nb - m;
+    bigint_limb_t *sa = arena_alloc(arena, m + 1);
+    bigint_limb_t *sb = arena_alloc(arena, m + 1);
+    bigint_limb_t *z1 = arena_alloc(arena, 2 * m + 2);
+    if (sa && sb && z1 &&
+        mul_rec(arena, a0, m, b0, m, out) &&
+        mul_rec(arena, a1, na1, b1, nb1, out + 2 * m)) {
+        sa[m] = add_n(sa, a0, m, a1, na1);
+        sb[m] = add_n(sb, b0, m, b1, nb1);
+        if (mul_rec(arena, sa, m + 1, sb, m + 1, z1)) {
+            sub_into(z1, 2 * m + 2, out, 2 * m);
+            sub_into(z1, 2 * m + 2, out + 2 * m, na1 + nb1);
+            add_into(out + m, na + nb - m, z1, normalize(z1, 2 * m + 2));
+            ok = true;
+        }
+    }
+    bigint_arena_release(arena, mark);
+    return ok;
+}
+
+arith_err_t bigint_from_u64(bigint_arena_t *arena, uint64_t value, bigint_t *out) {
+    out->limb = arena_alloc(arena, 2);
+    if (out->limb == NULL) {
+        return ARITH_ERR_OVERFLOW;
+    }
+    out->limb[0] = (bigint_limb_t)value;
+    out->limb[1] = (bigint_limb_t)(value >> LIMB_BITS);
+    out->len = normalize(out->limb, 2);
+    arena->used = (size_t)((uint8_t *)(out->limb + out->len) - arena->base);
+    return ARITH_OK;
+}
+
+arith_err_t bigint_mul(bigint_arena_t *arena, const bigint_t *a, const bigint_t *b, bigint_t *out) {
+    size_t mark = bigint_arena_mark(arena);
+    size_t n = a->len + b->len;
+    bigint_limb_t *r = arena_alloc(arena, n);
+
+    if (r == NULL || (n > 0 && !mul_rec(arena, a->limb, a->len, b->limb, b->len, r))) {
+        bigint_arena_release(arena, mark);
+        return ARITH_ERR_OVERFLOW;
+    }
+    // ตัด limb ศูนย์นำหน้าออกแล้วคืนพื้นที่ส่วนที่ไม่ได้ใช้
+    out->limb = r;
+    out->len = normalize(r, n);
+    arena->used = (size_t)((uint8_t *)(r + out->len) - arena->base);
+    return ARITH_OK;
+}
+
+arith_err_t bigint_mul_small(bigint_arena_t *arena, bigint_t *a, uint32_t m) {
+    if (!arena_top(arena, a)) {
+        return ARITH_ERR_INVALID_INPUT;
+    }
+    uint64_t carry = 0;
+    for (size_t i = 0; i < a->len; i++) {
+        carry += (uint64_t)a->limb[i] * m;
+        a->limb[i] = (bigint_limb_t)carry;
+        carry >>= LIMB_BITS;
+    }
+    if (carry) {
+        if (arena_alloc(arena, 1) == NULL) {
+            return ARITH_ERR_OVERFLOW;
+        }
+        a->limb[a->len++] = (bigint_limb_t)carry;
+    }
+    if (m == 0) {
+        a->len = 0;
+    }
+    return ARITH_OK;
+}
+
+// ---------------------------------------------------------------------------
+// ❗ แฟกทอเรียล: n! = 2^(n − popcount n) · ∏ O(n >> i)
+// O(x) = ผลคูณเลขคี่ ≤ x คำนวณสะสมจาก i ใหญ่ไปเล็ก: p = O(n >> i), r = ∏ p
+// แต่ละรอบเพิ่มเฉพาะเลขคี่ในช่วง (n >> (i+1), n >> i] เข้า p ด้วย binary splitting
+// ---------------------------------------------------------------------------
+typedef struct {
+    bigint_arena_t *arena;
+    uint32_t next;              // เลขคี่ตัวถัดไปที่จะคูณ
+} odd_product_t;
+
+// ผลคูณของเลขคี่ len ตัวถัดไป เก็บไว้บนสุดของ arena
+static arith_err_t odd_product(odd_product_t *ctx, uint32_t len, bigint_t *out) {
+    arith_err_t err;
+
+    if (len <= FACTORIAL_LEAF) {
+        if ((err = bigint_from_u64(ctx->arena, 1, out)) != ARITH_OK) {
+            return err;
+        }
+        for (uint32_t i = 0; i < len; i++) {
+            if ((err = bigint_mul_small(ctx->arena, out, ctx->next)) != ARITH_OK) {
+                return err;
+            }
+            ctx->next += 2;
+        }
+        return ARITH_OK;
+    }
+
+    size_t mark = bigint_arena_mark(ctx->arena);
+    bigint_t left, right;
+    if ((err = odd_product(ctx, len - len / 2, &left)) != ARITH_OK ||
+        (err = odd_product(ctx, len / 2, &right)) != ARITH_OK ||
+        (err = bigint_mul(ctx->arena, &left, &right, out)) != ARITH_OK) {
+        bigint_arena_release(ctx->arena, mark);
+        return err;
+    }
+    arena_compact(ctx->arena, mark, out);
+    return ARITH_OK;
+}
+
+arith_err_t bigint_factorial(bigint_arena_t *arena, int n, bigint_t *out) {
+    if (n < 0) {
+        return ARITH_ERR_NEGATIVE;
+    }
+
+    size_t mark = bigint_arena_mark(arena);
+    odd_product_t ctx = { .arena = arena };
+    bigint_t r, p, q, t, u;
+    arith_err_t err;
+    int top = 0;
+    while (top < 31 && ((uint32_t)n >> (top + 1)) != 0) {
+        top++;
+    }
+
+    if ((err = bigint_from_u64(arena, 1, &r)) != ARITH_OK ||
+        (err = bigint_from_u64(arena, 1, &p)) != ARITH_OK) {
+        goto fail;
+    }
+    // arena: [r][p] ทุกสิ้นรอบ
+    for (int i = top; i >= 0; i--) {
+        uint32_t lo = (uint32_t)n >> (i + 1);
+        uint32_t hi = (uint32_t)n >> i;
+        uint32_t count = (hi + 1) / 2 - (lo + 1) / 2;      // จำนวนเลขคี่ใน (lo, hi] (0 ได้ → q = 1)
+        ctx.next = 2 * ((lo + 1) / 2) + 1;
+        // [r][p][q][t = p·q][u = r·t]
+        if ((err = odd_product(&ctx, count, &q)) != ARITH_OK ||
+            (err = bigint_mul(arena, &p, &q, &t)) != ARITH_OK ||
+            (err = bigint_mul(arena, &r, &t, &u)) != ARITH_OK) {
+            goto fail;
+        }
+        // ย้าย u ลงที่ของ r แล้ว t ต่อท้าย (u ยาว ≤ r+p+q จึงไม่ทับ t ระหว่างย้าย)
+        arena_compact(arena, mark, &u);
+        arena_compact(arena, bigint_arena_mark(arena), &t);
+        r = u;
+        p = t;
+    }
+
+    // คูณ 2^(n − popcount n) ด้วยการเลื่อนบิต (ทิ้ง p)
+    uint32_t shift = (uint32_t)n - (uint32_t)__builtin_popcount((unsigned)n);
+    size_t limbs = shift / LIMB_BITS, bits = shift % LIMB_BITS;
+    arena->used = (size_t)((uint8_t *)(r.limb + r.len) - arena->base);
+    bigint_limb_t *dst = arena_alloc(arena, r.len + limbs + 1);
+    if (dst == NULL) {
+        err = ARITH_ERR_OVERFLOW;
+        goto fail;
+    }
+    bigint_limb_t carry = 0;
+    for (size_t i = 0; i < r.len; i++) {
+        dst[limbs + i] = bits ? (r.limb[i] << bits) | carry : r.limb[i];
+        carry = bits ? r.limb[i] >> (LIMB_BITS - bits) : 0;
+    }
+    dst[limbs + r.len] = carry;
+    memset(dst, 0, limbs * sizeof(bigint_limb_t));
+    out->limb = dst;
+    out->len = normalize(dst, r.len + limbs + 1);
+    arena_compact(arena, mark, out);
+    return ARITH_OK;
+
+fail:
+    bigint_arena_release(arena, mark);
+    return err;
+}
+
+// ---------------------------------------------------------------------------
+// 🔟 แปลงเป็นข้อความ/ทศนิยม
+// ---------------------------------------------------------------------------
+
+// a /= d ในที่เดิม คืนเศษ
+static uint32_t div_small(bigint_limb_t *a, size_t *n, uint32_t d) {
+    uint64_t rem = 0;
+    for (size_t i = *n; i-- > 0;) {
+        uint64_t cur = (rem << LIMB_BITS) | a[i];
+        a[i] = (bigint_limb_t)(cur / d);
+        rem = cur % d;
+    }
+    *n = normalize(a, *n);
+    return (uint32_t)rem;
+}
+
+size_t bigint_to_decimal(bigint_arena_t *arena, const bigint_t *a, char *buf, size_t size) {
+    if (size < 2) {
+        return 0;
+    }
+    if (a->len == 0) {
+        buf[0] = '0';
+        buf[1] = '\0';
+        return 1;
+    }
+
+    size_t mark = bigint_arena_mark(arena);
+    size_t n = a->len;
+    size_t max_chunks = bigint_decimal_size(a) / DECIMAL_CHUNK_DIGITS + 1;
+    bigint_limb_t *work = arena_alloc(arena, n);
+    uint32_t *chunks = arena_alloc(arena, max_chunks);
+    if (work == NULL || chunks == NULL) {
+        bigint_arena_release(arena, mark);
+        return 0;
+    }
+    memcpy(work, a->limb, n * sizeof(bigint_limb_t));
+
+    // ได้ก้อนละ 9 หลักจากหลักต่ำไปสูง
+    size_t count = 0;
+    while (n > 0) {
+        chunks[count++] = div_small(work, &n, DECIMAL_CHUNK);
+    }
+
+    // ก้อนบนสุดไม่เติมศูนย์นำหน้า ก้อนอื่นเติมให้ครบ 9 หลัก
+    size_t len = 0;
+    uint32_t head = chunks[count - 1];
+    char tmp[DECIMAL_CHUNK_DIGITS];
+    size_t head_len = 0;
+    do {
+        tmp[head_len++] = (char)('0' + head % 10);
+        head /= 10;
+    } while (head);
+    if (head_len + (count - 1) * DECIMAL_CHUNK_DIGITS + 1 > size) {
+        bigint_arena_release(arena, mark);
+        return 0;
+    }
+    while (head_len > 0) {
+        buf[len++] = tmp[--head_len];
+    }
+    for (size_t c = count - 1; c-- > 0;) {
+        uint32_t v = chunks[c];
+        for (int d = DECIMAL_CHUNK_DIGITS - 1; d >= 0; d--) {
+            buf[len + (size_t)d] = (char)('0' + v % 10);
+            v /= 10;
+        }
+        len += DECIMAL_CHUNK_DIGITS;
+    }
+    buf[len] = '\0';
+    bigint_arena_release(arena, mark);
+    return len;
+}
+
+double bigint_to_double(const bigint_t *a) {
+    double v = 0;
+    size_t first = a->len > 3 ? a->len - 3 : 0;    // 96 บิตบนสุดพอสำหรับ mantissa 53 บิต
+    for (size_t i = a->len; i-- > first;) {
+        v = v * 4294967296.0 + a->limb[i];
+    }
+    return ldexp(v, (int)(first * LIMB_BITS));
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "arith.h"
+
+// 🔢 bigint: จำนวนเต็มไม่ติดลบขนาดไม่จำกัด (limb ละ 32 บิต เรียงจากหลักต่ำไปสูง)
+// limb ทั้งหมดจองจาก arena ที่ผู้เรียกให้มา (บัฟเฟอร์ก้อนเดียว ไม่มี malloc ระหว่างคำนวณ)
+// หน่วยความจำจึงมีเพดานแน่นอน: ถ้า arena ไม่พอ ฟังก์ชันคืน ARITH_ERR_OVERFLOW และ arena กลับสู่จุดเดิม
+//
+// arena ทำงานแบบ stack: ค่าที่คำนวณทีหลังอยู่บนค่าก่อนหน้า ใช้ bigint_arena_mark/release
+// คืนพื้นที่ชั่วคราวทั้งก้อน ค่าที่ได้จากฟังก์ชันใช้ได้จนกว่าจะ release ลงต่ำกว่าตำแหน่งของมัน
+
+typedef uint32_t bigint_limb_t;
+
+typedef struct {
+    uint8_t *base;
+    size_t size;
+    size_t used;
+    size_t peak;                // ใช้สูงสุดเท่าไร (ไว้เลือกขนาด arena)
+} bigint_arena_t;
+
+typedef struct {
+    bigint_limb_t *limb;
+    size_t len;                 // ไม่มี limb ศูนย์นำหน้า (ค่า 0 มี len = 0)
+} bigint_t;
+
+// ขนาดที่เริ่มใช้ Karatsuba แทนการคูณแบบตั้งหลัก (จำนวน limb ของตัวที่สั้นกว่า)
+#ifndef BIGINT_KARATSUBA_CUTOFF
+#define BIGINT_KARATSUBA_CUTOFF 24
+#endif
+
+void bigint_arena_init(bigint_arena_t *arena, void *buf, size_t size);
+
+static inline size_t bigint_arena_mark(const bigint_arena_t *arena) {
+    return arena->used;
+}
+
+static inline void bigint_arena_release(bigint_arena_t *arena, size_t mark) {
+    arena->used = mark;
+}
+
+// จองพื้นที่ดิบ (เช่น บัฟเฟอร์ข้อความของ bigint_to_decimal) คืน NULL ถ้าไม่พอ
+void *bigint_arena_alloc(bigint_arena_t *arena, size_t bytes);
+
+// 🏗️ สร้างค่า
+arith_err_t bigint_from_u64(bigint_arena_t *arena, uint64_t value, bigint_t *out);
+
+// ✖️ out = a × b (เลือกตั้งหลักหรือ Karatsuba ตามขนาด) ชั่วคราวของ Karatsuba คืน arena ก่อนกลับ
+arith_err_t bigint_mul(bigint_arena_t *arena, const bigint_t *a, const bigint_t *b, bigint_t *out);
+
+// ✖️ a ×= m ในที่เดิม (a ต้องมีที่ว่างต่อท้ายอีก 1 limb — ใช้กับค่าบนสุดของ arena)
+arith_err_t bigint_mul_small(bigint_arena_t *arena, bigint_t *a, uint32_t m);
+
+// ❗ n! แบบตรงทุกหลัก: แยกกำลังของ 2 ออก แล้วคูณส่วนคี่แบบ binary splitting (split-recursive)
+// ใช้การคูณใหญ่×ใหญ่ที่ขนาดใกล้กัน จึงได้ประโยชน์จาก Karatsuba เต็มที่
+// n < 0 → ARITH_ERR_NEGATIVE, arena ไม่พอ → ARITH_ERR_OVERFLOW
+arith_err_t bigint_factorial(bigint_arena_t *arena, int n, bigint_t *out);
+
+// 🔟 จำนวนหลักฐานสิบสูงสุดที่เป็นไปได้ (สำหรับจองบัฟเฟอร์ ไม่รวม '\0')
+static inline size_t bigint_decimal_size(const bigint_t *a) {
+    return a->len * 10 + 1;     // 32·log10(2) ≈ 9.63 หลักต่อ limb
+}
+
+// 🔟 เขียนเป็นเลขฐานสิบลง buf (หาร 10⁹ ซ้ำบนสำเนาใน arena) คืนความยาว หรือ 0 ถ้า buf/arena ไม่พอ
+size_t bigint_to_decimal(bigint_arena_t *arena, const bigint_t *a, char *buf, size_t size);
+
+// ≈ ค่าเป็น double (inf ถ้าเกินช่วง)
+double bigint_to_double(const bigint_t *a);
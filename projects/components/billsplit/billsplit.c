@@ -0,0 +1,100 @@
+#include "billsplit.h"
+
+#include <string.h>
+
+billsplit_err_t billsplit_plan_init(billsplit_plan_t *plan, uint32_t payers, const uint16_t *weights) {
+    memset(plan, 0, sizeof(*plan));
+    if (payers == 0 || payers > BILLSPLIT_MAX_PAYERS) {
+        return BILLSPLIT_ERR_NO_PAYERS;
+    }
+    plan->payers = payers;
+
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < payers; i++) {
+        plan->weights[i] = weights ? weights[i] : 1;
+        sum += plan->weights[i];
+        if (weights && weights[i] != weights[0]) {
+            plan->weighted = true;
+        }
+    }
+    if (sum == 0 || sum > BILLSPLIT_MAX_WEIGHT_SUM) {
+        return BILLSPLIT_ERR_BAD_WEIGHTS;
+    }
+    plan->weight_sum = sum;
+
+    // น้ำหนักเท่ากันทุกคน = หารเท่ากัน ใช้ทางลัดที่หารด้วยจำนวนคนแทน
+    fastdiv_u32_init(&plan->weight_div, plan->weighted ? sum : payers);
+    return BILLSPLIT_OK;
+}
+
+// ➗ หารเท่ากัน: เศษ r สตางค์ให้ r คนแรก คนละ 1 สตางค์
+static void split_equal(const billsplit_plan_t *plan, uint32_t total, uint32_t *shares) {
+    fastdiv_qr_t qr = fastdiv_u32_divmod(&plan->weight_div, total);
+    for (uint32_t i = 0; i < plan->payers; i++) {
+        shares[i] = qr.quotient + (i < qr.remainder ? 1 : 0);
+    }
+}
+
+// ⚖️ หารตามน้ำหนัก: total × w / W แยกเป็น (qT × w) + (rT × w) / W
+// เพื่อให้ทุกการคูณอยู่ใน 32 บิต และใช้ตัวหาร W ตัวเดิมตลอด
+static void split_weighted(const billsplit_plan_t *plan, uint32_t total, uint32_t *shares) {
+    const uint32_t n = plan->payers;
+    uint32_t frac[BILLSPLIT_MAX_PAYERS];
+    uint8_t order[BILLSPLIT_MAX_PAYERS];
+
+    fastdiv_qr_t whole = fastdiv_u32_divmod(&plan->weight_div, total);
+    uint32_t assigned = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t w = plan->weights[i];
+        fastdiv_qr_t part = fastdiv_u32_divmod(&plan->weight_div, whole.remainder * w);
+        shares[i] = whole.quotient * w + part.quotient;
+        frac[i] = part.remainder;
+        assigned += shares[i];
+    }
+
+    uint32_t leftover = total - assigned;   // < จำนวนคนเสมอ
+    if (leftover == 0) {
+        return;
+    }
+
+    // เรียงลำดับ (เศษมากก่อน, index น้อยก่อน) ด้วย insertion sort (n ≤ 32)
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t j = i;
+        while (j > 0 && frac[order[j - 1]] < frac[i]) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = (uint8_t)i;
+    }
+    for (uint32_t k = 0; k < leftover; k++) {
+        shares[order[k]]++;
+    }
+}
+
+void billsplit_split(const billsplit_plan_t *plan, uint32_t total_satang, uint32_t *shares) {
+    if (plan->weighted) {
+        split_weighted(plan, total_satang, shares);
+    } else {
+        split_equal(plan, total_satang, shares);
+    }
+}
+
+void billsplit_split_batch(const billsplit_plan_t *plan, const uint32_t *totals_satang,
+                           size_t bills, uint32_t *shares) {
+    const uint32_t n = plan->payers;
+    if (plan->weighted) {
+        for (size_t b = 0; b < bills; b++) {
+            split_weighted(plan, totals_satang[b], shares + b * n);
+        }
+        return;
+    }
+
+    // หารเท่ากัน: ทำผลหาร/เศษของทุกบิลใน loop เดียว แล้วค่อยกระจาย
+    for (size_t b = 0; b < bills; b++) {
+        fastdiv_qr_t qr = fastdiv_u32_divmod(&plan->weight_div, totals_satang[b]);
+        uint32_t *row = shares + b * n;
+        for (uint32_t i = 0; i < n; i++) {
+            row[i] = qr.quotient + (i < qr.remainder ? 1 : 0);
+        }
+    }
+}
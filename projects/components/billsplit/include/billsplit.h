@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "fastdiv.h"
+
+// 🧾 billsplit: แบ่งบิลเป็นหน่วยสตางค์ (จำนวนเต็ม) ให้ผู้จ่าย N คน
+// รับประกันว่าผลรวมของทุกส่วนเท่ากับยอดบิลพอดี
+// เศษที่เหลือแจกแบบ largest remainder: เศษมากได้ก่อน ถ้าเท่ากันคนลำดับต้นได้ก่อน
+
+#define BILLSPLIT_MAX_PAYERS 32
+#define BILLSPLIT_MAX_WEIGHT_SUM 0xFFFFu   // ให้ (เศษ × น้ำหนัก) อยู่ใน 32 บิตเสมอ
+
+typedef enum {
+    BILLSPLIT_OK = 0,
+    BILLSPLIT_ERR_NO_PAYERS,        // จำนวนผู้จ่ายเป็น 0 หรือเกิน BILLSPLIT_MAX_PAYERS
+    BILLSPLIT_ERR_BAD_WEIGHTS,      // น้ำหนักรวมเป็น 0 หรือเกิน BILLSPLIT_MAX_WEIGHT_SUM
+} billsplit_err_t;
+
+// 📐 แผนการแบ่ง: เตรียมครั้งเดียว ใช้กับบิลได้ไม่จำกัด
+typedef struct {
+    uint32_t payers;
+    uint32_t weight_sum;
+    uint16_t weights[BILLSPLIT_MAX_PAYERS];
+    bool weighted;                  // false = หารเท่ากันทุกคน
+    fastdiv_u32_t weight_div;       // ตัวหาร weight_sum ที่คำนวณส่วนกลับไว้แล้ว
+} billsplit_plan_t;
+
+// เตรียมแผน weights == NULL หมายถึงหารเท่ากัน
+billsplit_err_t billsplit_plan_init(billsplit_plan_t *plan, uint32_t payers, const uint16_t *weights);
+
+// แบ่งบิลเดียว shares ต้องยาวอย่างน้อย plan->payers
+void billsplit_split(const billsplit_plan_t *plan, uint32_t total_satang, uint32_t *shares);
+
+// แบ่งหลายบิลด้วยแผนเดียวกัน
+// shares เรียงเป็นแถว: shares[bill * payers + payer]
+void billsplit_split_batch(const billsplit_plan_t *plan, const uint32_t *totals_satang,
+                           size_t bills, uint32_t *shares);
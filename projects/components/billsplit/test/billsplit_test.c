@@ -0,0 +1,126 @@
+// ✅ ทดสอบ billsplit บนเครื่อง host (ctest) — พิมพ์เฉพาะกรณีที่ผิด คืนค่า 1 ถ้ามีกรณีผิด
+// บิลและน้ำหนักสุ่ม (seed คงที่ ผลซ้ำได้ทุกครั้ง): ผลรวมทุกส่วนต้องเท่ากับยอดบิลพอดี
+// แต่ละส่วนห่างจากสัดส่วนจริงไม่ถึง 1 สตางค์ และแบบ batch ต้องได้ผลเดียวกับทีละบิล
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "billsplit.h"
+
+static int failures;
+
+#define CHECK(cond) do {                                                \
+        if (!(cond)) {                                                  \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);      \
+            failures++;                                                 \
+        }                                                               \
+    } while (0)
+
+// 🎲 xorshift32: สุ่มแบบกำหนดผลได้ ไม่พึ่ง rand() ของแต่ละ libc
+static uint32_t rng_state = 0x2545F491u;
+
+static uint32_t rng_next(void) {
+    uint32_t x = rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return rng_state = x;
+}
+
+static uint32_t rng_below(uint32_t n) {
+    return (uint32_t)(((uint64_t)rng_next() * n) >> 32);
+}
+
+// บิลสุ่มทั้งค่าเล็ก (ไม่ถึงคนละสตางค์) ค่าทั่วไป และค่าใกล้ UINT32_MAX
+static uint32_t random_bill(void) {
+    switch (rng_below(4)) {
+    case 0:  return rng_below(BILLSPLIT_MAX_PAYERS * 2);
+    case 1:  return rng_below(1000000);
+    case 2:  return UINT32_MAX - rng_below(1000);
+    default: return rng_next();
+    }
+}
+
+static void check_split(const billsplit_plan_t *plan, uint32_t bill, const uint32_t *shares) {
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < plan->payers; i++) {
+        sum += shares[i];
+        // ส่วนที่ได้ ≈ bill × w / W: ต่างจากค่าจริงน้อยกว่า 1 สตางค์ (เทียบแบบคูณไขว้ ไม่ใช้ทศนิยม)
+        uint64_t w = plan->weighted ? plan->weights[i] : 1;
+        uint64_t total_w = plan->weighted ? plan->weight_sum : plan->payers;
+        uint64_t exact_scaled = (uint64_t)bill * w;
+        uint64_t share_scaled = (uint64_t)shares[i] * total_w;
+        uint64_t diff = exact_scaled > share_scaled ? exact_scaled - share_scaled
+                                                    : share_scaled - exact_scaled;
+        CHECK(diff < total_w);
+    }
+    CHECK(sum == bill);
+    if (sum != bill) {
+        printf("     bill=%lu payers=%lu weighted=%d sum=%llu\n", (unsigned long)bill,
+               (unsigned long)plan->payers, plan->weighted, (unsigned long long)sum);
+    }
+}
+
+static void test_plan_errors(void) {
+    billsplit_plan_t plan;
+    uint16_t zero[3] = {0, 0, 0};
+    uint16_t heavy[2] = {0xFFFF, 1};
+    CHECK(billsplit_plan_init(&plan, 0, NULL) == BILLSPLIT_ERR_NO_PAYERS);
+    CHECK(billsplit_plan_init(&plan, BILLSPLIT_MAX_PAYERS + 1, NULL) == BILLSPLIT_ERR_NO_PAYERS);
+    CHECK(billsplit_plan_init(&plan, 3, zero) == BILLSPLIT_ERR_BAD_WEIGHTS);
+    CHECK(billsplit_plan_init(&plan, 2, heavy) == BILLSPLIT_ERR_BAD_WEIGHTS);
+}
+
+static void test_known(void) {
+    billsplit_plan_t plan;
+    uint32_t shares[BILLSPLIT_MAX_PAYERS];
+    uint16_t weights[3] = {2, 1, 1};
+
+    // ตัวอย่างของโปรเจค 05: 280.34 บาท
+    CHECK(billsplit_plan_init(&plan, 3, NULL) == BILLSPLIT_OK);
+    billsplit_split(&plan, 28034, shares);
+    CHECK(shares[0] == 9345 && shares[1] == 9345 && shares[2] == 9344);
+    CHECK(billsplit_plan_init(&plan, 3, weights) == BILLSPLIT_OK);
+    billsplit_split(&plan, 28034, shares);
+    CHECK(shares[0] == 14017 && shares[1] == 7009 && shares[2] == 7008);
+}
+
+static void test_random(void) {
+    enum { PLANS = 2000, BILLS = 16 };
+    uint16_t weights[BILLSPLIT_MAX_PAYERS];
+    uint32_t bills[BILLS];
+    static uint32_t shares[BILLS * BILLSPLIT_MAX_PAYERS];
+    static uint32_t batch[BILLS * BILLSPLIT_MAX_PAYERS];
+
+    for (int p = 0; p < PLANS; p++) {
+        billsplit_plan_t plan;
+        uint32_t payers = 1 + rng_below(BILLSPLIT_MAX_PAYERS);
+        bool weighted = rng_below(2);
+        if (weighted) {
+            // น้ำหนักรวมไม่เกิน BILLSPLIT_MAX_WEIGHT_SUM และมีอย่างน้อยหนึ่งคนที่ไม่เป็น 0
+            uint32_t cap = BILLSPLIT_MAX_WEIGHT_SUM / payers;
+            for (uint32_t i = 0; i < payers; i++) {
+                weights[i] = (uint16_t)rng_below(rng_below(2) ? 10 : cap + 1);
+            }
+            weights[rng_below(payers)] |= 1;
+        }
+        CHECK(billsplit_plan_init(&plan, payers, weighted ? weights : NULL) == BILLSPLIT_OK);
+
+        for (int b = 0; b < BILLS; b++) {
+            bills[b] = random_bill();
+            billsplit_split(&plan, bills[b], &shares[b * payers]);
+            check_split(&plan, bills[b], &shares[b * payers]);
+        }
+        billsplit_split_batch(&plan, bills, BILLS, batch);
+        for (uint32_t i = 0; i < BILLS * payers; i++) {
+            CHECK(batch[i] == shares[i]);
+        }
+    }
+}
+
+int main(void) {
+    test_plan_errors();
+    test_known();
+    test_random();
+    printf("billsplit_test: %s (%d failures)\n", failures ? "FAIL" : "ok", failures);
+    return failures ? 1 : 0;
+}
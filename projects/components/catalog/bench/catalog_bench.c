@@ -0,0 +1,141 @@
+// 🖥️ benchmark ของ catalog บนเครื่อง host — พิมพ์ CSV ออก stdout และสรุปแคตตาล็อกออก stderr
+// เทียบการสแกน 1 ครั้ง: minimal perfect hash (hit/miss) กับค้นแบบทวิภาคบน barcode ที่เรียงแล้ว
+// และแบบเดิมที่ไล่ struct ทีละตัวเทียบ barcode เป็นข้อความ (strcmp) — แบบหลังโตตามจำนวนสินค้า
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "catalog.h"
+
+#define SCANS 1024
+
+extern const catalog_t bench_catalog;
+
+typedef struct {
+    char barcode[20];
+    char name[50];
+    uint32_t price;
+} product_row_t;
+
+static uint64_t hits[SCANS];
+static uint64_t misses[SCANS];
+static uint64_t *sorted;
+static product_row_t *rows;
+static char hit_text[SCANS][20];
+static volatile uint64_t sink;
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void bench_find_hit(void *ctx, uint32_t iters) {
+    const catalog_t *c = ctx;
+    uint64_t acc = 0;
+    for (uint32_t k = 0; k < iters; k++) {
+        int32_t i = catalog_find(c, hits[k % SCANS]);
+        acc += c->price[i];
+    }
+    sink = acc;
+}
+
+static void bench_find_miss(void *ctx, uint32_t iters) {
+    const catalog_t *c = ctx;
+    uint64_t acc = 0;
+    for (uint32_t k = 0; k < iters; k++) {
+        acc += (uint64_t)catalog_find(c, misses[k % SCANS]);
+    }
+    sink = acc;
+}
+
+static void bench_bsearch(void *ctx, uint32_t iters) {
+    const catalog_t *c = ctx;
+    uint64_t acc = 0;
+    for (uint32_t k = 0; k < iters; k++) {
+        const uint64_t *p = bsearch(&hits[k % SCANS], sorted, c->count, sizeof(uint64_t), cmp_u64);
+        acc += (uint64_t)(p - sorted);
+    }
+    sink = acc;
+}
+
+// 🐢 แบบเดิม: อาร์เรย์ของ struct ที่ฝังข้อความ ไล่เทียบ barcode ทีละตัว
+static void bench_linear_strcmp(void *ctx, uint32_t iters) {
+    const catalog_t *c = ctx;
+    uint64_t acc = 0;
+    for (uint32_t k = 0; k < iters; k++) {
+        const char *want = hit_text[k % SCANS];
+        for (uint32_t i = 0; i < c->count; i++) {
+            if (strcmp(rows[i].barcode, want) == 0) {
+                acc += rows[i].price;
+                break;
+            }
+        }
+    }
+    sink = acc;
+}
+
+int main(void) {
+    const catalog_t *c = &bench_catalog;
+    bench_config_t cfg = BENCH_CONFIG_DEFAULT;
+    bench_result_t r;
+    uint32_t x = 2463534242u;   // xorshift32 — ลำดับการสแกนเดิมทุกครั้ง
+
+    // ✅ ตรวจก่อนวัด: ทุก barcode ได้ช่องของตัวเอง barcode ที่ไม่มีในร้านต้องไม่เจอ
+    sorted = malloc(c->count * sizeof(uint64_t));
+    rows = malloc(c->count * sizeof(product_row_t));
+    size_t names_bytes = 0;
+    for (uint32_t i = 0; i < c->count; i++) {
+        if (catalog_find(c, c->barcode[i]) != (int32_t)i) {
+            fprintf(stderr, "catalog_find ผิดที่ช่อง %u\n", (unsigned)i);
+            return 1;
+        }
+        sorted[i] = c->barcode[i];
+        snprintf(rows[i].barcode, sizeof(rows[i].barcode), "%" PRIu64, c->barcode[i]);
+        snprintf(rows[i].name, sizeof(rows[i].name), "%s", catalog_name(c, i));
+        rows[i].price = c->price[i];
+        size_t end = c->name_off[i] + strlen(catalog_name(c, i)) + 1;
+        names_bytes = end > names_bytes ? end : names_bytes;
+    }
+    qsort(sorted, c->count, sizeof(uint64_t), cmp_u64);
+    for (int k = 0; k < SCANS; k++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        hits[k] = c->barcode[x % c->count];
+        snprintf(hit_text[k], sizeof(hit_text[k]), "%" PRIu64, hits[k]);
+        do {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            misses[k] = 8850000000000ull + x;
+        } while (bsearch(&misses[k], sorted, c->count, sizeof(uint64_t), cmp_u64) != NULL);
+        if (catalog_find(c, misses[k]) != CATALOG_NOT_FOUND) {
+            fprintf(stderr, "catalog_find เจอ barcode %" PRIu64 " ที่ไม่มีในร้าน\n", misses[k]);
+            return 1;
+        }
+    }
+    size_t table = c->buckets * sizeof(int32_t) +
+                   c->count * (sizeof(uint64_t) + sizeof(uint16_t) + sizeof(uint32_t) * 2 + 2);
+    fprintf(stderr, "%u สินค้า, %u bucket: ตาราง %zu ไบต์ + ชื่อ %zu ไบต์ (%.1f ไบต์/สินค้า) | แบบ struct %zu ไบต์\n",
+            (unsigned)c->count, (unsigned)c->buckets, table, names_bytes,
+            (double)(table + names_bytes) / c->count, c->count * sizeof(product_row_t));
+
+    static const bench_case_t cases[] = {
+        { .name = "catalog_find_hit", .fn = bench_find_hit, .ctx = (void *)&bench_catalog },
+        { .name = "catalog_find_miss", .fn = bench_find_miss, .ctx = (void *)&bench_catalog },
+        { .name = "bsearch_sorted", .fn = bench_bsearch, .ctx = (void *)&bench_catalog },
+    };
+    bench_calibrate(&cfg);
+    bench_print_csv_header(stdout);
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        bench_run(&cases[i], &cfg, &r);
+        bench_print_csv(stdout, &r);
+    }
+    // ไล่ทีละตัวช้ากว่าหลายพันเท่า: ลดจำนวนครั้งต่อรอบไม่ให้รอนาน
+    static const bench_case_t linear = { .name = "linear_strcmp", .fn = bench_linear_strcmp,
+                                         .ctx = (void *)&bench_catalog };
+    cfg.inner_iters = 4;
+    cfg.reps = 21;
+    bench_run(&linear, &cfg, &r);
+    bench_print_csv(stdout, &r);
+    free(sorted);
+    free(rows);
+    return 0;
+}
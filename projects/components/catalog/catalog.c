@@ -0,0 +1,29 @@
+#include "catalog.h"
+
+int32_t catalog_find(const catalog_t *c, uint64_t barcode) {
+    if (c->count == 0) {
+        return CATALOG_NOT_FOUND;
+    }
+    int32_t d = c->disp[catalog_range(catalog_hash(barcode, c->seed), c->buckets)];
+    uint32_t i = d < 0 ? (uint32_t)(-(d + 1)) : catalog_range(catalog_hash(barcode, (uint32_t)d), c->count);
+    return c->barcode[i] == barcode ? (int32_t)i : CATALOG_NOT_FOUND;
+}
+
+bool catalog_parse_barcode(const char *text, uint64_t *out) {
+    uint64_t v = 0;
+    int digits = 0;
+    while (*text >= '0' && *text <= '9') {
+        if (++digits > 19) {
+            return false;
+        }
+        v = v * 10 + (uint64_t)(*text++ - '0');
+    }
+    while (*text == ' ' || *text == '\r' || *text == '\n' || *text == '\t') {
+        text++;
+    }
+    if (digits == 0 || *text != '\0') {
+        return false;
+    }
+    *out = v;
+    return true;
+}
@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+# 🛒 สร้างแคตตาล็อกสินค้า (ไฟล์ C) จาก CSV ตอน build
+#
+# เรียกอัตโนมัติผ่าน catalog_generate() ใน CMakeLists.txt ของ component (ดู project_include.cmake)
+# หรือเรียกเองได้:
+#   python gen_catalog.py shop_catalog.csv --symbol shop_catalog --out build/shop_catalog.c
+#
+# CSV (บรรทัดแรกเป็นหัวตาราง บรรทัดว่างและบรรทัดที่ขึ้นต้นด้วย '#' ถูกข้าม):
+#   barcode,id,name,price,category,vat
+#   8850999320014,1,น้ำดื่ม,15.00,1,std
+#   barcode   ตัวเลขล้วน ≤ 19 หลัก (EAN-13, UPC-A, GTIN-14 ...) ห้ามซ้ำ
+#   id        รหัสสินค้า 0-65535 (ใช้ในกฎราคา)
+#   price     บาท ทศนิยมไม่เกิน 2 ตำแหน่ง (เก็บเป็นสตางค์)
+#   category  หมวด 0-255
+#   vat       std | zero | exempt
+#
+# ผลลัพธ์: const catalog_t <symbol> — ตารางแบบ structure-of-arrays เรียงตามช่องของ
+# minimal perfect hash (hash-and-displace): ทุก barcode ได้ช่องของตัวเองพอดี n ช่องสำหรับ n สินค้า
+# ชื่อซ้ำกันเก็บครั้งเดียว (intern) ทุกอย่างเป็น const จึงอยู่ใน flash ไม่กิน RAM
+
+import argparse
+import csv
+import sys
+from decimal import Decimal, InvalidOperation
+
+MASK64 = (1 << 64) - 1
+BUCKET_LOAD = 4             # จำนวน barcode เฉลี่ยต่อ bucket (ตาราง displacement = 4 ไบต์ต่อ 4 สินค้า)
+MAX_DISPLACEMENT = 1 << 20  # ลองเกินนี้แล้วยังวางไม่ได้ = เปลี่ยน seed ชั้นแรกแล้วเริ่มใหม่
+MAX_SEEDS = 64
+VAT_CLASSES = {'std': 0, 'zero': 1, 'exempt': 2}
+COLUMNS = ['barcode', 'id', 'name', 'price', 'category', 'vat']
+
+
+# ต้องตรงกับ catalog_hash / catalog_range ใน include/catalog.h ทุกบิต
+def catalog_hash(key, seed):
+    h = key ^ ((seed * 0x9E3779B97F4A7C15) & MASK64)
+    h ^= h >> 33
+    h = (h * 0xFF51AFD7ED558CCD) & MASK64
+    h ^= h >> 33
+    h = (h * 0xC4CEB9FE1A85EC53) & MASK64
+    h ^= h >> 33
+    return h
+
+
+def catalog_range(h, n):
+    return ((h >> 32) * n) >> 32
+
+
+class CatalogError(Exception):
+    pass
+
+
+def parse(path):
+    items = []
+    seen = {}
+    with open(path, newline='', encoding='utf-8') as f:
+        rows = [(no, row) for no, row in enumerate(csv.reader(f), 1)
+                if row and not row[0].lstrip().startswith('#')]
+    if not rows or [c.strip() for c in rows[0][1]] != COLUMNS:
+        raise CatalogError('%s: หัวตารางต้องเป็น %s' % (path, ','.join(COLUMNS)))
+    for no, row in rows[1:]:
+        where = '%s:%d' % (path, no)
+        if len(row) != len(COLUMNS):
+            raise CatalogError('%s: ต้องมี %d คอลัมน์' % (where, len(COLUMNS)))
+        barcode, pid, name, price, category, vat = (c.strip() for c in row)
+        if not barcode.isdigit() or len(barcode) > 19:
+            raise CatalogError('%s: barcode "%s" ต้องเป็นตัวเลข ≤ 19 หลัก' % (where, barcode))
+        key = int(barcode)
+        if key in seen:
+            raise CatalogError('%s: barcode %s ซ้ำกับบรรทัด %d' % (where, barcode, seen[key]))
+        seen[key] = no
+        try:
+            satang = Decimal(price) * 100
+        except InvalidOperation:
+            satang = Decimal(-1)
+        if satang < 0 or satang != satang.to_integral_value() or satang >= 1 << 32:
+            raise CatalogError('%s: ราคา "%s" ต้องเป็นบาท ≥ 0 ทศนิยมไม่เกิน 2 ตำแหน่ง' % (where, price))
+        if not pid.isdigit() or int(pid) > 0xFFFF:
+            raise CatalogError('%s: id "%s" ต้องอยู่ในช่วง 0-65535' % (where, pid))
+        if not category.isdigit() or int(category) > 0xFF:
+            raise CatalogError('%s: category "%s" ต้องอยู่ในช่วง 0-255' % (where, category))
+        if vat not in VAT_CLASSES:
+            raise CatalogError('%s: vat "%s" ต้องเป็น %s' % (where, vat, ' | '.join(VAT_CLASSES)))
+        if not name:
+            raise CatalogError('%s: ไม่มีชื่อสินค้า' % where)
+        items.append({'key': key, 'id': int(pid), 'name': name, 'price': int(satang),
+                      'category': int(category), 'vat': VAT_CLASSES[vat]})
+    return items
+
+
+# 🔑 hash-and-displace: กระจาย barcode ลง bucket ด้วย seed ชั้นแรก แล้ววาง bucket ใหญ่ก่อน
+# bucket ที่มีหลายตัว: หา d ที่ทำให้ทุกตัวใน bucket ได้ช่องว่างไม่ชนกัน (ช่อง = hash(key, d))
+# bucket ที่มีตัวเดียว: ใส่ช่องว่างที่เหลือตรงๆ เก็บเป็น -(ช่อง + 1)
+def build_mph(keys):
+    n = len(keys)
+    buckets = max(1, (n + BUCKET_LOAD - 1) // BUCKET_LOAD)
+    for seed in range(MAX_SEEDS):
+        groups = [[] for _ in range(buckets)]
+        for k in keys:
+            groups[catalog_range(catalog_hash(k, seed), buckets)].append(k)
+        order = sorted(range(buckets), key=lambda b: -len(groups[b]))
+        slots = [None] * n
+        disp = [0] * buckets
+        ok = True
+        for b in order:
+            group = groups[b]
+            if len(group) <= 1:
+                break
+            for d in range(1, MAX_DISPLACEMENT):
+                idx = []
+                for k in group:
+                    i = catalog_range(catalog_hash(k, d), n)
+                    if slots[i] is not None or i in idx:
+                        break
+                    idx.append(i)
+                else:
+                    break
+            else:
+                ok = False
+                break
+            for k, i in zip(group, idx):
+                slots[i] = k
+            disp[b] = d
+        if not ok:
+            continue
+        free = [i for i in range(n) if slots[i] is None]
+        for b in order:
+            if len(groups[b]) == 1:
+                i = free.pop()
+                slots[i] = groups[b][0]
+                disp[b] = -i - 1
+        return seed, disp, slots
+    raise CatalogError('หา minimal perfect hash ไม่ได้ใน %d seed' % MAX_SEEDS)
+
+
+def c_string(text):
+    return '"' + text.replace('\\', '\\\\').replace('"', '\\"') + '\\0"'
+
+
+def c_array(out, ctype, name, values, per_line=8):
+    out.append('static const %s %s[%d] = {' % (ctype, name, max(1, len(values))))
+    for i in range(0, len(values), per_line):
+        out.append('    ' + ', '.join(values[i:i + per_line]) + ',')
+    if not values:
+        out.append('    0,')
+    out.append('};')
+
+
+def generate(items, symbol, source):
+    by_key = {it['key']: it for it in items}
+    seed, disp, slots = build_mph([it['key'] for it in items])
+    rows = [by_key[k] for k in slots]
+
+    names = {}
+    blob = 0
+    for it in rows:
+        if it['name'] not in names:
+            names[it['name']] = blob
+            blob += len(it['name'].encode('utf-8')) + 1
+
+    p = symbol + '_'
+    out = ['// ⚠️ สร้างอัตโนมัติจาก %s ด้วย gen_catalog.py — อย่าแก้ไฟล์นี้เอง' % source,
+           '// %d สินค้า, %d bucket, ชื่อ %d ไบต์ (%d ชื่อไม่ซ้ำ)' % (len(rows), len(disp), blob, len(names)),
+           '#include "catalog.h"', '']
+    c_array(out, 'int32_t', p + 'disp', [str(d) for d in disp])
+    c_array(out, 'uint64_t', p + 'barcode', ['%dull' % it['key'] for it in rows], 4)
+    c_array(out, 'uint16_t', p + 'id', [str(it['id']) for it in rows], 16)
+    c_array(out, 'uint32_t', p + 'price', [str(it['price']) for it in rows], 12)
+    c_array(out, 'uint8_t', p + 'category', [str(it['category']) for it in rows], 16)
+    c_array(out, 'uint8_t', p + 'vat', [str(it['vat']) for it in rows], 16)
+    c_array(out, 'uint32_t', p + 'name_off', [str(names[it['name']]) for it in rows], 12)
+    out.append('static const char %snames[%d] =' % (p, max(1, blob)))
+    out += ['    ' + c_string(name) for name in names] or ['    ""']
+    out[-1] += ';'
+    out += ['',
+            'const catalog_t %s = {' % symbol,
+            '    .count = %d,' % len(rows),
+            '    .buckets = %d,' % len(disp),
+            '    .seed = %d,' % seed,
+            '    .disp = %sdisp,' % p,
+            '    .barcode = %sbarcode,' % p,
+            '    .id = %sid,' % p,
+            '    .price = %sprice,' % p,
+            '    .category = %scategory,' % p,
+            '    .vat = %svat,' % p,
+            '    .name_off = %sname_off,' % p,
+            '    .names = %snames,' % p,
+            '};', '']
+    return '\n'.join(out)
+
+
+def main():
+    ap = argparse.ArgumentParser(description='CSV → แคตตาล็อก C (minimal perfect hash + SoA)')
+    ap.add_argument('csv')
+    ap.add_argument('--symbol', required=True, help='ชื่อตัวแปร const catalog_t ที่สร้าง')
+    ap.add_argument('--out', required=True)
+    args = ap.parse_args()
+    try:
+        items = parse(args.csv)
+        text = generate(items, args.symbol, args.csv.replace('\\', '/').split('/')[-1])
+    except CatalogError as e:
+        print('gen_catalog: %s' % e, file=sys.stderr)
+        return 1
+    with open(args.out, 'w', encoding='utf-8') as f:
+        f.write(text)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 🛒 catalog: แคตตาล็อกสินค้าที่สร้างจาก CSV ตอน build (gen_catalog.py) ค้นด้วย barcode ใน O(1)
+// - minimal perfect hash แบบ hash-and-displace: hash 2 ครั้ง → ได้ช่องเดียวแน่นอน
+//   แล้วเทียบ barcode (จำนวนเต็ม) ครั้งเดียวเพื่อปัด barcode ที่ไม่มีในร้าน ไม่มีการเทียบข้อความ
+// - ข้อมูลเป็น structure-of-arrays เรียงตามช่อง: สแกนหนึ่งครั้งแตะเฉพาะคอลัมน์ที่ใช้
+// - ชื่อซ้ำเก็บครั้งเดียวในก้อน names (แต่ละชื่อปิดด้วย '\0') ทุกตารางเป็น const อยู่ใน flash
+// ขนาดต่อสินค้า: 8 (barcode) + 4 (ราคา) + 4 (name offset) + 2 (id) + 1 + 1 + ~1 (displacement) ไบต์ + ชื่อ
+//
+// ใช้งาน: ใน CMakeLists.txt ของ component หลัง idf_component_register
+//   catalog_generate(shop_catalog.csv shop_catalog)
+// แล้วในโค้ด: extern const catalog_t shop_catalog;  (รูปแบบ CSV ดู gen_catalog.py)
+
+#define CATALOG_NOT_FOUND (-1)
+
+typedef enum {
+    CATALOG_VAT_STANDARD = 0,   // อัตราปกติ
+    CATALOG_VAT_ZERO,           // อัตรา 0% (เช่นส่งออก)
+    CATALOG_VAT_EXEMPT,         // ยกเว้น VAT (เช่นของสด)
+} catalog_vat_t;
+
+typedef struct {
+    uint32_t count;             // จำนวนสินค้า (= จำนวนช่อง)
+    uint32_t buckets;
+    uint32_t seed;              // seed ของ hash ชั้นแรก (เลือกตอนสร้าง)
+    const int32_t *disp;        // [buckets] > 0: seed ของ hash ชั้นสอง, < 0: ช่อง -(d + 1), 0: bucket ว่าง
+    const uint64_t *barcode;    // [count]
+    const uint16_t *id;         // [count] รหัสสินค้า (ใช้ในกฎราคา)
+    const uint32_t *price;      // [count] สตางค์
+    const uint8_t *category;    // [count]
+    const uint8_t *vat;         // [count] catalog_vat_t
+    const uint32_t *name_off;   // [count] ตำแหน่งชื่อใน names
+    const char *names;
+} catalog_t;
+
+// 🔑 ต้องตรงกับ catalog_hash ใน gen_catalog.py ทุกบิต (mix ของ MurmurHash3 — สลับ key 64 บิตแบบ 1:1 ต่อ seed)
+static inline uint64_t catalog_hash(uint64_t key, uint32_t seed) {
+    uint64_t h = key ^ ((uint64_t)seed * 0x9E3779B97F4A7C15ull);
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+// ย่อ hash ลงช่วง [0, n) ด้วยการคูณแทนการหารเอาเศษ
+static inline uint32_t catalog_range(uint64_t h, uint32_t n) {
+    return (uint32_t)(((h >> 32) * n) >> 32);
+}
+
+// 🔎 ดัชนีของสินค้า หรือ CATALOG_NOT_FOUND
+int32_t catalog_find(const catalog_t *c, uint64_t barcode);
+
+// 📟 แปลงข้อความจากเครื่องสแกน (ตัวเลข ≤ 19 หลัก ช่องว่าง/ขึ้นบรรทัดท้ายได้) เป็น barcode
+bool catalog_parse_barcode(const char *text, uint64_t *out);
+
+static inline const char *catalog_name(const catalog_t *c, uint32_t i) {
+    return c->names + c->name_off[i];
+}
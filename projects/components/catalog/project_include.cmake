@@ -0,0 +1,18 @@
+# 🛒 catalog_generate(<csv> <symbol>)
+# เรียกใน CMakeLists.txt ของ component หลัง idf_component_register
+# สร้าง <symbol>.c (const catalog_t <symbol>) จาก CSV ตอน build แล้วคอมไพล์รวมกับ component นั้น
+# สร้างใหม่เองเมื่อ CSV หรือ gen_catalog.py เปลี่ยน
+idf_build_set_property(CATALOG_GENERATOR "${CMAKE_CURRENT_LIST_DIR}/gen_catalog.py")
+
+function(catalog_generate csv symbol)
+    idf_build_get_property(python PYTHON)
+    idf_build_get_property(generator CATALOG_GENERATOR)
+    get_filename_component(csv "${csv}" ABSOLUTE BASE_DIR "${CMAKE_CURRENT_SOURCE_DIR}")
+    set(out "${CMAKE_CURRENT_BINARY_DIR}/${symbol}.c")
+    add_custom_command(OUTPUT "${out}"
+        COMMAND ${python} "${generator}" "${csv}" --symbol ${symbol} --out "${out}"
+        DEPENDS "${csv}" "${generator}"
+        COMMENT "Generating product catalog ${symbol}"
+        VERBATIM)
+    target_sources(${COMPONENT_LIB} PRIVATE "${out}")
+endfunction()
@@ -0,0 +1,70 @@
+#include "fastdiv.h"
+
+bool fastdiv_u32_init(fastdiv_u32_t *fd, uint32_t divisor) {
+    if (divisor == 0) {
+        return false;
+    }
+
+    uint32_t floor_log2 = 31 - (uint32_t)__builtin_clz(divisor);
+    fd->divisor = divisor;
+
+    // กำลังของ 2: shift อย่างเดียวพอ
+    if ((divisor & (divisor - 1)) == 0) {
+        fd->magic = 0;
+        fd->more = (uint8_t)floor_log2;
+        return true;
+    }
+
+    // m = floor(2^(32+k) / d) ทำครั้งเดียวตอน init
+    uint64_t dividend = (uint64_t)1 << (32 + floor_log2);
+    uint32_t proposed = (uint32_t)(dividend / divisor);
+    uint32_t rem = (uint32_t)(dividend - (uint64_t)proposed * divisor);
+    uint32_t e = divisor - rem;
+
+    if (e < ((uint32_t)1 << floor_log2)) {
+        // ค่าคลาดเคลื่อนเล็กพอ ใช้ magic ตรงๆ
+        fd->more = (uint8_t)floor_log2;
+    } else {
+        // ต้องการความละเอียดเพิ่ม 1 bit ใช้ขั้นตอน "add" ตอนหาร
+        proposed += proposed;
+        uint32_t twice_rem = rem + rem;
+        if (twice_rem >= divisor || twice_rem < rem) {
+            proposed += 1;
+        }
+        fd->more = (uint8_t)(floor_log2 | FASTDIV_ADD_MARKER);
+    }
+    fd->magic = 1 + proposed;
+    return true;
+}
+
+void fastdiv_u32_divmod_array(const fastdiv_u32_t *fd, const uint32_t *numerators,
+                              uint32_t *quotients, uint32_t *remainders, size_t count) {
+    // แยก loop ตามชนิดตัวหาร เพื่อไม่ให้มี branch ภายใน loop
+    const uint32_t d = fd->divisor;
+    const uint32_t magic = fd->magic;
+    const uint32_t shift = fd->more & FASTDIV_SHIFT_MASK;
+
+    if (magic == 0) {
+        for (size_t i = 0; i < count; i++) {
+            uint32_t n = numerators[i];
+            uint32_t q = n >> shift;
+            if (quotients) quotients[i] = q;
+            if (remainders) remainders[i] = n & (d - 1);
+        }
+    } else if (fd->more & FASTDIV_ADD_MARKER) {
+        for (size_t i = 0; i < count; i++) {
+            uint32_t n = numerators[i];
+            uint32_t hi = (uint32_t)(((uint64_t)magic * n) >> 32);
+            uint32_t q = ((((n - hi) >> 1) + hi) >> shift);
+            if (quotients) quotients[i] = q;
+            if (remainders) remainders[i] = n - q * d;
+        }
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            uint32_t n = numerators[i];
+            uint32_t q = (uint32_t)(((uint64_t)magic * n) >> 32) >> shift;
+            if (quotients) quotients[i] = q;
+            if (remainders) remainders[i] = n - q * d;
+        }
+    }
+}
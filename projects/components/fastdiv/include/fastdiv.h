@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ➗ fastdiv: หารด้วยตัวหารเดิมซ้ำๆ โดยไม่ใช้คำสั่งหารของฮาร์ดแวร์
+// คำนวณ "ส่วนกลับ" (magic number) ครั้งเดียวตอน init แล้วหารด้วยการคูณ + shift
+// (แนวทางเดียวกับ libdivide แบบ unsigned 32 บิต)
+
+#define FASTDIV_ADD_MARKER 0x40
+#define FASTDIV_SHIFT_MASK 0x1F
+
+// 🧮 ตัวหารที่คำนวณส่วนกลับไว้แล้ว
+typedef struct {
+    uint32_t divisor;
+    uint32_t magic;     // 0 = ตัวหารเป็นกำลังของ 2 ใช้ shift อย่างเดียว
+    uint8_t more;       // จำนวน bit ที่ต้อง shift + ธง FASTDIV_ADD_MARKER
+} fastdiv_u32_t;
+
+// 📦 ผลหารและเศษคู่กัน
+typedef struct {
+    uint32_t quotient;
+    uint32_t remainder;
+} fastdiv_qr_t;
+
+// เตรียมตัวหาร คืนค่า false ถ้า divisor == 0
+bool fastdiv_u32_init(fastdiv_u32_t *fd, uint32_t divisor);
+
+// ผลหาร n / divisor
+static inline uint32_t fastdiv_u32_div(const fastdiv_u32_t *fd, uint32_t n) {
+    if (fd->magic == 0) {
+        return n >> fd->more;
+    }
+    uint32_t q = (uint32_t)(((uint64_t)fd->magic * n) >> 32);
+    if (fd->more & FASTDIV_ADD_MARKER) {
+        uint32_t t = ((n - q) >> 1) + q;
+        return t >> (fd->more & FASTDIV_SHIFT_MASK);
+    }
+    return q >> fd->more;
+}
+
+// ผลหารและเศษในการเรียกครั้งเดียว (เศษได้จากการคูณกลับ ไม่ต้องใช้ %)
+static inline fastdiv_qr_t fastdiv_u32_divmod(const fastdiv_u32_t *fd, uint32_t n) {
+    fastdiv_qr_t qr;
+    qr.quotient = fastdiv_u32_div(fd, n);
+    qr.remainder = n - qr.quotient * fd->divisor;
+    return qr;
+}
+
+// หารทั้งอาร์เรย์ด้วยตัวหารเดียวกัน
+// quotients หรือ remainders ส่ง NULL ได้ถ้าไม่ต้องการผลนั้น
+void fastdiv_u32_divmod_array(const fastdiv_u32_t *fd, const uint32_t *numerators,
+                              uint32_t *quotients, uint32_t *remainders, size_t count);
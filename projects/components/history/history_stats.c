@@ -0,0 +1,164 @@
+#include "history_stats.h"
+#include "history_store.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void agg_reset(history_agg_t *a, size_t n) {
+    memset(a, 0, n * sizeof(*a));
+}
+
+// ➕ Welford: อัปเดตค่าเฉลี่ยและ m2 ทีละค่า ไม่ต้องเก็บค่าเดิม
+static void agg_add(history_agg_t *a, double v) {
+    if (a->count == 0) {
+        a->min = v;
+        a->max = v;
+    } else {
+        a->min = v < a->min ? v : a->min;
+        a->max = v > a->max ? v : a->max;
+    }
+    a->count++;
+    a->sum += v;
+    double delta = v - a->mean;
+    a->mean += delta / a->count;
+    a->m2 += delta * (v - a->mean);
+}
+
+// 🔗 รวมสองกลุ่ม (สูตรของ Chan et al.) ใช้ตอนถามข้ามหลาย bucket
+static void agg_merge(history_agg_t *into, const history_agg_t *b) {
+    if (b->count == 0) {
+        return;
+    }
+    if (into->count == 0) {
+        *into = *b;
+        return;
+    }
+    double n = (double)into->count + b->count;
+    double delta = b->mean - into->mean;
+    into->m2 += b->m2 + delta * delta * ((double)into->count * b->count / n);
+    into->mean += delta * (b->count / n);
+    into->sum += b->sum;
+    into->min = b->min < into->min ? b->min : into->min;
+    into->max = b->max > into->max ? b->max : into->max;
+    into->count += b->count;
+}
+
+// แถวของ op ในตาราง (op ที่ไม่ได้ติดตามได้ -1)
+static int row_of(const history_stats_t *s, int op) {
+    if (op == HISTORY_ANY_OP) {
+        return s->ops;
+    }
+    return (op >= 0 && op < s->ops) ? op : -1;
+}
+
+// หารปัดลง (time ติดลบก็ได้ bucket ที่ถูกต้อง)
+static int64_t bucket_of(const history_stats_t *s, int64_t time_ms) {
+    int64_t q = time_ms / s->bucket_ms;
+    return (time_ms % s->bucket_ms < 0) ? q - 1 : q;
+}
+
+bool history_stats_init(history_stats_t *s, uint8_t ops, uint16_t buckets, uint32_t bucket_ms) {
+    memset(s, 0, sizeof(*s));
+    if (buckets == 0 || bucket_ms == 0) {
+        return false;
+    }
+    size_t rows = (size_t)ops + 1;
+    s->total = calloc(rows, sizeof(history_agg_t));
+    s->slots = calloc(rows * buckets, sizeof(history_agg_t));
+    s->slot_index = malloc(buckets * sizeof(int64_t));
+    if (s->total == NULL || s->slots == NULL || s->slot_index == NULL) {
+        history_stats_free(s);
+        return false;
+    }
+    s->ops = ops;
+    s->buckets = buckets;
+    s->bucket_ms = bucket_ms;
+    history_stats_clear(s);
+    return true;
+}
+
+void history_stats_free(history_stats_t *s) {
+    free(s->total);
+    free(s->slots);
+    free(s->slot_index);
+    memset(s, 0, sizeof(*s));
+}
+
+void history_stats_clear(history_stats_t *s) {
+    if (s->total == NULL) {
+        return;
+    }
+    agg_reset(s->total, (size_t)s->ops + 1);
+    agg_reset(s->slots, ((size_t)s->ops + 1) * s->buckets);
+    for (uint16_t i = 0; i < s->buckets; i++) {
+        s->slot_index[i] = INT64_MIN;
+    }
+}
+
+void history_stats_add(history_stats_t *s, int op, int64_t time_ms, double value) {
+    if (s->total == NULL) {
+        return;
+    }
+    int r = row_of(s, op);
+    if (r >= 0) {
+        agg_add(&s->total[r], value);
+    }
+    agg_add(&s->total[s->ops], value);
+
+    size_t rows = (size_t)s->ops + 1;
+    int64_t bucket = bucket_of(s, time_ms);
+    size_t slot = (size_t)(((bucket % s->buckets) + s->buckets) % s->buckets);
+    history_agg_t *row = &s->slots[slot * rows];
+
+    if (s->slot_index[slot] != bucket) {
+        if (s->slot_index[slot] > bucket) {
+            return;     // เวลาย้อนหลังเกินช่วงของ ring: นับเฉพาะใน total
+        }
+        // ช่องนี้เก็บ bucket เก่าที่หลุดช่วงไปแล้ว เริ่มนับใหม่
+        agg_reset(row, rows);
+        s->slot_index[slot] = bucket;
+    }
+    if (r >= 0) {
+        agg_add(&row[r], value);
+    }
+    agg_add(&row[s->ops], value);
+}
+
+void history_stats_query(const history_stats_t *s, int op, int64_t since_ms, int64_t now_ms,
+                         history_agg_t *out) {
+    memset(out, 0, sizeof(*out));
+    int r = s->total ? row_of(s, op) : -1;
+    if (r < 0) {
+        return;
+    }
+    size_t rows = (size_t)s->ops + 1;
+    int64_t last = bucket_of(s, now_ms);
+    int64_t first = bucket_of(s, since_ms);
+    if (first < last - s->buckets + 1) {
+        first = last - s->buckets + 1;
+    }
+    for (int64_t b = first; b <= last; b++) {
+        size_t slot = (size_t)(((b % s->buckets) + s->buckets) % s->buckets);
+        if (s->slot_index[slot] == b) {
+            agg_merge(out, &s->slots[slot * rows + r]);
+        }
+    }
+}
+
+void history_stats_total(const history_stats_t *s, int op, history_agg_t *out) {
+    int r = s->total ? row_of(s, op) : -1;
+    if (r < 0) {
+        memset(out, 0, sizeof(*out));
+        return;
+    }
+    *out = s->total[r];
+}
+
+double history_agg_variance(const history_agg_t *a) {
+    return a->count ? a->m2 / a->count : 0.0;
+}
+
+double history_agg_stddev(const history_agg_t *a) {
+    return sqrt(history_agg_variance(a));
+}
@@ -0,0 +1,432 @@
+#include "history_store.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdkconfig.h"
+#if CONFIG_SPIRAM
+#include "esp_heap_caps.h"
+#endif
+
+// 🏷️ วิธีเก็บค่าแต่ละตัว (2 บิต)
+enum {
+    VALUE_ZERO = 0,     // 0.0 ไม่ต้องเก็บไบต์
+    VALUE_CENTS = 1,    // ค่า×100 เป็นจำนวนเต็มพอดี (เงิน, จำนวนนับ) → zigzag varint
+    VALUE_F32 = 2,      // แปลงเป็น float แล้วไม่เสียความแม่นยำ → 4 ไบต์
+    VALUE_F64 = 3,      // ที่เหลือ → 8 ไบต์
+};
+
+#define EXACT_INT_LIMIT 9007199254740992.0  // 2^53
+
+static uint64_t zigzag(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static int64_t unzigzag(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+static size_t put_varint(uint8_t *p, uint64_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        p[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+// varint ของ uint64 ยาวไม่เกิน 10 ไบต์ (ไบต์ที่ 10 มีได้แค่บิตเดียว)
+// ยาวเกินหรือบิตเกิน 64 บิต = เรคคอร์ดเสีย คืนค่า 0
+#define VARINT_MAX 10
+
+static size_t get_varint(const uint8_t *p, uint64_t *v) {
+    uint64_t r = 0;
+    for (size_t n = 0; n < VARINT_MAX; n++) {
+        uint64_t byte = p[n] & 0x7F;
+        if (n == VARINT_MAX - 1 && byte > 1) {
+            return 0;
+        }
+        r |= byte << (7 * n);
+        if (!(p[n] & 0x80)) {
+            *v = r;
+            return n + 1;
+        }
+    }
+    return 0;
+}
+
+static uint8_t put_value(uint8_t *p, size_t *len, double v) {
+    if (v == 0.0 && !signbit(v)) {
+        return VALUE_ZERO;
+    }
+    double cents = v * 100.0;
+    if (fabs(cents) < EXACT_INT_LIMIT && cents == nearbyint(cents)) {
+        int64_t c = (int64_t)cents;
+        if ((double)c / 100.0 == v) {
+            *len += put_varint(p + *len, zigzag(c));
+            return VALUE_CENTS;
+        }
+    }
+    float f = (float)v;
+    if ((double)f == v) {
+        memcpy(p + *len, &f, sizeof(f));
+        *len += sizeof(f);
+        return VALUE_F32;
+    }
+    memcpy(p + *len, &v, sizeof(v));
+    *len += sizeof(v);
+    return VALUE_F64;
+}
+
+// คืนค่า false ถ้า varint ของค่าเสีย
+static bool get_value(const uint8_t *p, size_t *len, uint8_t tag, double *v) {
+    switch (tag) {
+        case VALUE_CENTS: {
+            uint64_t z;
+            size_t n = get_varint(p + *len, &z);
+            if (n == 0) {
+                return false;
+            }
+            *len += n;
+            *v = (double)unzigzag(z) / 100.0;
+            return true;
+        }
+        case VALUE_F32: {
+            float f;
+            memcpy(&f, p + *len, sizeof(f));
+            *len += sizeof(f);
+            *v = f;
+            return true;
+        }
+        case VALUE_F64:
+            memcpy(v, p + *len, sizeof(*v));
+            *len += sizeof(*v);
+            return true;
+        default:
+            *v = 0.0;
+            return true;
+    }
+}
+
+// 📦 ถอดเรคคอร์ดจากบัฟเฟอร์เชิงเส้น (ยาว HISTORY_RECORD_MAX) คืนค่าความยาวเรคคอร์ด หรือ 0 ถ้าเรคคอร์ดเสีย
+// varint ถูกจำกัดที่ 10 ไบต์ เรคคอร์ดที่ถอดได้จึงไม่อ่านเกิน HISTORY_RECORD_MAX เสมอ
+static size_t decode_record(const uint8_t *p, history_record_t *out, int64_t *dt_ms) {
+    uint8_t tags = p[1];
+    size_t len = 2;
+    uint64_t z;
+    size_t n = get_varint(p + len, &z);
+    if (n == 0 || (tags >> 6) != 0) {
+        return 0;
+    }
+    len += n;
+    *dt_ms = unzigzag(z);
+    out->op = p[0];
+    if (!get_value(p, &len, tags & 3, &out->operand1) ||
+        !get_value(p, &len, (tags >> 2) & 3, &out->operand2) ||
+        !get_value(p, &len, (tags >> 4) & 3, &out->result)) {
+        return 0;
+    }
+    return len;
+}
+
+// 🔁 คัดลอกเข้า/ออก arena แบบวนรอบ
+static void ring_write(history_store_t *h, size_t pos, const uint8_t *src, size_t len) {
+    size_t first = h->cap - pos < len ? h->cap - pos : len;
+    memcpy(h->arena + pos, src, first);
+    memcpy(h->arena, src + first, len - first);
+}
+
+// อ่าน HISTORY_RECORD_MAX ไบต์เสมอ (ไบต์ที่เกินเรคคอร์ดจริงไม่ถูกใช้)
+static void ring_read(const history_store_t *h, size_t pos, uint8_t *dst) {
+    size_t first = h->cap - pos < HISTORY_RECORD_MAX ? h->cap - pos : HISTORY_RECORD_MAX;
+    memcpy(dst, h->arena + pos, first);
+    memcpy(dst + first, h->arena, HISTORY_RECORD_MAX - first);
+}
+
+bool history_store_init(history_store_t *h, size_t arena_bytes, bool prefer_external) {
+    memset(h, 0, sizeof(*h));
+    h->next_id = 1;
+    if (arena_bytes < HISTORY_RECORD_MAX) {
+        return false;
+    }
+#if CONFIG_SPIRAM
+    if (prefer_external) {
+        h->arena = heap_caps_malloc(arena_bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        h->external = h->arena != NULL;
+    }
+#else
+    (void)prefer_external;
+#endif
+    if (h->arena == NULL) {
+        h->arena = malloc(arena_bytes);
+    }
+    if (h->arena == NULL) {
+        return false;
+    }
+    h->cap = arena_bytes;
+
+    // ดัชนีเต็มที่ได้ไม่เกิน (arena / เรคคอร์ดเล็กสุด) / HISTORY_BLOCK บล็อก
+    // จองไม่สำเร็จก็ยังใช้งานได้ แค่การค้นหาต้องไล่ทุกเรคคอร์ด
+    h->block_cap = (uint32_t)(arena_bytes / (HISTORY_RECORD_MIN * HISTORY_BLOCK)) + 2;
+    h->blocks = calloc(h->block_cap, sizeof(history_block_t));
+    if (h->blocks == NULL) {
+        h->block_cap = 0;
+    }
+    return true;
+}
+
+void history_store_free(history_store_t *h) {
+    free(h->arena);
+    free(h->blocks);
+    memset(h, 0, sizeof(*h));
+}
+
+void history_store_clear(history_store_t *h) {
+    h->head = 0;
+    h->used = 0;
+    h->count = 0;
+    h->first_id = h->next_id;
+    h->block_count = 0;
+}
+
+static history_block_t *block_at(const history_store_t *h, uint32_t i) {
+    return &h->blocks[(h->block_head + i) % h->block_cap];
+}
+
+// 🗂️ อัปเดตดัชนีด้วยเรคคอร์ดใหม่ที่ตำแหน่ง pos
+static void index_append(history_store_t *h, uint32_t id, uint8_t op, size_t pos, int64_t time_ms) {
+    if (h->block_cap == 0) {
+        return;
+    }
+    if (h->block_count == 0 || (id - 1) % HISTORY_BLOCK == 0) {
+        if (h->block_count == h->block_cap) {
+            h->block_head = (h->block_head + 1) % h->block_cap;
+            h->block_count--;
+        }
+        history_block_t *b = block_at(h, h->block_count++);
+        b->pos = pos;
+        b->id = id;
+        b->op_mask = 0;
+        b->time_ms = time_ms;
+        b->min_time_ms = time_ms;
+        b->max_time_ms = time_ms;
+    }
+    history_block_t *b = block_at(h, h->block_count - 1);
+    b->op_mask |= 1u << (op & 31);
+    b->min_time_ms = time_ms < b->min_time_ms ? time_ms : b->min_time_ms;
+    b->max_time_ms = time_ms > b->max_time_ms ? time_ms : b->max_time_ms;
+}
+
+// ทิ้งบล็อกที่เรคคอร์ดถูกลบหมดแล้ว (บล็อกแรกอาจถูกลบไปบางส่วน — ตอนค้นหาจะเริ่มที่ head แทน)
+static void index_evict(history_store_t *h) {
+    while (h->block_count >= 2 && block_at(h, 1)->id <= h->first_id) {
+        h->block_head = (h->block_head + 1) % h->block_cap;
+        h->block_count--;
+    }
+    if (h->count == 0) {
+        h->block_count = 0;
+    }
+}
+
+// 🗑️ ลบเรคคอร์ดเก่าที่สุด แล้วคำนวณเวลาเต็มของ head ใหม่จากส่วนต่างของมัน
+static void evict_oldest(history_store_t *h) {
+    uint8_t buf[HISTORY_RECORD_MAX];
+    history_record_t rec;
+    int64_t dt;
+
+    ring_read(h, h->head, buf);
+    size_t len = decode_record(buf, &rec, &dt);
+    if (len == 0) {
+        // arena เสีย (ไม่ควรเกิด: import ตรวจทุกเรคคอร์ดแล้ว) ทิ้งทั้งหมดแทนการวนไม่รู้จบ
+        h->evicted += h->count;
+        history_store_clear(h);
+        return;
+    }
+    h->head = (h->head + len) % h->cap;
+    h->used -= len;
+    h->count--;
+    h->first_id++;
+    h->evicted++;
+
+    if (h->count > 0) {
+        ring_read(h, h->head, buf);
+        if (decode_record(buf, &rec, &dt) != 0) {
+            h->head_time_ms += dt;
+        }
+    }
+}
+
+uint32_t history_store_append(history_store_t *h, uint8_t op, int64_t time_ms,
+                              double operand1, double operand2, double result) {
+    uint8_t buf[HISTORY_RECORD_MAX];
+    size_t len = 2;
+
+    if (h->arena == NULL) {
+        return 0;
+    }
+    buf[0] = op;
+    len += put_varint(buf + len, zigzag(h->count > 0 ? time_ms - h->last_time_ms : 0));
+    uint8_t tags = put_value(buf, &len, operand1);
+    tags |= put_value(buf, &len, operand2) << 2;
+    tags |= put_value(buf, &len, result) << 4;
+    buf[1] = tags;
+
+    while (h->used + len > h->cap) {
+        evict_oldest(h);
+        index_evict(h);
+    }
+    if (h->count == 0) {
+        h->head_time_ms = time_ms;
+        h->first_id = h->next_id;
+    }
+    size_t pos = (h->head + h->used) % h->cap;
+    index_append(h, h->next_id, op, pos, time_ms);
+    ring_write(h, pos, buf, len);
+    h->used += len;
+    h->count++;
+    h->last_time_ms = time_ms;
+    return h->next_id++;
+}
+
+void history_iter_begin(const history_store_t *h, history_iter_t *it, uint32_t skip) {
+    it->h = h;
+    it->pos = h->head;
+    it->left = h->count;
+    it->id = h->first_id;
+    it->time_ms = h->head_time_ms;
+    it->fresh = true;
+
+    history_record_t discard;
+    while (skip-- > 0 && history_iter_next(it, &discard)) {
+    }
+}
+
+bool history_iter_next(history_iter_t *it, history_record_t *out) {
+    if (it->left == 0) {
+        return false;
+    }
+    uint8_t buf[HISTORY_RECORD_MAX];
+    int64_t dt;
+
+    ring_read(it->h, it->pos, buf);
+    size_t len = decode_record(buf, out, &dt);
+    if (len == 0) {
+        it->left = 0;
+        return false;
+    }
+    if (!it->fresh) {
+        it->time_ms += dt;
+    }
+    it->fresh = false;
+    out->id = it->id++;
+    out->time_ms = it->time_ms;
+    it->pos = (it->pos + len) % it->h->cap;
+    it->left--;
+    return true;
+}
+
+// 🔎 ไล่เฉพาะบล็อกที่อาจมีเรคคอร์ดตรงเงื่อนไข ถ้าไม่มีดัชนีก็ไล่ทั้งหมดทีเดียว
+static uint32_t scan(history_iter_t *it, int op, int64_t since_ms, int64_t until_ms,
+                     history_visit_fn visit, void *ctx, bool *stop) {
+    history_record_t rec;
+    uint32_t matched = 0;
+    while (!*stop && history_iter_next(it, &rec)) {
+        if ((op == HISTORY_ANY_OP || rec.op == op) &&
+            rec.time_ms >= since_ms && rec.time_ms < until_ms) {
+            matched++;
+            *stop = !visit(ctx, &rec);
+        }
+    }
+    return matched;
+}
+
+uint32_t history_store_query(const history_store_t *h, int op, int64_t since_ms, int64_t until_ms,
+                             history_visit_fn visit, void *ctx) {
+    history_iter_t it;
+    uint32_t matched = 0;
+    bool stop = false;
+
+    if (h->block_count == 0) {
+        history_iter_begin(h, &it, 0);
+        return scan(&it, op, since_ms, until_ms, visit, ctx, &stop);
+    }
+    for (uint32_t i = 0; i < h->block_count && !stop; i++) {
+        const history_block_t *b = block_at(h, i);
+        if ((op != HISTORY_ANY_OP && !(b->op_mask & (1u << (op & 31)))) ||
+            b->max_time_ms < since_ms || b->min_time_ms >= until_ms) {
+            continue;
+        }
+        uint32_t end_id = i + 1 < h->block_count ? block_at(h, i + 1)->id : h->next_id;
+        if (b->id < h->first_id) {
+            history_iter_begin(h, &it, 0);
+        } else {
+            it.h = h;
+            it.pos = b->pos;
+            it.id = b->id;
+            it.time_ms = b->time_ms;
+            it.fresh = true;
+        }
+        it.left = end_id - it.id;
+        matched += scan(&it, op, since_ms, until_ms, visit, ctx, &stop);
+    }
+    return matched;
+}
+
+size_t history_store_export(const history_store_t *h, uint8_t *out, size_t cap, history_export_t *meta) {
+    if (h->arena == NULL || cap < h->used) {
+        return 0;
+    }
+    size_t first = h->cap - h->head < h->used ? h->cap - h->head : h->used;
+    memcpy(out, h->arena + h->head, first);
+    memcpy(out + first, h->arena, h->used - first);
+    meta->count = h->count;
+    meta->first_id = h->first_id;
+    meta->head_time_ms = h->head_time_ms;
+    meta->bytes = (uint32_t)h->used;
+    return h->used;
+}
+
+bool history_store_import(history_store_t *h, const uint8_t *data, const history_export_t *meta) {
+    if (h->arena == NULL || meta->bytes > h->cap || (meta->count == 0) != (meta->bytes == 0)) {
+        return false;
+    }
+    h->next_id = meta->first_id;
+    history_store_clear(h);
+    memcpy(h->arena, data, meta->bytes);
+
+    // ไล่ถอดทีละเรคคอร์ดเพื่อสร้างดัชนีและหาเวลาของเรคคอร์ดล่าสุด (ตรวจความยาวไปพร้อมกัน)
+    uint8_t buf[HISTORY_RECORD_MAX];
+    history_record_t rec;
+    int64_t dt;
+    int64_t time_ms = meta->head_time_ms;
+    size_t pos = 0;
+    for (uint32_t i = 0; i < meta->count; i++) {
+        if (pos >= meta->bytes) {
+            history_store_clear(h);
+            return false;
+        }
+        ring_read(h, pos, buf);
+        size_t len = decode_record(buf, &rec, &dt);
+        if (len == 0) {
+            history_store_clear(h);
+            return false;
+        }
+        if (i > 0) {
+            time_ms += dt;
+        }
+        index_append(h, meta->first_id + i, rec.op, pos, time_ms);
+        pos += len;
+    }
+    if (pos != meta->bytes) {
+        history_store_clear(h);
+        return false;
+    }
+    h->used = meta->bytes;
+    h->count = meta->count;
+    h->first_id = meta->first_id;
+    h->next_id = meta->first_id + meta->count;
+    h->head_time_ms = meta->head_time_ms;
+    h->last_time_ms = time_ms;
+    return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 📈 history_stats: สถิติสะสมแบบ O(1) ต่อเรคคอร์ด แยกตาม op และตามช่วงเวลา (bucket)
+// อัปเดตทีละค่าตอนบันทึกประวัติ ตอนถามไม่ต้องไล่ประวัติใหม่
+// bucket เป็น ring: เก็บ buckets ช่องล่าสุด ช่องละ bucket_ms มิลลิวินาที
+// (เช่น 24 × 1 ชั่วโมง = ย้อนหลังได้ 1 วัน) การถามตามเวลาละเอียดระดับ bucket
+
+typedef struct {
+    uint32_t count;
+    double sum;
+    double min;
+    double max;
+    double mean;                    // ค่าเฉลี่ยสะสม (Welford)
+    double m2;                      // ผลรวมกำลังสองของส่วนเบี่ยงเบน (Welford)
+} history_agg_t;
+
+typedef struct {
+    uint8_t ops;                    // op ที่ติดตาม 0..ops-1 (op อื่นนับเฉพาะใน "ทุกชนิด")
+    uint16_t buckets;
+    uint32_t bucket_ms;
+    history_agg_t *total;           // [ops + 1] ตลอดการทำงาน แถวสุดท้าย = ทุกชนิด
+    history_agg_t *slots;           // [buckets][ops + 1]
+    int64_t *slot_index;            // [buckets] หมายเลข bucket (time / bucket_ms) ที่ช่องนั้นเก็บอยู่
+} history_stats_t;
+
+// 🏗️ จองหน่วยความจำ (ops + 1) × (buckets + 1) × sizeof(history_agg_t) ไบต์
+bool history_stats_init(history_stats_t *s, uint8_t ops, uint16_t buckets, uint32_t bucket_ms);
+void history_stats_free(history_stats_t *s);
+void history_stats_clear(history_stats_t *s);
+
+// ➕ เพิ่มค่าหนึ่งค่า (ปกติคือ result ของการคำนวณ)
+void history_stats_add(history_stats_t *s, int op, int64_t time_ms, double value);
+
+// 🔎 สถิติของ op (HISTORY_ANY_OP = ทุกชนิด) ตั้งแต่ bucket ที่มี since_ms ถึง bucket ที่มี now_ms
+// ช่วงที่เก่ากว่า ring จะถูกตัดทิ้ง ใช้เวลาไม่เกิน buckets รอบ ไม่ขึ้นกับจำนวนประวัติ
+void history_stats_query(const history_stats_t *s, int op, int64_t since_ms, int64_t now_ms,
+                         history_agg_t *out);
+
+// สถิติตลอดการทำงานของ op (HISTORY_ANY_OP = ทุกชนิด)
+void history_stats_total(const history_stats_t *s, int op, history_agg_t *out);
+
+// ความแปรปรวน (population) และค่าเบี่ยงเบนมาตรฐาน count == 0 คืนค่า 0
+double history_agg_variance(const history_agg_t *a);
+double history_agg_stddev(const history_agg_t *a);
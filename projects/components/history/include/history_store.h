@@ -0,0 +1,112 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 💾 history_store: ประวัติการคำนวณแบบบีบอัด เก็บในบล็อกหน่วยความจำก้อนเดียว (arena)
+// ขนาด arena กำหนดตอนเริ่มทำงาน วางใน PSRAM ได้ถ้าบอร์ดมี
+// เมื่อเต็ม เรคคอร์ดเก่าที่สุดจะถูกลบออกทีละรายการ (ring buffer)
+//
+// เรคคอร์ดในหน่วยความจำ (ความยาวแปรผัน ปกติ 8-12 ไบต์ แทน 152 ไบต์ของ struct เดิม):
+//   u8      op         รหัสการดำเนินการของแอป
+//   u8      tags       วิธีเก็บค่า 2 บิตต่อค่า: operand1 | operand2 << 2 | result << 4
+//   varint  dt_ms      เวลาห่างจากเรคคอร์ดก่อนหน้า (zigzag)
+//   ค่า × 3             ตาม tag: ไม่มีไบต์ (0.0) / varint ของค่า×100 / f32 / f64
+// id ไม่ถูกเก็บ: เรคคอร์ดต่อกันมี id ต่อเนื่องกันเสมอ
+
+#define HISTORY_RECORD_MAX 42       // 2 + varint 10 + 3 × 10 ไบต์ (กรณีแย่สุด)
+#define HISTORY_RECORD_MIN 3        // op + tags + dt 1 ไบต์ ค่าทั้งหมดเป็น 0
+#define HISTORY_BLOCK 32            // จำนวนเรคคอร์ดต่อ 1 ช่องของดัชนี
+#define HISTORY_ANY_OP (-1)
+
+typedef struct {
+    uint32_t id;
+    uint8_t op;
+    int64_t time_ms;                // เวลาจริง (ms ตั้งแต่ epoch) ตามที่ผู้เรียกส่งมา
+    double operand1;
+    double operand2;
+    double result;
+} history_record_t;
+
+// 🗂️ ดัชนีแบบบล็อก: ทุก HISTORY_BLOCK เรคคอร์ดจำตำแหน่งเริ่ม ช่วงเวลา และชนิด op ที่มีในบล็อก
+// การค้นหาข้ามทั้งบล็อกที่ไม่มี op ที่ต้องการ หรืออยู่นอกช่วงเวลา (ราว 1 ไบต์ต่อเรคคอร์ด)
+typedef struct {
+    size_t pos;                     // ตำแหน่งไบต์ของเรคคอร์ดแรกในบล็อก
+    uint32_t id;                    // id ของเรคคอร์ดแรกในบล็อก
+    uint32_t op_mask;               // บิต (op & 31) ของทุก op ในบล็อก
+    int64_t time_ms;                // เวลาเต็มของเรคคอร์ดแรก
+    int64_t min_time_ms;
+    int64_t max_time_ms;
+} history_block_t;
+
+typedef struct {
+    uint8_t *arena;
+    size_t cap;
+    size_t head;                    // ตำแหน่งไบต์ของเรคคอร์ดเก่าที่สุด
+    size_t used;                    // ไบต์ที่ใช้อยู่ (วนรอบได้)
+    uint32_t count;                 // จำนวนเรคคอร์ดที่ยังอยู่
+    uint32_t first_id;              // id ของเรคคอร์ดที่ head
+    uint32_t next_id;
+    int64_t head_time_ms;           // เวลาเต็มของเรคคอร์ดที่ head (ตัวอื่นเก็บแค่ส่วนต่าง)
+    int64_t last_time_ms;
+    uint32_t evicted;               // จำนวนเรคคอร์ดที่ถูกลบเพราะเต็ม
+    bool external;                  // arena อยู่ใน PSRAM
+    history_block_t *blocks;        // ring ของดัชนีบล็อก (จองพร้อม arena)
+    uint32_t block_cap;
+    uint32_t block_head;
+    uint32_t block_count;
+} history_store_t;
+
+// 🏗️ จอง arena ขนาด arena_bytes ไบต์ (≥ HISTORY_RECORD_MAX)
+// prefer_external = true จะลองจองใน PSRAM ก่อน ถ้าไม่มีจะใช้ RAM ภายใน
+// คืนค่า false ถ้าจองไม่สำเร็จ
+bool history_store_init(history_store_t *h, size_t arena_bytes, bool prefer_external);
+void history_store_free(history_store_t *h);
+
+// ➕ เพิ่มเรคคอร์ดใหม่ คืนค่า id ที่ได้ (เริ่มที่ 1) หรือ 0 ถ้ายังไม่ได้จอง arena
+uint32_t history_store_append(history_store_t *h, uint8_t op, int64_t time_ms,
+                              double operand1, double operand2, double result);
+
+// 🗑️ ลบทั้งหมด (id ยังนับต่อ)
+void history_store_clear(history_store_t *h);
+
+// 🔁 อ่านเรียงจากเก่าไปใหม่
+typedef struct {
+    const history_store_t *h;
+    size_t pos;
+    uint32_t left;
+    uint32_t id;
+    int64_t time_ms;
+    bool fresh;                     // เรคคอร์ดถัดไปคือตัวแรก (ใช้ time_ms ตามที่ตั้งไว้)
+} history_iter_t;
+
+// เริ่มอ่านโดยข้าม skip เรคคอร์ดแรก (เช่น count - 5 = อ่านแค่ 5 รายการล่าสุด)
+// history_iter_next คืนค่า false เมื่อหมด หรือเจอเรคคอร์ดเสีย (varint เกิน 10 ไบต์/tag ผิด)
+void history_iter_begin(const history_store_t *h, history_iter_t *it, uint32_t skip);
+bool history_iter_next(history_iter_t *it, history_record_t *out);
+
+// 🔎 ค้นหาตาม op และช่วงเวลา [since_ms, until_ms) เรียงจากเก่าไปใหม่
+// op = HISTORY_ANY_OP คือทุกชนิด, visit คืนค่า false เพื่อหยุด
+// คืนค่าจำนวนเรคคอร์ดที่ตรงเงื่อนไข (ที่ส่งให้ visit)
+typedef bool (*history_visit_fn)(void *ctx, const history_record_t *rec);
+
+uint32_t history_store_query(const history_store_t *h, int op, int64_t since_ms, int64_t until_ms,
+                             history_visit_fn visit, void *ctx);
+
+// 📤 ส่งออก/นำเข้าทั้ง arena (เช่น เก็บลง NVS แล้วคืนหลังรีเซ็ต)
+// ข้อมูลที่ส่งออกเป็นเรคคอร์ดรูปแบบเดิมเรียงต่อกันตั้งแต่ head (ไม่วนรอบ) + ค่าเมตาด้านล่าง
+typedef struct {
+    uint32_t count;
+    uint32_t first_id;
+    int64_t head_time_ms;
+    uint32_t bytes;                 // ความยาวของข้อมูลเรคคอร์ด
+} history_export_t;
+
+// คัดลอกเรคคอร์ดทั้งหมดลง out (ต้องยาว ≥ h->used) คืนจำนวนไบต์ หรือ 0 ถ้าที่ไม่พอ
+size_t history_store_export(const history_store_t *h, uint8_t *out, size_t cap, history_export_t *meta);
+
+// แทนที่เนื้อหาทั้งหมดด้วยข้อมูลที่ส่งออกไว้ และสร้างดัชนีบล็อกใหม่
+// คืนค่า false (และล้าง store) ถ้าข้อมูลไม่พอดีกับ arena หรือถอดเรคคอร์ดไม่ลงตัว
+// (รวมถึงเรคคอร์ดเสีย เช่น varint ยาวเกิน 10 ไบต์)
+bool history_store_import(history_store_t *h, const uint8_t *data, const history_export_t *meta);
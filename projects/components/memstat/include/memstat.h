@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sdkconfig.h"
+
+// 📏 memstat: หน่วยความจำขณะรัน — stack ที่เหลือต่อ task (high-water mark), heap ตาม caps,
+// ก้อนว่างใหญ่สุด และ static ของแต่ละโมดูล
+// - ถามเมื่อไรก็ได้ด้วย memstat_snapshot แล้วพิมพ์ด้วย memstat_report / memstat_format_compact
+// - หรือให้พิมพ์สรุปบรรทัดเดียวเป็นระยะด้วย memstat_start_periodic (esp_timer)
+// ใช้ลดขนาด stack ของ task อย่างปลอดภัย (ดู "แนะนำ" ในรายงาน) และจับหน่วยความจำที่โตขึ้นระหว่างเวอร์ชัน
+//
+// ลงทะเบียน (watch/add_static) จากหลาย task พร้อมกันได้ ทุกอย่างอยู่หลัง mutex เดียว
+// บน linux target วัด stack ไม่ได้ (task เป็น pthread) และ heap มาจาก mallinfo2 — ค่าที่ไม่รู้คือ MEMSTAT_UNKNOWN
+
+#define MEMSTAT_MAX_TASKS 12
+#define MEMSTAT_MAX_MODULES 12
+#define MEMSTAT_UNKNOWN SIZE_MAX
+#define MEMSTAT_STACK_MARGIN 512    // เหลือน้อยกว่านี้ = เตือน, ขนาดที่แนะนำ = ใช้จริง + margin
+#define MEMSTAT_LINE_MAX 192        // บัฟเฟอร์ที่พอสำหรับ memstat_format_compact
+
+// stack ของ task ที่รัน app_main — ผู้ที่เรียก app_main จาก task ของตัวเอง (เช่น 09_lab_runner)
+// กำหนดค่านี้ตอนคอมไพล์เป็นขนาด stack ของ task นั้นแทน
+#ifndef MEMSTAT_MAIN_STACK_SIZE
+#ifdef CONFIG_ESP_MAIN_TASK_STACK_SIZE
+#define MEMSTAT_MAIN_STACK_SIZE CONFIG_ESP_MAIN_TASK_STACK_SIZE
+#else
+#define MEMSTAT_MAIN_STACK_SIZE 0
+#endif
+#endif
+
+typedef struct {
+    const char *name;
+    size_t stack_size;      // ไบต์ที่จองตอนสร้าง task (0 = ไม่รู้)
+    size_t stack_free;      // ไบต์ที่ไม่เคยถูกใช้ตั้งแต่ task เริ่ม
+    bool finished;          // task จบแล้ว ค่าเป็นของตอนเรียก memstat_task_exit
+} memstat_task_t;
+
+typedef struct {
+    const char *module;
+    size_t bytes;
+} memstat_module_t;
+
+typedef struct {
+    size_t heap_total;      // heap ที่เข้าถึงทีละไบต์ได้ (MALLOC_CAP_8BIT)
+    size_t heap_free;
+    size_t heap_min_free;   // ต่ำสุดตั้งแต่บูต
+    size_t heap_largest;    // ก้อนว่างใหญ่สุด (จองต่อเนื่องได้เท่านี้)
+    size_t static_image;    // .data + .bss ทั้ง image ใน DRAM
+    size_t static_registered;
+    uint8_t n_tasks;
+    uint8_t n_modules;
+    memstat_task_t tasks[MEMSTAT_MAX_TASKS];
+    memstat_module_t modules[MEMSTAT_MAX_MODULES];
+} memstat_snapshot_t;
+
+// 🚀 เรียกก่อนใช้ฟังก์ชันอื่น (เรียกซ้ำและเรียกพร้อมกันจากหลาย task ได้ สร้าง mutex ครั้งเดียว)
+void memstat_init(void);
+
+// 🧱 static ของโมดูล (ชื่อเดิมซ้ำ = บวกเพิ่ม) ชื่อต้องอยู่ตลอดอายุโปรแกรม
+void memstat_add_static(const char *module, size_t bytes);
+#define MEMSTAT_ADD_STATIC(module, var) memstat_add_static(module, sizeof(var))
+
+// 🧵 เฝ้า stack ของ task (NULL = task ที่เรียก, name NULL = ชื่อของ task)
+// task ที่เฝ้าอยู่ต้องเรียก memstat_task_exit ก่อน vTaskDelete(NULL) เพื่อเก็บค่าสุดท้ายไว้
+void memstat_watch_task(TaskHandle_t task, const char *name, size_t stack_size);
+void memstat_task_exit(void);
+
+// 📸 ถามค่า ณ ตอนนี้
+void memstat_snapshot(memstat_snapshot_t *out);
+
+// ✍️ สรุปบรรทัดเดียว เช่น "heap 201k/297k min 198k big 110k | static 9k | stack main 2.1k/3.5k"
+// คืนความยาวเหมือน snprintf
+size_t memstat_format_compact(char *buf, size_t size, const memstat_snapshot_t *s);
+
+// 📊 รายงานเต็มของ snapshot ที่ผู้เรียกถามไว้ (heap, static ต่อโมดูล, stack ต่อ task พร้อมขนาดที่แนะนำ) ผ่าน ESP_LOGI
+// snapshot มีขนาด ~600 ไบต์ ผู้เรียกเลือกเองว่าจะวางไว้ที่ไหน (heap, state ของตัวเอง) ฟังก์ชันไม่มี state ร่วม
+void memstat_report(const char *tag, const memstat_snapshot_t *s);
+
+// ⏲️ พิมพ์สรุปบรรทัดเดียวทุก period_ms และเตือนเมื่อ stack ของ task ใดเหลือต่ำกว่า MEMSTAT_STACK_MARGIN
+esp_err_t memstat_start_periodic(const char *tag, uint32_t period_ms);
+void memstat_stop_periodic(void);
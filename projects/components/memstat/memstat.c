@@ -0,0 +1,244 @@
+#include "memstat.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/semphr.h"
+#if CONFIG_IDF_TARGET_LINUX
+#include <malloc.h>
+#else
+#include "esp_heap_caps.h"
+#endif
+
+typedef struct {
+    TaskHandle_t task;          // NULL เมื่อ task จบแล้ว
+    memstat_task_t info;
+    char task_name[configMAX_TASK_NAME_LEN];    // สำเนาชื่อ task ยังอ่านได้หลัง task ถูกลบ
+} watch_t;
+
+static SemaphoreHandle_t lock;
+static StaticSemaphore_t lock_storage;
+static portMUX_TYPE init_mux = portMUX_INITIALIZER_UNLOCKED;
+static watch_t watches[MEMSTAT_MAX_TASKS];
+static uint8_t n_watches;
+static memstat_module_t modules[MEMSTAT_MAX_MODULES];
+static uint8_t n_modules;
+
+static esp_timer_handle_t periodic_timer;
+static const char *periodic_tag;
+
+#if !CONFIG_IDF_TARGET_LINUX
+// ขอบของ .data/.bss ใน DRAM จาก linker script ของ ESP-IDF
+extern int _data_start, _data_end, _bss_start, _bss_end;
+#endif
+
+void memstat_init(void) {
+    // หลาย task เรียกพร้อมกันได้ (เช่น lab 07/08 บนสอง core ใน 09_lab_runner): ตรวจและสร้างใน critical section
+    // mutex ใช้ storage แบบ static จึงไม่จอง heap ระหว่างถือ spinlock
+    taskENTER_CRITICAL(&init_mux);
+    if (lock == NULL) {
+        lock = xSemaphoreCreateMutexStatic(&lock_storage);
+    }
+    taskEXIT_CRITICAL(&init_mux);
+}
+
+void memstat_add_static(const char *module, size_t bytes) {
+    xSemaphoreTake(lock, portMAX_DELAY);
+    uint8_t i = 0;
+    while (i < n_modules && strcmp(modules[i].module, module) != 0) {
+        i++;
+    }
+    if (i < n_modules) {
+        modules[i].bytes += bytes;
+    } else if (n_modules < MEMSTAT_MAX_MODULES) {
+        modules[n_modules++] = (memstat_module_t){ .module = module, .bytes = bytes };
+    }
+    xSemaphoreGive(lock);
+}
+
+// 📐 ไบต์ที่ไม่เคยถูกใช้ของ stack (ต้องถือ lock และ task ต้องยังอยู่)
+static size_t stack_free(TaskHandle_t task) {
+#if CONFIG_IDF_TARGET_LINUX
+    (void)task;
+    return MEMSTAT_UNKNOWN;
+#else
+    // ESP-IDF นับ stack เป็นไบต์ (StackType_t 1 ไบต์)
+    return uxTaskGetStackHighWaterMark(task) * sizeof(StackType_t);
+#endif
+}
+
+void memstat_watch_task(TaskHandle_t task, const char *name, size_t stack_size) {
+    if (task == NULL) {
+        task = xTaskGetCurrentTaskHandle();
+    }
+    xSemaphoreTake(lock, portMAX_DELAY);
+    if (n_watches < MEMSTAT_MAX_TASKS) {
+        watch_t *w = &watches[n_watches++];
+        *w = (watch_t){
+            .task = task,
+            .info = { .name = name, .stack_size = stack_size, .stack_free = MEMSTAT_UNKNOWN },
+        };
+        if (name == NULL) {
+            strncpy(w->task_name, pcTaskGetName(task), sizeof(w->task_name) - 1);
+            w->info.name = w->task_name;
+        }
+    }
+    xSemaphoreGive(lock);
+}
+
+void memstat_task_exit(void) {
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    xSemaphoreTake(lock, portMAX_DELAY);
+    for (uint8_t i = 0; i < n_watches; i++) {
+        if (watches[i].task == self) {
+            watches[i].info.stack_free = stack_free(self);
+            watches[i].info.finished = true;
+            watches[i].task = NULL;
+        }
+    }
+    xSemaphoreGive(lock);
+}
+
+static void heap_info(memstat_snapshot_t *s) {
+#if CONFIG_IDF_TARGET_LINUX
+    struct mallinfo2 mi = mallinfo2();
+    s->heap_total = mi.arena + mi.hblkhd;
+    s->heap_free = mi.fordblks;
+    s->heap_min_free = MEMSTAT_UNKNOWN;
+    s->heap_largest = MEMSTAT_UNKNOWN;
+    s->static_image = MEMSTAT_UNKNOWN;
+#else
+    s->heap_total = heap_caps_get_total_size(MALLOC_CAP_8BIT);
+    s->heap_free = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    s->heap_min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    s->heap_largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    s->static_image = (size_t)((char *)&_data_end - (char *)&_data_start) +
+                      (size_t)((char *)&_bss_end - (char *)&_bss_start);
+#endif
+}
+
+void memstat_snapshot(memstat_snapshot_t *out) {
+    memset(out, 0, sizeof(*out));
+    heap_info(out);
+    xSemaphoreTake(lock, portMAX_DELAY);
+    for (uint8_t i = 0; i < n_watches; i++) {
+        out->tasks[i] = watches[i].info;
+        if (watches[i].task != NULL) {
+            out->tasks[i].stack_free = stack_free(watches[i].task);
+        }
+    }
+    out->n_tasks = n_watches;
+    memcpy(out->modules, modules, n_modules * sizeof(modules[0]));
+    out->n_modules = n_modules;
+    xSemaphoreGive(lock);
+    for (uint8_t i = 0; i < out->n_modules; i++) {
+        out->static_registered += out->modules[i].bytes;
+    }
+}
+
+// 🔢 ขนาดแบบสั้น: 950, 12.3k, 297k หรือ "-" เมื่อไม่รู้
+static const char *size_str(char buf[12], size_t v) {
+    if (v == MEMSTAT_UNKNOWN) {
+        return "-";
+    }
+    if (v < 1024) {
+        snprintf(buf, 12, "%u", (unsigned)v);
+    } else if (v < 100 * 1024) {
+        snprintf(buf, 12, "%u.%uk", (unsigned)(v / 1024), (unsigned)(v % 1024 * 10 / 1024));
+    } else {
+        snprintf(buf, 12, "%uk", (unsigned)(v / 1024));
+    }
+    return buf;
+}
+
+static size_t stack_used(const memstat_task_t *t) {
+    if (t->stack_free == MEMSTAT_UNKNOWN || t->stack_size == 0 || t->stack_free > t->stack_size) {
+        return MEMSTAT_UNKNOWN;
+    }
+    return t->stack_size - t->stack_free;
+}
+
+size_t memstat_format_compact(char *buf, size_t size, const memstat_snapshot_t *s) {
+    char a[12], b[12], c[12], d[12], e[12];
+    int n = snprintf(buf, size, "heap %s/%s min %s big %s | static %s",
+                     size_str(a, s->heap_free), size_str(b, s->heap_total),
+                     size_str(c, s->heap_min_free), size_str(d, s->heap_largest),
+                     size_str(e, s->static_registered));
+    for (uint8_t i = 0; i < s->n_tasks && n >= 0; i++) {
+        const memstat_task_t *t = &s->tasks[i];
+        size_t at = (size_t)n < size ? (size_t)n : size;
+        n += snprintf(buf + at, size - at, "%s %s %s/%s", i == 0 ? " | stack" : ",", t->name,
+                      size_str(a, stack_used(t)), size_str(b, t->stack_size ? t->stack_size : MEMSTAT_UNKNOWN));
+    }
+    return n < 0 ? 0 : (size_t)n;
+}
+
+void memstat_report(const char *tag, const memstat_snapshot_t *s) {
+    char a[12], b[12], c[12], d[12];
+
+    ESP_LOGI(tag, "📏 heap: ว่าง %s จาก %s ไบต์ | ต่ำสุดตั้งแต่บูต %s | ก้อนว่างใหญ่สุด %s",
+             size_str(a, s->heap_free), size_str(b, s->heap_total), size_str(c, s->heap_min_free),
+             size_str(d, s->heap_largest));
+    ESP_LOGI(tag, "📏 static: image %s ไบต์ | ลงทะเบียน %s ไบต์", size_str(a, s->static_image),
+             size_str(b, s->static_registered));
+    for (uint8_t i = 0; i < s->n_modules; i++) {
+        ESP_LOGI(tag, "📏    %-16s %8u ไบต์", s->modules[i].module, (unsigned)s->modules[i].bytes);
+    }
+    for (uint8_t i = 0; i < s->n_tasks; i++) {
+        const memstat_task_t *t = &s->tasks[i];
+        size_t used = stack_used(t);
+        if (used == MEMSTAT_UNKNOWN) {
+            ESP_LOGI(tag, "📏 stack %-12s ขนาด %s เหลือ %s ไบต์", t->name,
+                     size_str(a, t->stack_size ? t->stack_size : MEMSTAT_UNKNOWN), size_str(b, t->stack_free));
+            continue;
+        }
+        // ปัดขึ้นเป็นทวีคูณ 256 ไบต์ เผื่อ MEMSTAT_STACK_MARGIN สำหรับทางที่เดโมยังไม่ได้เดิน
+        size_t suggest = (used + MEMSTAT_STACK_MARGIN + 255) / 256 * 256;
+        ESP_LOGI(tag, "📏 stack %-12s ใช้ %5u จาก %5u ไบต์ (เหลือ %u)%s → แนะนำ %u", t->name,
+                 (unsigned)used, (unsigned)t->stack_size, (unsigned)t->stack_free,
+                 t->finished ? " [จบแล้ว]" : "", (unsigned)suggest);
+    }
+}
+
+static void periodic_cb(void *arg) {
+    static memstat_snapshot_t s;    // callback ของ esp_timer ไม่ซ้อนกัน ใช้ตัวเดียวได้
+    static char line[MEMSTAT_LINE_MAX];
+    (void)arg;
+
+    memstat_snapshot(&s);
+    memstat_format_compact(line, sizeof(line), &s);
+    ESP_LOGI(periodic_tag, "📏 %s", line);
+    for (uint8_t i = 0; i < s.n_tasks; i++) {
+        if (!s.tasks[i].finished && s.tasks[i].stack_free < MEMSTAT_STACK_MARGIN) {
+            ESP_LOGW(periodic_tag, "⚠️ stack ของ %s เหลือ %u ไบต์", s.tasks[i].name,
+                     (unsigned)s.tasks[i].stack_free);
+        }
+    }
+}
+
+esp_err_t memstat_start_periodic(const char *tag, uint32_t period_ms) {
+    if (periodic_timer != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    const esp_timer_create_args_t args = { .callback = periodic_cb, .name = "memstat" };
+    esp_err_t err = esp_timer_create(&args, &periodic_timer);
+    if (err != ESP_OK) {
+        return err;
+    }
+    periodic_tag = tag;
+    err = esp_timer_start_periodic(periodic_timer, (uint64_t)period_ms * 1000);
+    if (err != ESP_OK) {
+        esp_timer_delete(periodic_timer);
+        periodic_timer = NULL;
+    }
+    return err;
+}
+
+void memstat_stop_periodic(void) {
+    if (periodic_timer != NULL) {
+        esp_timer_stop(periodic_timer);
+        esp_timer_delete(periodic_timer);
+        periodic_timer = NULL;
+    }
+}
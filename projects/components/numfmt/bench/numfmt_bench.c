@@ -0,0 +1,139 @@
+// 🖥️ benchmark ของ numfmt บนเครื่อง host — พิมพ์ CSV ออก stdout
+// เทียบ snprintf("%.2f") / "%.17g" กับ numfmt_fixed / numfmt_shortest บนค่าชุดเดียวกัน
+// ก่อนวัดจะตรวจว่าผลตรงกับ snprintf ทุกตัว และ shortest อ่านกลับด้วย strtod ได้ค่าเดิม
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "numfmt.h"
+
+#define VALUES 256
+#define CHECKS 200000
+
+static double values[VALUES];
+static volatile size_t sink;
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return rng;
+}
+
+// 🎲 ค่าแบบที่เครื่องคิดเลขเจอบ่อย: เงิน (ทศนิยม 2-3 ตำแหน่ง) และผลหาร/รากที่ใช้ครบ 17 หลัก
+static double sample(uint64_t x) {
+    switch (x % 4) {
+        case 0:  return (double)(x >> 8 & 0xFFFFFF) / 100.0;
+        case 1:  return (double)(x >> 8 & 0xFFFFF) / 1000.0;
+        case 2:  return (double)(x >> 8 & 0xFFFF) / 7.0;
+        default: return (double)(int64_t)(x >> 12) / 1e9 - 2e6;
+    }
+}
+
+static int self_check(void) {
+    char a[NUMFMT_BUF];
+    char b[NUMFMT_BUF];
+    for (int i = 0; i < CHECKS; i++) {
+        double v = sample(next());
+        int d = i % 7;
+        numfmt_fixed(a, sizeof(a), v, d, 0);
+        snprintf(b, sizeof(b), "%.*f", d, v);
+        if (strcmp(a, b) != 0) {
+            fprintf(stderr, "fixed mismatch: %.17g d=%d numfmt=%s printf=%s\n", v, d, a, b);
+            return 1;
+        }
+        numfmt_shortest(a, sizeof(a), v, 0);
+        if (strtod(a, NULL) != v) {
+            fprintf(stderr, "shortest does not round-trip: %.17g -> %s\n", v, a);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void bench_fixed_printf(void *ctx, uint32_t iters) {
+    (void)ctx;
+    char out[NUMFMT_BUF];
+    size_t acc = 0;
+    for (uint32_t k = 0; k < iters; k++) {
+        acc += (size_t)snprintf(out, sizeof(out), "%.2f", values[k % VALUES]);
+    }
+    sink = acc;
+}
+
+static void bench_fixed_numfmt(void *ctx, uint32_t iters) {
+    (void)ctx;
+    char out[NUMFMT_BUF];
+    size_t acc = 0;
+    for (uint32_t k = 0; k < iters; k++) {
+        acc += numfmt_fixed(out, sizeof(out), values[k % VALUES], 2, 0);
+    }
+    sink = acc;
+}
+
+static void bench_fixed_numfmt_group(void *ctx, uint32_t iters) {
+    (void)ctx;
+    char out[NUMFMT_BUF];
+    size_t acc = 0;
+    for (uint32_t k = 0; k < iters; k++) {
+        acc += numfmt_fixed(out, sizeof(out), values[k % VALUES], 2, NUMFMT_GROUP);
+    }
+    sink = acc;
+}
+
+// 🐢 วิธีเดิมของ round-trip: %.15g ก่อน ถ้าอ่านกลับไม่ตรงค่อยเพิ่มเป็น 16, 17
+static void bench_shortest_printf(void *ctx, uint32_t iters) {
+    (void)ctx;
+    char out[NUMFMT_BUF];
+    size_t acc = 0;
+    for (uint32_t k = 0; k < iters; k++) {
+        double v = values[k % VALUES];
+        int prec = 15;
+        int n;
+        do {
+            n = snprintf(out, sizeof(out), "%.*g", prec, v);
+        } while (strtod(out, NULL) != v && ++prec <= 17);
+        acc += (size_t)n;
+    }
+    sink = acc;
+}
+
+static void bench_shortest_numfmt(void *ctx, uint32_t iters) {
+    (void)ctx;
+    char out[NUMFMT_BUF];
+    size_t acc = 0;
+    for (uint32_t k = 0; k < iters; k++) {
+        acc += numfmt_shortest(out, sizeof(out), values[k % VALUES], 0);
+    }
+    sink = acc;
+}
+
+int main(void) {
+    bench_config_t cfg = BENCH_CONFIG_DEFAULT;
+    bench_result_t r;
+
+    if (self_check() != 0) {
+        return 1;
+    }
+    for (int i = 0; i < VALUES; i++) {
+        values[i] = sample(next());
+    }
+
+    static const bench_case_t cases[] = {
+        { .name = "fixed2_snprintf", .fn = bench_fixed_printf },
+        { .name = "fixed2_numfmt", .fn = bench_fixed_numfmt },
+        { .name = "fixed2_numfmt_group", .fn = bench_fixed_numfmt_group },
+        { .name = "shortest_snprintf_strtod", .fn = bench_shortest_printf },
+        { .name = "shortest_numfmt", .fn = bench_shortest_numfmt },
+    };
+    cfg.inner_iters = VALUES;
+    bench_calibrate(&cfg);
+    bench_print_csv_header(stdout);
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        bench_run(&cases[i], &cfg, &r);
+        bench_print_csv(stdout, &r);
+    }
+    return 0;
+}
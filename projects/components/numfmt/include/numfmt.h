@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stddef.h>
+
+// 🔢 numfmt: จัดรูปตัวเลข double ลงบัฟเฟอร์ของผู้เรียก แทน snprintf("%.2f") / "%.15g"
+// ทางด่วนใช้การคูณ + จำนวนเต็มล้วน (ไม่ผ่าน printf ของ newlib ที่ช้าและกิน stack)
+// ค่าที่อยู่นอกทางด่วน (ใหญ่/เล็กมาก) ตกไปใช้ snprintf ผลจึงถูกต้องเสมอ
+//
+// - numfmt_fixed:    ทศนิยมคงที่ ปัดเศษตรงกับ printf ทุกบิต (ดูค่าจริงของ double ไม่ใช่ค่าที่คูณแล้ว)
+// - numfmt_shortest: ตัวเลขสั้นที่สุดที่อ่านกลับ (strtod) ได้ค่าเดิมพอดี แบบ Grisu:
+//                    ลองทศนิยมทีละหลักแล้วตรวจด้วยการหารที่ปัดเศษถูกต้องตาม IEEE ไม่สำเร็จจึงใช้ %g ที่สั้นที่สุด
+
+#define NUMFMT_BUF 64               // ขนาดบัฟเฟอร์ที่แนะนำ (พอสำหรับทุกค่าในทางด่วน)
+#define NUMFMT_MAX_DECIMALS 17
+
+#define NUMFMT_GROUP        0x01    // คั่นหลักพันด้วย ',' เช่น 1,234,567.89
+#define NUMFMT_THAI_DIGITS  0x02    // ใช้เลขไทย ๐-๙ (ตัวละ 3 ไบต์ UTF-8)
+#define NUMFMT_PLUS         0x04    // ใส่ '+' หน้าค่าบวก
+
+// คืนความยาวของข้อความเต็ม (ไม่รวม '\0') เหมือน snprintf
+// ถ้ายาวเกิน size - 1 จะถูกตัด แต่ปิดด้วย '\0' เสมอ (size > 0)
+size_t numfmt_fixed(char *buf, size_t size, double v, int decimals, unsigned flags);
+size_t numfmt_shortest(char *buf, size_t size, double v, unsigned flags);
+
+// ✍️ แบบคืน buf เพื่อใช้เป็น argument ของ %s ได้ทันที (buf ต้องยาว NUMFMT_BUF)
+static inline const char *numfmt_fixed_str(char *buf, double v, int decimals, unsigned flags) {
+    numfmt_fixed(buf, NUMFMT_BUF, v, decimals, flags);
+    return buf;
+}
+
+static inline const char *numfmt_shortest_str(char *buf, double v, unsigned flags) {
+    numfmt_shortest(buf, NUMFMT_BUF, v, flags);
+    return buf;
+}
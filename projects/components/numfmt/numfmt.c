@@ -0,0 +1,180 @@
+#include "numfmt.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TMP_SIZE 96
+#define FAST_LIMIT 0x1p53           // ค่าที่คูณแล้วต้องต่ำกว่านี้ (จำนวนเต็มทุกตัวแทนได้พอดีใน double)
+#define SHORTEST_MIN 1e-4           // ช่วงเดียวกับที่ %g ใช้รูปทศนิยม (นอกช่วงเป็น e±xx)
+#define SHORTEST_MAX 1e15
+
+// 10^0..10^22 แทนได้พอดีใน double
+static const double pow10_tab[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+// 📤 คัดลอกผลลงบัฟเฟอร์ของผู้เรียกแบบ snprintf (ตัดถ้าไม่พอ คืนความยาวเต็ม)
+static size_t emit(char *buf, size_t size, const char *s, size_t len) {
+    if (size > 0) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(buf, s, n);
+        buf[n] = '\0';
+    }
+    return len;
+}
+
+static size_t emit_special(char *buf, size_t size, double v) {
+    bool neg = signbit(v);
+    const char *s = isnan(v) ? (neg ? "-nan" : "nan") : (neg ? "-inf" : "inf");
+    return emit(buf, size, s, strlen(s));
+}
+
+// ✍️ เขียนจำนวนเต็ม n (แทนค่า n / 10^decimals) จากท้ายบัฟเฟอร์ย้อนมา คืนตำแหน่งเริ่ม
+// ใช้การหาร 32 บิตเมื่อค่าพอ (เร็วกว่าการหาร 64 บิตด้วยซอฟต์แวร์บน ESP32 มาก)
+static char *write_digits(char *end, uint64_t n, int decimals, bool neg, unsigned flags) {
+    char *p = end;
+    bool thai = flags & NUMFMT_THAI_DIGITS;
+    int pos = 0;        // หลักที่ (นับจากขวา เริ่มจากทศนิยม)
+    int group = 0;
+
+    do {
+        unsigned digit;
+        if (n <= UINT32_MAX) {
+            uint32_t n32 = (uint32_t)n;
+            digit = n32 % 10;
+            n = n32 / 10;
+        } else {
+            digit = (unsigned)(n % 10);
+            n /= 10;
+        }
+        if (pos == decimals && decimals > 0) {
+            *--p = '.';
+        }
+        if (pos >= decimals) {
+            if (group == 3 && (flags & NUMFMT_GROUP)) {
+                *--p = ',';
+                group = 0;
+            }
+            group++;
+        }
+        if (thai) {
+            *--p = (char)(0x90 + digit);    // U+0E50 + digit = E0 B9 (90+digit)
+            *--p = (char)0xB9;
+            *--p = (char)0xE0;
+        } else {
+            *--p = (char)('0' + digit);
+        }
+        pos++;
+    } while (n != 0 || pos <= decimals);
+
+    if (neg) {
+        *--p = '-';
+    } else if (flags & NUMFMT_PLUS) {
+        *--p = '+';
+    }
+    return p;
+}
+
+// 🐢 นอกทางด่วน: ใช้ snprintf (ไม่คั่นหลักพันและไม่แปลงเป็นเลขไทย มีแค่ NUMFMT_PLUS)
+static size_t fallback(char *buf, size_t size, const char *fmt, int prec, double v, unsigned flags) {
+    char tmp[TMP_SIZE];
+    int off = 0;
+    if ((flags & NUMFMT_PLUS) && !signbit(v)) {
+        tmp[off++] = '+';
+    }
+    int n = snprintf(tmp + off, sizeof(tmp) - off, fmt, prec, v);
+    if (n < 0) {
+        return emit(buf, size, "", 0);
+    }
+    if ((size_t)(n + off) >= sizeof(tmp)) {
+        // ยาวกว่า tmp (เช่น %.2f ของ 1e300): เขียนตรงลงบัฟเฟอร์ของผู้เรียกเลย
+        return (size_t)snprintf(buf, size, fmt, prec, v);
+    }
+    return emit(buf, size, tmp, (size_t)(n + off));
+}
+
+static bool roundtrips(char tmp[TMP_SIZE], int prec, double v) {
+    snprintf(tmp, TMP_SIZE, "%.*g", prec, v);
+    return strtod(tmp, NULL) == v;
+}
+
+size_t numfmt_fixed(char *buf, size_t size, double v, int decimals, unsigned flags) {
+    if (!isfinite(v)) {
+        return emit_special(buf, size, v);
+    }
+    if (decimals < 0) {
+        decimals = 0;
+    }
+    double a = fabs(v);
+    double scaled = decimals <= NUMFMT_MAX_DECIMALS ? a * pow10_tab[decimals] : FAST_LIMIT;
+    if (!(scaled < FAST_LIMIT)) {
+        return fallback(buf, size, "%.*f", decimals, v, flags);
+    }
+
+    // ปัดเศษครึ่งหนึ่งไปหาคู่ตามค่าจริง a × 10^d (เหมือน printf)
+    // scaled มีความคลาดเคลื่อนจากการคูณไม่เกินครึ่ง ulp จึงตัดสินจาก frac ได้ทันที
+    // ยกเว้นเมื่อ frac ใกล้ 0.5 มาก ค่อยหาเศษที่หายไปด้วย fma (เกิดไม่บ่อย)
+    double r = floor(scaled);
+    double t = (scaled - r) - 0.5;      // ลบแบบไม่มีการปัดเมื่อ frac ≥ 0.25
+    bool up;
+    if (fabs(t) > scaled * 0x1p-52) {
+        up = t > 0;
+    } else {
+        double err = fma(a, pow10_tab[decimals], -scaled);
+        up = t > -err || (t == -err && fmod(r, 2.0) != 0.0);
+    }
+    uint64_t n = (uint64_t)r + (up ? 1 : 0);
+
+    char tmp[TMP_SIZE];
+    char *end = tmp + sizeof(tmp);
+    char *p = write_digits(end, n, decimals, signbit(v), flags);
+    return emit(buf, size, p, (size_t)(end - p));
+}
+
+size_t numfmt_shortest(char *buf, size_t size, double v, unsigned flags) {
+    if (!isfinite(v)) {
+        return emit_special(buf, size, v);
+    }
+    double a = fabs(v);
+    char tmp[TMP_SIZE];
+    char *end = tmp + sizeof(tmp);
+
+    if (a == 0.0) {
+        char *p = write_digits(end, 0, 0, signbit(v), flags);
+        return emit(buf, size, p, (size_t)(end - p));
+    }
+    if (a >= SHORTEST_MIN && a < SHORTEST_MAX) {
+        // r / 10^d ใน IEEE ปัดเศษถูกต้อง = ค่าที่ strtod อ่านข้อความ "r×10^-d" ได้
+        // จึงตรวจ round-trip ได้ด้วยการหารครั้งเดียว ไม่ต้องแปลงกลับจากข้อความ
+        for (int d = 0; d <= NUMFMT_MAX_DECIMALS; d++) {
+            double scaled = a * pow10_tab[d];
+            if (!(scaled < FAST_LIMIT)) {
+                break;
+            }
+            double r = nearbyint(scaled);
+            if (r / pow10_tab[d] == a) {
+                char *p = write_digits(end, (uint64_t)r, d, signbit(v), flags);
+                return emit(buf, size, p, (size_t)(end - p));
+            }
+        }
+    }
+
+    // 🐢 ต้องใช้ 16-17 หลัก หรือค่าอยู่นอกช่วง: หาความแม่นยำน้อยที่สุดที่อ่านกลับได้ค่าเดิม
+    // (ถ้า p หลักอ่านกลับได้ p+1 หลักก็ได้เสมอ จึงไล่ลงจาก 15 หรือขึ้นไปถึง 17)
+    int prec = 15;
+    if (roundtrips(tmp, prec, v)) {
+        while (prec > 1 && roundtrips(tmp, prec - 1, v)) {
+            prec--;
+        }
+    } else {
+        while (prec < 17 && !roundtrips(tmp, prec, v)) {
+            prec++;
+        }
+    }
+    return fallback(buf, size, "%.*g", prec, v, flags);
+}
@@ -0,0 +1,192 @@
+// 🖥️ benchmark ของ pricing บนเครื่อง host — พิมพ์ CSV ออก stdout
+// วัดเวลาคิดเงินตะกร้า 10 บรรทัดเมื่อจำนวนกฎเพิ่มขึ้น เทียบกับการไล่หากฎทุกข้อต่อบรรทัด (naive)
+// ตาราง compile แล้วควรได้เวลาเท่าเดิมทุกขนาด ส่วน naive โตตามจำนวนกฎ
+#include <stdio.h>
+#include "bench.h"
+#include "pricing.h"
+
+#define CART_LINES 10
+#define MAX_RULES 512
+
+typedef struct {
+    const pricing_rule_t *rules;
+    size_t n;
+    pricing_table_t table;
+} rule_set_t;
+
+static pricing_rule_t rules[MAX_RULES];
+static pricing_line_t cart[CART_LINES];
+static volatile int64_t sink;
+
+// 🎲 กฎสุ่มแบบกำหนดได้: ส่วนลดหมวด/ราคาสมาชิก/ซื้อ X แถม Y + ขั้น VAT และส่วนลดตะกร้าอย่างละ 2 ข้อ
+static void fill_inputs(void) {
+    uint32_t x = 2463534242u;   // xorshift32 — ได้ข้อมูลชุดเดิมทุกครั้ง
+    rules[0] = (pricing_rule_t)PRICING_VAT_TIER(3, 0, 0);
+    rules[1] = (pricing_rule_t)PRICING_VAT_TIER(3, 700, 100000);
+    rules[2] = (pricing_rule_t)PRICING_CART_DISCOUNT(500, 20000, 0);
+    rules[3] = (pricing_rule_t)PRICING_CART_DISCOUNT(1000, 50000, PRICING_MEMBER_ONLY);
+    for (int i = 4; i < MAX_RULES; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        uint32_t flags = (x >> 20) & PRICING_MEMBER_ONLY;
+        switch (x % 3) {
+            case 0:
+                rules[i] = (pricing_rule_t)PRICING_CATEGORY_DISCOUNT((x >> 8) % PRICING_MAX_CATEGORIES,
+                                                                     (x >> 12) % 3000, flags);
+                break;
+            case 1:
+                rules[i] = (pricing_rule_t)PRICING_MEMBER_PRICE((x >> 8) % PRICING_MAX_PRODUCTS,
+                                                                1000 + (x >> 16) % 5000);
+                break;
+            default:
+                rules[i] = (pricing_rule_t)PRICING_BUY_X_GET_Y((x >> 8) % PRICING_MAX_PRODUCTS,
+                                                               1 + (x >> 16) % 3, 1, flags);
+                break;
+        }
+    }
+    for (int i = 0; i < CART_LINES; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        cart[i].product = (uint16_t)(x % PRICING_MAX_PRODUCTS);
+        cart[i].category = (uint8_t)((x >> 8) % PRICING_MAX_CATEGORIES);
+        cart[i].unit_price = 1000 + (x >> 12) % 9000;
+        cart[i].quantity = 1 + (x >> 24) % 6;
+    }
+    // รหัสแคตตาล็อกเกินตารางกฎ (0..65535): ต้องคิดเงินได้ด้วยส่วนลดหมวดและ VAT เท่านั้น
+    cart[CART_LINES - 2].product = PRICING_MAX_PRODUCTS + 44;
+    cart[CART_LINES - 1].product = 40000;
+}
+
+static inline int64_t percent_of(int64_t amount, uint32_t bp) {
+    return (amount * bp + PRICING_BP_FULL / 2) / PRICING_BP_FULL;
+}
+
+// 🐢 แบบเดิม: ไล่กฎทุกข้อต่อบรรทัด (ความหมายเดียวกับตารางที่ compile แล้ว)
+static int64_t naive_checkout(const pricing_rule_t *r, size_t n, const pricing_line_t *lines,
+                              size_t count, bool member, uint16_t default_vat_bp) {
+    int64_t category_net[PRICING_MAX_CATEGORIES] = {0};
+    int64_t after_lines = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const pricing_line_t *l = &lines[i];
+        uint32_t unit = l->unit_price, buy = 0, get = 0, bp = 0;
+        for (size_t k = 0; k < n; k++) {
+            bool allowed = member || !(r[k].flags & PRICING_MEMBER_ONLY);
+            if (!allowed) {
+                continue;
+            }
+            if (r[k].kind == PRICING_RULE_MEMBER_PRICE && r[k].target == l->product && r[k].amount < unit) {
+                unit = r[k].amount;
+            } else if (r[k].kind == PRICING_RULE_BUY_X_GET_Y && r[k].target == l->product &&
+                       (buy == 0 || r[k].limit * (buy + get) > get * (r[k].amount + r[k].limit))) {
+                buy = r[k].amount;
+                get = r[k].limit;
+            } else if (r[k].kind == PRICING_RULE_CATEGORY_DISCOUNT && r[k].target == l->category &&
+                       r[k].amount > bp) {
+                bp = r[k].amount;
+            }
+        }
+        uint32_t free_items = 0;
+        if (buy) {
+            uint32_t rest = l->quantity % (buy + get);
+            free_items = l->quantity / (buy + get) * get + (rest > buy ? rest - buy : 0);
+        }
+        int64_t amount = (int64_t)unit * (l->quantity - free_items);
+        int64_t net = amount - percent_of(amount, bp);
+        category_net[l->category] += net;
+        after_lines += net;
+    }
+
+    uint32_t cart_bp = 0;
+    for (size_t k = 0; k < n; k++) {
+        if (r[k].kind == PRICING_RULE_CART_DISCOUNT && r[k].limit <= after_lines &&
+            (member || !(r[k].flags & PRICING_MEMBER_ONLY)) && r[k].amount > cart_bp) {
+            cart_bp = r[k].amount;
+        }
+    }
+
+    int64_t vat_raw = 0;
+    for (int c = 0; c < PRICING_MAX_CATEGORIES; c++) {
+        if (category_net[c] == 0) {
+            continue;
+        }
+        int64_t base = category_net[c] - percent_of(category_net[c], cart_bp);
+        int64_t best_min = -1;
+        uint32_t vat_bp = default_vat_bp;
+        for (size_t k = 0; k < n; k++) {
+            if (r[k].kind == PRICING_RULE_VAT_TIER && r[k].target == c && r[k].limit <= base &&
+                ((int64_t)r[k].limit > best_min || (r[k].limit == best_min && r[k].amount < vat_bp))) {
+                best_min = r[k].limit;
+                vat_bp = r[k].amount;
+            }
+        }
+        vat_raw += category_net[c] * (PRICING_BP_FULL - cart_bp) * vat_bp;
+    }
+    int64_t net = after_lines - percent_of(after_lines, cart_bp);
+    int64_t total = net + (vat_raw + 50000000) / 100000000;
+    return total;
+}
+
+static void bench_compiled(void *ctx, uint32_t iters) {
+    const rule_set_t *s = ctx;
+    pricing_totals_t t;
+    int64_t acc = 0;
+    for (uint32_t k = 0; k < iters; k++) {
+        pricing_checkout(&s->table, cart, CART_LINES, k & 1, &t, NULL);
+        acc += t.total;
+    }
+    sink = acc;
+}
+
+static void bench_naive(void *ctx, uint32_t iters) {
+    const rule_set_t *s = ctx;
+    int64_t acc = 0;
+    for (uint32_t k = 0; k < iters; k++) {
+        acc += naive_checkout(s->rules, s->n, cart, CART_LINES, k & 1, 700);
+    }
+    sink = acc;
+}
+
+int main(void) {
+    static const size_t sizes[] = { 8, 32, 128, 512 };
+    static rule_set_t sets[4];
+    static char names[8][32];
+    bench_config_t cfg = BENCH_CONFIG_DEFAULT;
+    bench_result_t r;
+
+    fill_inputs();
+    for (int i = 0; i < 4; i++) {
+        sets[i].rules = rules;
+        sets[i].n = sizes[i];
+        if (pricing_compile(&sets[i].table, rules, sizes[i], 700) != PRICING_OK) {
+            fprintf(stderr, "compile failed at rule %u\n", sets[i].table.bad_rule);
+            return 1;
+        }
+        // ✅ ทั้งสองแบบต้องได้ยอดเท่ากันทุกสตางค์
+        for (int member = 0; member < 2; member++) {
+            pricing_totals_t t;
+            if (pricing_checkout(&sets[i].table, cart, CART_LINES, member, &t, NULL) != PRICING_OK) {
+                fprintf(stderr, "checkout failed: %zu rules member=%d\n", sizes[i], member);
+                return 1;
+            }
+            int64_t naive = naive_checkout(rules, sizes[i], cart, CART_LINES, member, 700);
+            if (t.total != naive) {
+                fprintf(stderr, "mismatch: %zu rules member=%d compiled=%lld naive=%lld\n",
+                        sizes[i], member, (long long)t.total, (long long)naive);
+                return 1;
+            }
+        }
+    }
+
+    bench_calibrate(&cfg);
+    bench_print_csv_header(stdout);
+    for (int i = 0; i < 4; i++) {
+        snprintf(names[2 * i], sizeof(names[0]), "pricing_compiled_r%zu", sizes[i]);
+        snprintf(names[2 * i + 1], sizeof(names[0]), "pricing_naive_r%zu", sizes[i]);
+        bench_case_t compiled = { .name = names[2 * i], .fn = bench_compiled, .ctx = &sets[i] };
+        bench_case_t naive = { .name = names[2 * i + 1], .fn = bench_naive, .ctx = &sets[i] };
+        bench_run(&compiled, &cfg, &r);
+        bench_print_csv(stdout, &r);
+        bench_run(&naive, &cfg, &r);
+        bench_print_csv(stdout, &r);
+    }
+    return 0;
+}
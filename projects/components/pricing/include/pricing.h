@@ -0,0 +1,121 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 🏷️ pricing: กฎราคา/โปรโมชันของหน้าร้าน เงินทุกค่าเป็นสตางค์ (จำนวนเต็ม)
+// ขั้นตอน: รายการกฎ (pricing_rule_t) → pricing_compile() ครั้งเดียว → ตารางตัดสินใจแบบแบน
+// แล้ว pricing_checkout() ไล่ตะกร้ารอบเดียว ค้นตารางด้วยดัชนีตรงๆ ไม่วนหากฎ
+// เวลาคิดเงินจึงไม่ขึ้นกับจำนวนกฎ (กฎหลายร้อยข้อได้ตารางขนาดเท่าเดิม)
+//
+// ลำดับการคิดต่อบรรทัด: ราคาสมาชิก → ซื้อ X แถม Y → ส่วนลดตามหมวด
+// จากนั้นส่วนลดทั้งตะกร้า (ขั้นบันไดตามยอด) เฉลี่ยลงแต่ละหมวด แล้วคิด VAT ตามขั้นของแต่ละหมวด
+// เฉพาะบรรทัดที่ต้องเสีย VAT (vat_free = false) — สถานะ VAT ของสินค้ามาจากผู้เรียก กฎ VAT กำหนดแค่อัตรา
+// กฎหลายข้อที่ชนกัน ตารางเก็บข้อที่ลูกค้าได้ประโยชน์สูงสุด
+
+#ifndef PRICING_MAX_PRODUCTS
+#define PRICING_MAX_PRODUCTS 256    // รหัสสินค้าที่มีกฎได้ 0..N-1 (ดัชนีตรงของตาราง)
+// สินค้าในตะกร้าใช้รหัสใดก็ได้ (เช่นรหัสแคตตาล็อกถึง 65535) รหัสที่เกินตารางถือว่าไม่มีกฎสินค้า
+// แต่ยังคิดส่วนลดหมวดและ VAT ตามปกติ
+#endif
+#define PRICING_MAX_CATEGORIES 16
+#define PRICING_VAT_TIERS 4         // ขั้น VAT ต่อหมวด
+#define PRICING_CART_TIERS 4        // ขั้นส่วนลดทั้งตะกร้า
+#define PRICING_BP_FULL 10000       // อัตราเป็น basis point (100% = 10000)
+
+typedef enum {
+    PRICING_OK = 0,
+    PRICING_ERR_BAD_RULE,           // ชนิด/เป้าหมาย/อัตราของกฎไม่ถูกต้อง
+    PRICING_ERR_TOO_MANY_TIERS,     // ขั้น VAT หรือขั้นส่วนลดตะกร้าเกินที่ตารางรองรับ
+    PRICING_ERR_BAD_LINE,           // หมวดของบรรทัดในตะกร้าอยู่นอกตาราง
+    PRICING_ERR_OVERFLOW,           // ยอดเงินของตะกร้าเกินช่วง int64 (สตางค์)
+} pricing_err_t;
+
+typedef enum {
+    PRICING_RULE_CATEGORY_DISCOUNT = 1, // target = หมวด, amount = bp
+    PRICING_RULE_MEMBER_PRICE,          // target = สินค้า, amount = ราคาสมาชิก (สตางค์)
+    PRICING_RULE_BUY_X_GET_Y,           // target = สินค้า, amount = ซื้อ X, limit = แถม Y
+    PRICING_RULE_VAT_TIER,              // target = หมวด, amount = bp เมื่อยอดหมวด ≥ limit
+    PRICING_RULE_CART_DISCOUNT,         // amount = bp เมื่อยอดตะกร้า ≥ limit
+} pricing_rule_kind_t;
+
+#define PRICING_MEMBER_ONLY 0x01    // flags: ใช้เฉพาะลูกค้าสมาชิก
+
+// 📜 กฎหนึ่งข้อ ขนาดคงที่ 12 ไบต์
+typedef struct {
+    uint8_t kind;                   // pricing_rule_kind_t
+    uint8_t flags;
+    uint16_t target;
+    uint32_t amount;
+    uint32_t limit;
+} pricing_rule_t;
+
+#define PRICING_CATEGORY_DISCOUNT(cat, bp, fl) \
+    { .kind = PRICING_RULE_CATEGORY_DISCOUNT, .flags = (fl), .target = (cat), .amount = (bp) }
+#define PRICING_MEMBER_PRICE(product, satang) \
+    { .kind = PRICING_RULE_MEMBER_PRICE, .flags = PRICING_MEMBER_ONLY, .target = (product), .amount = (satang) }
+#define PRICING_BUY_X_GET_Y(product, x, y, fl) \
+    { .kind = PRICING_RULE_BUY_X_GET_Y, .flags = (fl), .target = (product), .amount = (x), .limit = (y) }
+#define PRICING_VAT_TIER(cat, bp, min_satang) \
+    { .kind = PRICING_RULE_VAT_TIER, .target = (cat), .amount = (bp), .limit = (min_satang) }
+#define PRICING_CART_DISCOUNT(bp, min_satang, fl) \
+    { .kind = PRICING_RULE_CART_DISCOUNT, .flags = (fl), .amount = (bp), .limit = (min_satang) }
+
+// 📐 ตารางตัดสินใจ (สร้างด้วย pricing_compile เท่านั้น)
+// ช่อง [0] = ลูกค้าทั่วไป, [1] = สมาชิก (รวมกฎของลูกค้าทั่วไปแล้ว)
+typedef struct {
+    uint32_t member_price;          // 0 = ไม่มีราคาสมาชิก
+    uint8_t buy[2];                 // 0 = ไม่มีโปรซื้อ X แถม Y
+    uint8_t get[2];
+} pricing_product_entry_t;
+
+typedef struct {
+    uint32_t min;                   // ยอด (สตางค์) ขั้นต่ำของขั้นนี้
+    uint16_t bp[2];
+} pricing_tier_t;
+
+typedef struct {
+    uint16_t discount_bp[2];
+    uint8_t vat_tiers;              // 0 = ใช้ VAT ปกติของตาราง
+    pricing_tier_t vat[PRICING_VAT_TIERS];  // เรียงตาม min จากน้อยไปมาก (bp[0] == bp[1])
+} pricing_category_entry_t;
+
+typedef struct {
+    pricing_product_entry_t products[PRICING_MAX_PRODUCTS];
+    pricing_category_entry_t categories[PRICING_MAX_CATEGORIES];
+    pricing_tier_t cart[PRICING_CART_TIERS];    // เรียงตาม min จากน้อยไปมาก
+    uint8_t cart_tiers;
+    uint16_t default_vat_bp;
+    uint16_t rule_count;
+    uint16_t bad_rule;              // ดัชนีกฎที่ทำให้ compile ล้มเหลว
+} pricing_table_t;
+
+// 🛒 หนึ่งบรรทัดในตะกร้า
+typedef struct {
+    uint16_t product;
+    uint8_t category;
+    uint32_t unit_price;            // ราคาป้าย (สตางค์)
+    uint32_t quantity;
+    bool vat_free;                  // สินค้ายกเว้น VAT/อัตรา 0% (เช่นจากแคตตาล็อก) ไม่คิด VAT ของหมวด
+} pricing_line_t;
+
+typedef struct {
+    int64_t subtotal;               // ราคาป้าย × จำนวน รวมทุกบรรทัด
+    int64_t line_discount;          // ราคาสมาชิก + ของแถม + ส่วนลดหมวด
+    int64_t cart_discount;          // ส่วนลดทั้งตะกร้า
+    int64_t net;                    // ยอดก่อน VAT
+    int64_t vat;
+    int64_t total;                  // ยอดชำระ
+    uint32_t free_items;            // จำนวนชิ้นที่แถม
+    uint16_t cart_discount_bp;      // อัตราส่วนลดตะกร้าที่ใช้ (0 = ไม่มี)
+} pricing_totals_t;
+
+// 🔧 แปลงรายการกฎเป็นตาราง default_vat_bp = VAT ของหมวดที่ไม่มีกฎ VAT
+// ล้มเหลวเมื่อกฎข้อใดไม่ถูกต้อง (table->bad_rule บอกว่าข้อไหน)
+pricing_err_t pricing_compile(pricing_table_t *table, const pricing_rule_t *rules, size_t n,
+                              uint16_t default_vat_bp);
+
+// 🧾 คิดเงินทั้งตะกร้ารอบเดียว line_discount (ถ้าไม่ใช่ NULL) ได้ส่วนลดระดับบรรทัดของแต่ละบรรทัด
+pricing_err_t pricing_checkout(const pricing_table_t *table, const pricing_line_t *lines, size_t n,
+                               bool member, pricing_totals_t *out, uint32_t *line_discount);
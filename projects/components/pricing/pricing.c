@@ -0,0 +1,225 @@
+#include "pricing.h"
+
+#include <string.h>
+
+#include "arith.h"
+
+// 🎁 โปรซื้อ X แถม Y ที่ลูกค้าได้ของแถมเป็นสัดส่วนมากกว่า (g1/(b1+g1) > g2/(b2+g2))
+static inline bool better_deal(uint32_t b1, uint32_t g1, uint32_t b2, uint32_t g2) {
+    return b2 == 0 || g1 * (b2 + g2) > g2 * (b1 + g1);
+}
+
+// 📶 ใส่ขั้นลงตารางโดยเรียงตาม min (min ซ้ำ = รวมเป็นขั้นเดียว เก็บอัตราที่ดีกว่าสำหรับลูกค้า)
+static bool insert_tier(pricing_tier_t *tiers, uint8_t *count, uint8_t max,
+                        uint32_t min, uint16_t bp, bool member_only, bool lower_is_better) {
+    uint8_t i = 0;
+    while (i < *count && tiers[i].min < min) {
+        i++;
+    }
+    if (i == *count || tiers[i].min != min) {
+        if (*count == max) {
+            return false;
+        }
+        memmove(&tiers[i + 1], &tiers[i], (*count - i) * sizeof(tiers[0]));
+        (*count)++;
+        tiers[i].min = min;
+        // ค่าเริ่มต้นที่แพ้กฎทุกข้อ (ส่วนลด 0 / VAT สูงสุด) แล้วให้กฎข้อนี้เขียนทับด้านล่าง
+        tiers[i].bp[0] = tiers[i].bp[1] = lower_is_better ? UINT16_MAX : 0;
+    }
+    for (int s = member_only ? 1 : 0; s < 2; s++) {
+        if (lower_is_better ? bp < tiers[i].bp[s] : bp > tiers[i].bp[s]) {
+            tiers[i].bp[s] = bp;
+        }
+    }
+    return true;
+}
+
+pricing_err_t pricing_compile(pricing_table_t *table, const pricing_rule_t *rules, size_t n,
+                              uint16_t default_vat_bp) {
+    memset(table, 0, sizeof(*table));
+    table->default_vat_bp = default_vat_bp;
+    table->rule_count = (uint16_t)n;
+
+    for (size_t r = 0; r < n; r++) {
+        const pricing_rule_t *rule = &rules[r];
+        int first = (rule->flags & PRICING_MEMBER_ONLY) ? 1 : 0;
+        table->bad_rule = (uint16_t)r;
+
+        switch (rule->kind) {
+            case PRICING_RULE_CATEGORY_DISCOUNT: {
+                if (rule->target >= PRICING_MAX_CATEGORIES || rule->amount > PRICING_BP_FULL) {
+                    return PRICING_ERR_BAD_RULE;
+                }
+                pricing_category_entry_t *c = &table->categories[rule->target];
+                for (int s = first; s < 2; s++) {
+                    if (rule->amount > c->discount_bp[s]) {
+                        c->discount_bp[s] = (uint16_t)rule->amount;
+                    }
+                }
+                break;
+            }
+            case PRICING_RULE_MEMBER_PRICE: {
+                if (rule->target >= PRICING_MAX_PRODUCTS || rule->amount == 0) {
+                    return PRICING_ERR_BAD_RULE;
+                }
+                pricing_product_entry_t *p = &table->products[rule->target];
+                if (p->member_price == 0 || rule->amount < p->member_price) {
+                    p->member_price = rule->amount;
+                }
+                break;
+            }
+            case PRICING_RULE_BUY_X_GET_Y: {
+                if (rule->target >= PRICING_MAX_PRODUCTS ||
+                    rule->amount == 0 || rule->amount > UINT8_MAX ||
+                    rule->limit == 0 || rule->limit > UINT8_MAX) {
+                    return PRICING_ERR_BAD_RULE;
+                }
+                pricing_product_entry_t *p = &table->products[rule->target];
+                for (int s = first; s < 2; s++) {
+                    if (better_deal(rule->amount, rule->limit, p->buy[s], p->get[s])) {
+                        p->buy[s] = (uint8_t)rule->amount;
+                        p->get[s] = (uint8_t)rule->limit;
+                    }
+                }
+                break;
+            }
+            case PRICING_RULE_VAT_TIER: {
+                if (rule->target >= PRICING_MAX_CATEGORIES || rule->amount > PRICING_BP_FULL) {
+                    return PRICING_ERR_BAD_RULE;
+                }
+                pricing_category_entry_t *c = &table->categories[rule->target];
+                if (!insert_tier(c->vat, &c->vat_tiers, PRICING_VAT_TIERS,
+                                 rule->limit, (uint16_t)rule->amount, false, true)) {
+                    return PRICING_ERR_TOO_MANY_TIERS;
+                }
+                break;
+            }
+            case PRICING_RULE_CART_DISCOUNT:
+                if (rule->amount > PRICING_BP_FULL) {
+                    return PRICING_ERR_BAD_RULE;
+                }
+                if (!insert_tier(table->cart, &table->cart_tiers, PRICING_CART_TIERS,
+                                 rule->limit, (uint16_t)rule->amount, first == 1, false)) {
+                    return PRICING_ERR_TOO_MANY_TIERS;
+                }
+                break;
+            default:
+                return PRICING_ERR_BAD_RULE;
+        }
+    }
+    table->bad_rule = 0;
+
+    // 🔁 fix-up ขั้นส่วนลดตะกร้า: ขั้นที่สูงกว่าได้อย่างน้อยเท่าขั้นก่อนหน้า และสมาชิกได้อย่างน้อยเท่าลูกค้าทั่วไป
+    // (ช่องสมาชิกของสินค้า/หมวดถูกอัปเดตพร้อมกันตั้งแต่ตอนใส่กฎแล้ว) checkout จึงอ่านช่องเดียวพอ
+    for (int i = 0; i < table->cart_tiers; i++) {
+        pricing_tier_t *t = &table->cart[i];
+        if (i > 0) {
+            for (int s = 0; s < 2; s++) {
+                if (t->bp[s] < t[-1].bp[s]) {
+                    t->bp[s] = t[-1].bp[s];
+                }
+            }
+        }
+        if (t->bp[1] < t->bp[0]) {
+            t->bp[1] = t->bp[0];
+        }
+    }
+    return PRICING_OK;
+}
+
+// 📶 อัตราของขั้นสูงสุดที่ยอดถึง (ตารางมีไม่เกิน 4 ขั้น)
+static inline uint32_t tier_bp(const pricing_tier_t *tiers, uint8_t count, int64_t value,
+                               int slot, uint32_t fallback) {
+    uint32_t bp = fallback;
+    for (uint8_t i = 0; i < count && tiers[i].min <= value; i++) {
+        bp = tiers[i].bp[slot];
+    }
+    return bp;
+}
+
+// สินค้าที่รหัสเกินตาราง: ไม่มีราคาสมาชิกและไม่มีโปรซื้อ X แถม Y
+static const pricing_product_entry_t no_product_rule;
+
+pricing_err_t pricing_checkout(const pricing_table_t *table, const pricing_line_t *lines, size_t n,
+                               bool member, pricing_totals_t *out, uint32_t *line_discount) {
+    int64_t category_net[PRICING_MAX_CATEGORIES] = {0};
+    uint32_t used = 0;
+    int m = member ? 1 : 0;
+
+    memset(out, 0, sizeof(*out));
+
+    // 🛒 รอบเดียวต่อบรรทัด: ค้นตารางสินค้าและหมวดด้วยดัชนี
+    for (size_t i = 0; i < n; i++) {
+        const pricing_line_t *l = &lines[i];
+        if (l->category >= PRICING_MAX_CATEGORIES) {
+            return PRICING_ERR_BAD_LINE;
+        }
+        const pricing_product_entry_t *p = l->product < PRICING_MAX_PRODUCTS
+                                           ? &table->products[l->product] : &no_product_rule;
+        const pricing_category_entry_t *c = &table->categories[l->category];
+
+        uint32_t unit = l->unit_price;
+        if (m && p->member_price != 0 && p->member_price < unit) {
+            unit = p->member_price;
+        }
+
+        // ครบชุด (X+Y) ได้แถม Y ชิ้น เศษที่เกิน X ชิ้นก็นับเป็นของแถม
+        uint32_t free_items = 0;
+        if (p->buy[m]) {
+            uint32_t group = (uint32_t)p->buy[m] + p->get[m];
+            uint32_t rest = l->quantity % group;
+            free_items = l->quantity / group * p->get[m] + (rest > p->buy[m] ? rest - p->buy[m] : 0);
+        }
+
+        // 💯 เงินทุกขั้นผ่าน arith_satang_* (ปัดครึ่งขึ้น ตรวจการล้น)
+        int64_t amount, net, gross;
+        if (arith_satang_mul(unit, l->quantity - free_items, &amount) != ARITH_OK ||
+            arith_satang_discount_bp(amount, c->discount_bp[m], &net) != ARITH_OK ||
+            arith_satang_mul(l->unit_price, l->quantity, &gross) != ARITH_OK) {
+            return PRICING_ERR_OVERFLOW;
+        }
+
+        if (line_discount) {
+            line_discount[i] = (uint32_t)(gross - net);
+        }
+        out->subtotal += gross;
+        out->line_discount += gross - net;
+        out->free_items += free_items;
+        if (!l->vat_free) {
+            category_net[l->category] += net;
+            used |= 1u << l->category;
+        }
+    }
+
+    // 🎫 ส่วนลดตะกร้าเลือกขั้นจากยอดหลังส่วนลดบรรทัด ปัดเศษครั้งเดียวจากยอดรวม
+    int64_t after_lines = out->subtotal - out->line_discount;
+    uint32_t cart_bp = tier_bp(table->cart, table->cart_tiers, after_lines, m, 0);
+    out->cart_discount_bp = (uint16_t)cart_bp;
+    if (arith_satang_percent(after_lines, cart_bp, &out->cart_discount) != ARITH_OK) {
+        return PRICING_ERR_OVERFLOW;
+    }
+    out->net = after_lines - out->cart_discount;
+
+    // 🏛️ VAT ตามขั้นของแต่ละหมวด คิดจากยอดหมวด (เฉพาะบรรทัดที่เสีย VAT) หลังหักส่วนลดตะกร้า
+    // สะสมแบบไม่ปัดเศษ (หน่วย 1/10⁸ สตางค์) แล้วปัดครั้งเดียว ยอดจึงตรงกับคิด VAT จากยอดรวมเมื่ออัตราเท่ากัน
+    int64_t vat_raw = 0;
+    for (int cat = 0; used != 0; cat++, used >>= 1) {
+        if (!(used & 1)) {
+            continue;
+        }
+        const pricing_category_entry_t *c = &table->categories[cat];
+        int64_t base, raw;
+        if (arith_satang_discount_bp(category_net[cat], cart_bp, &base) != ARITH_OK) {
+            return PRICING_ERR_OVERFLOW;
+        }
+        uint32_t vat_bp = tier_bp(c->vat, c->vat_tiers, base, 0, table->default_vat_bp);
+        if (arith_satang_mul(category_net[cat], (int64_t)(PRICING_BP_FULL - cart_bp) * vat_bp, &raw) != ARITH_OK ||
+            __builtin_add_overflow(vat_raw, raw, &vat_raw)) {
+            return PRICING_ERR_OVERFLOW;
+        }
+    }
+    const int64_t scale = (int64_t)PRICING_BP_FULL * PRICING_BP_FULL;
+    out->vat = (vat_raw + scale / 2) / scale;
+    out->total = out->net + out->vat;
+    return PRICING_OK;
+}
@@ -0,0 +1,149 @@
+// 🖥️ benchmark ของ receipt บนเครื่อง host — พิมพ์ CSV ออก stdout และตัวอย่างใบเสร็จออก stderr
+// เทียบใบเสร็จ 15 บรรทัดแบบเดิม (snprintf prefix ของ log + float ทีละบรรทัด แล้วส่งออกทีละบรรทัด)
+// กับ template ที่วางทั้งใบในบัฟเฟอร์เดียวแล้วส่งครั้งเดียว (sink เป็นตัวนับไบต์ ไม่รวมเวลา I/O)
+#include <stdarg.h>
+#include <stdio.h>
+#include "bench.h"
+#include "receipt.h"
+
+#define ITEMS 5
+
+typedef struct {
+    const char *name;
+    uint32_t qty;
+    int64_t unit;       // สตางค์
+} item_t;
+
+static const item_t items[ITEMS] = {
+    { "น้ำดื่ม", 2, 1500 }, { "ขนมปัง", 1, 2500 }, { "กาแฟกระป๋อง", 3, 4500 },
+    { "แอปเปิ้ล", 6, 1500 }, { "กล้วย", 12, 800 },
+};
+
+static receipt_template_t tpl;
+static char buf[2048];
+static volatile size_t sink_bytes;
+static volatile uint32_t sink_calls;
+
+static void count_sink(void *ctx, const char *data, size_t len) {
+    (void)ctx;
+    (void)data;
+    sink_bytes += len;
+    sink_calls++;
+}
+
+// 🐢 แบบเดิม: หนึ่งบรรทัด = หนึ่ง ESP_LOGI (prefix + จัดรูป float + เขียนออก)
+static void log_line(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+static void log_line(const char *fmt, ...) {
+    char line[256];
+    int n = snprintf(line, sizeof(line), "I (%lu) %s: ", 123456ul, "FINAL_CALCULATOR");
+    va_list ap;
+    va_start(ap, fmt);
+    n += vsnprintf(line + n, sizeof(line) - (size_t)n, fmt, ap);
+    va_end(ap);
+    line[n++] = '\n';
+    count_sink(NULL, line, (size_t)n);
+}
+
+static void bench_logi(void *ctx, uint32_t iters) {
+    (void)ctx;
+    for (uint32_t k = 0; k < iters; k++) {
+        double subtotal = 0;
+        log_line("🧾 ใบเสร็จ");
+        log_line("==========================================");
+        for (int i = 0; i < ITEMS; i++) {
+            double total = items[i].qty * (items[i].unit / 100.0);
+            subtotal += total;
+            log_line("%s  %.2f×%lu  %.2f บาท", items[i].name, items[i].unit / 100.0,
+                     (unsigned long)items[i].qty, total);
+        }
+        log_line("------------------------------------------");
+        log_line("ยอดรวม:                    %.2f บาท", subtotal);
+        log_line("ส่วนลด %.0f%%:               -%.2f บาท", 10.0, subtotal * 0.1);
+        log_line("หลังหักส่วนลด:             %.2f บาท", subtotal * 0.9);
+        log_line("ภาษี %.0f%%:                 +%.2f บาท", 7.0, subtotal * 0.9 * 0.07);
+        log_line("==========================================");
+        log_line("ยอดชำระสุทธิ:              %.2f บาท", subtotal * 0.9 * 1.07);
+        log_line("ขอบคุณที่ใช้บริการ ❤️");
+    }
+}
+
+static void render(receipt_t *r) {
+    int64_t subtotal = 0;
+    receipt_begin(r, &tpl, buf, sizeof(buf));
+    receipt_text(r, "🧾 ใบเสร็จ");
+    receipt_rule(r, true);
+    for (int i = 0; i < ITEMS; i++) {
+        int64_t total = items[i].unit * items[i].qty;
+        subtotal += total;
+        receipt_item(r, items[i].name, items[i].qty, items[i].unit, total);
+    }
+    int64_t discount = (subtotal + 5) / 10;
+    int64_t net = subtotal - discount;
+    int64_t vat = (net * 7 + 50) / 100;
+    receipt_rule(r, false);
+    receipt_amount(r, "ยอดรวม:", 0, subtotal);
+    receipt_amount(r, "ส่วนลด 10%:", '-', discount);
+    receipt_amount(r, "หลังหักส่วนลด:", 0, net);
+    receipt_amount(r, "ภาษี 7%:", '+', vat);
+    receipt_rule(r, true);
+    receipt_amount(r, "ยอดชำระสุทธิ:", 0, net + vat);
+    receipt_text(r, "ขอบคุณที่ใช้บริการ ❤️");
+}
+
+static void bench_template(void *ctx, uint32_t iters) {
+    (void)ctx;
+    receipt_t r;
+    for (uint32_t k = 0; k < iters; k++) {
+        render(&r);
+        receipt_emit(&r, count_sink, NULL);
+    }
+}
+
+static void bench_money(void *ctx, uint32_t iters) {
+    (void)ctx;
+    char out[24];
+    size_t acc = 0;
+    for (uint32_t k = 0; k < iters; k++) {
+        acc += receipt_format_money(out, 1234567 + k);
+    }
+    sink_bytes = acc;
+}
+
+static void bench_money_printf(void *ctx, uint32_t iters) {
+    (void)ctx;
+    char out[24];
+    size_t acc = 0;
+    for (uint32_t k = 0; k < iters; k++) {
+        acc += (size_t)snprintf(out, sizeof(out), "%.2f", (1234567 + k) / 100.0);
+    }
+    sink_bytes = acc;
+}
+
+int main(void) {
+    static const receipt_layout_t layout = { .currency = " บาท", .width = 42, .money_cols = 10, .qty_cols = 14 };
+    bench_config_t cfg = BENCH_CONFIG_DEFAULT;
+    bench_result_t r;
+    receipt_t sample;
+
+    if (!receipt_template_init(&tpl, &layout)) {
+        fprintf(stderr, "bad layout\n");
+        return 1;
+    }
+    render(&sample);
+    receipt_emit(&sample, receipt_sink_stdio, stderr);
+
+    static const bench_case_t cases[] = {
+        { .name = "receipt_logi_per_line", .fn = bench_logi },
+        { .name = "receipt_template", .fn = bench_template },
+        { .name = "money_snprintf", .fn = bench_money_printf },
+        { .name = "money_integer", .fn = bench_money },
+    };
+    cfg.inner_iters = 64;
+    bench_calibrate(&cfg);
+    bench_print_csv_header(stdout);
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        bench_run(&cases[i], &cfg, &r);
+        bench_print_csv(stdout, &r);
+    }
+    return 0;
+}
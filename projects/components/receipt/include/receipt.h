@@ -0,0 +1,79 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 🧾 receipt: วางใบเสร็จความกว้างคงที่ลงบัฟเฟอร์ของผู้เรียกครั้งเดียว แล้วส่งทั้งก้อนให้ sink
+// - เงินเป็นสตางค์ (จำนวนเต็ม) จัดรูปด้วยการหารจำนวนเต็ม ไม่ใช้ printf/float
+// - template คำนวณตำแหน่งคอลัมน์และเส้นคั่นไว้ล่วงหน้าตอน init ใช้ซ้ำได้ทุกใบ
+// - ความกว้างนับเป็นช่องบนจอ: สระบน/ล่างและวรรณยุกต์ไทยไม่กินช่อง อีโมจิกิน 2 ช่อง
+// - sink ได้ pointer ของบัฟเฟอร์เดิม (ไม่ copy) เช่น uart_write_bytes() หรือ fwrite()
+
+#define RECEIPT_MAX_WIDTH 64
+
+// 📤 ปลายทางของใบเสร็จ: เรียกครั้งเดียวต่อใบ data ชี้เข้าบัฟเฟอร์ของผู้เรียกโดยตรง
+typedef void (*receipt_sink_t)(void *ctx, const char *data, size_t len);
+
+typedef struct {
+    const char *indent;             // ขึ้นต้นทุกบรรทัด (ไม่นับใน width)
+    const char *currency;           // ต่อท้ายจำนวนเงิน เช่น " บาท" (นับใน width)
+    uint8_t width;                  // ความกว้างของบรรทัด (ช่อง) ≤ RECEIPT_MAX_WIDTH
+    uint8_t money_cols;             // ช่องของตัวเลขเงินชิดขวา (รวมเครื่องหมาย)
+    uint8_t qty_cols;               // ช่องของ "จำนวน × ราคา" ในบรรทัดสินค้า (ชิดขวาก่อนคอลัมน์เงิน)
+} receipt_layout_t;
+
+// 📐 template: ตำแหน่งคอลัมน์ (หน่วยช่อง นับจากหลัง indent) และเส้นคั่นที่ทำไว้แล้ว
+typedef struct {
+    const char *indent;
+    const char *currency;
+    uint8_t indent_len;             // ไบต์
+    uint8_t currency_len;           // ไบต์
+    uint8_t width;
+    uint8_t money_col;              // ช่องแรกของคอลัมน์เงิน
+    uint8_t money_cols;
+    uint8_t qty_col;                // ช่องแรกของคอลัมน์จำนวน × ราคา
+    char rule_double[RECEIPT_MAX_WIDTH];    // "====…" ยาว width
+    char rule_single[RECEIPT_MAX_WIDTH];    // "----…" ยาว width
+} receipt_template_t;
+
+// 🖨️ ใบเสร็จที่กำลังวาง (บัฟเฟอร์เป็นของผู้เรียก)
+typedef struct {
+    const receipt_template_t *tpl;
+    char *buf;
+    size_t cap;
+    size_t len;
+    uint16_t lines;
+    bool truncated;                 // มีบรรทัดที่ไม่พอที่ (ถูกข้ามทั้งบรรทัด)
+} receipt_t;
+
+// เตรียม template คืนค่า false ถ้าคอลัมน์ไม่พอดีกับความกว้าง
+bool receipt_template_init(receipt_template_t *tpl, const receipt_layout_t *layout);
+
+// เริ่มใบใหม่ในบัฟเฟอร์ buf (ใช้ซ้ำได้ทุกใบ)
+void receipt_begin(receipt_t *r, const receipt_template_t *tpl, char *buf, size_t cap);
+
+// ข้อความทั้งบรรทัดตามที่ให้มา
+void receipt_text(receipt_t *r, const char *text);
+
+// เส้นคั่นเต็มความกว้าง: double = '=' ไม่งั้น '-'
+void receipt_rule(receipt_t *r, bool double_line);
+
+// "ชื่อ   จำนวน × ราคา   ยอด บาท"
+void receipt_item(receipt_t *r, const char *name, uint32_t qty, int64_t unit_satang, int64_t total_satang);
+
+// "ป้าย:   ±ยอด บาท" (sign = '+', '-' หรือ 0)
+void receipt_amount(receipt_t *r, const char *label, char sign, int64_t satang);
+
+// ส่งทั้งใบให้ sink ครั้งเดียว คืนจำนวนไบต์
+size_t receipt_emit(const receipt_t *r, receipt_sink_t sink, void *ctx);
+
+// 📤 sink สำเร็จรูป: fwrite ทั้งก้อนลง FILE* ใน ctx (NULL = stdout) แล้ว fflush
+// สำหรับ UART โดยตรงให้ห่อ uart_write_bytes(port, data, len) เป็น sink ของตัวเอง
+void receipt_sink_stdio(void *ctx, const char *data, size_t len);
+
+// 💰 จัดรูปสตางค์เป็น "1234.56" (ลบได้) out ต้องยาวอย่างน้อย 24 ไบต์ คืนความยาว (ไม่มี '\0')
+size_t receipt_format_money(char *out, int64_t satang);
+
+// 📏 จำนวนช่องบนจอของข้อความ UTF-8 (len ไบต์)
+size_t receipt_display_width(const char *s, size_t len);
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 🖨️ render_buf: ประกอบข้อความทั้งบรรทัด/ทั้งเฟรมในบัฟเฟอร์เดียว
+// แล้วเขียนออก stdout ครั้งเดียว แทนการเรียก printf ทีละตัวอักษร/อีโมจิ
+// ข้อความที่ยาวเกินบัฟเฟอร์ไม่ถูกตัด: บัฟเฟอร์ถูกเขียนออกก่อนเต็ม (ได้หลาย write แทนครั้งเดียว)
+
+// 📊 ตัวนับสำหรับวัดผล: ชิ้นส่วนที่ต่อเข้าบัฟเฟอร์ เทียบกับจำนวนครั้งที่เขียนจริง
+typedef struct {
+    uint32_t fragments;     // จำนวนครั้งที่ append (เดิม = จำนวน printf)
+    uint32_t writes;        // จำนวนครั้งที่ fwrite ออก stdout
+    uint32_t bytes;         // จำนวนไบต์ที่เขียนออกทั้งหมด
+} render_stats_t;
+
+// 🧱 บัฟเฟอร์สำหรับเรนเดอร์ (ผู้เรียกเป็นเจ้าของหน่วยความจำ)
+typedef struct {
+    char *data;
+    size_t cap;
+    size_t len;
+    bool in_log_line;       // กำลังอยู่ในบรรทัดที่เปิดด้วย render_buf_log_line (ต้องปิดสีก่อนขึ้นบรรทัด)
+    bool muted;             // ระดับ log ของ tag ต่ำกว่า INFO: ทิ้งข้อความจนถึงบรรทัด log ถัดไป/flush
+    bool mid_line;          // ส่วนที่เขียนออกก่อนเต็มจบกลางบรรทัด
+    render_stats_t stats;
+} render_buf_t;
+
+// ผูกบัฟเฟอร์กับหน่วยความจำของผู้เรียก (ต้องมีขนาดอย่างน้อย 2 ไบต์)
+void render_buf_init(render_buf_t *rb, char *storage, size_t cap);
+
+// ล้างข้อความในบัฟเฟอร์ (ตัวนับสถิติยังอยู่)
+void render_buf_reset(render_buf_t *rb);
+
+// ต่อข้อความ
+void render_buf_append(render_buf_t *rb, const char *s);
+void render_buf_append_n(render_buf_t *rb, const char *s, size_t n);
+
+// ต่อข้อความเดิมซ้ำ count ครั้ง เช่น "🍬" × 6 (copy แบบเพิ่มเท่าตัว)
+void render_buf_repeat(render_buf_t *rb, const char *s, int count);
+
+// ต่อข้อความแบบ printf
+void render_buf_printf(render_buf_t *rb, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+void render_buf_vprintf(render_buf_t *rb, const char *fmt, va_list ap);
+
+// ขึ้นบรรทัดใหม่พร้อม prefix แบบเดียวกับ ESP_LOGI: "I (ms) TAG: " (รวมสีเมื่อเปิด CONFIG_LOG_COLORS)
+// ถ้า esp_log_level_get(tag) ต่ำกว่า ESP_LOG_INFO ข้อความของบรรทัดนี้จะไม่ถูกเขียนออก
+void render_buf_log_line(render_buf_t *rb, const char *tag);
+
+// เขียนทั้งบัฟเฟอร์ออก stdout ด้วยการเรียกครั้งเดียว แล้ว reset
+// คืนค่าจำนวนไบต์ที่เขียน
+size_t render_buf_flush(render_buf_t *rb);
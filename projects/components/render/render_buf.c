@@ -0,0 +1,192 @@
+#include "render_buf.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "esp_log.h"
+
+void render_buf_init(render_buf_t *rb, char *storage, size_t cap) {
+    memset(rb, 0, sizeof(*rb));
+    rb->data = storage;
+    rb->cap = cap;
+    rb->data[0] = '\0';
+}
+
+void render_buf_reset(render_buf_t *rb) {
+    rb->len = 0;
+    rb->in_log_line = false;
+    rb->muted = false;
+    rb->mid_line = false;
+    rb->data[0] = '\0';
+}
+
+// 🧮 พื้นที่ว่างที่เหลือ (เผื่อ '\0' ปิดท้าย 1 ไบต์)
+static size_t space_left(const render_buf_t *rb) {
+    return rb->cap - 1 - rb->len;
+}
+
+// 📤 เขียนออก stdout ตรงๆ และนับสถิติ
+static void write_out(render_buf_t *rb, const char *data, size_t n) {
+    size_t written = fwrite(data, 1, n, stdout);
+    rb->mid_line = n > 0 && data[n - 1] != '\n';
+    rb->stats.writes++;
+    rb->stats.bytes += (uint32_t)written;
+}
+
+// 🚿 บัฟเฟอร์เต็ม: เขียนส่วนที่ประกอบไว้ออกก่อน (ไม่เติม '\n' ไม่ล้างสถานะบรรทัด) แล้วเริ่มบัฟเฟอร์ใหม่
+static void spill(render_buf_t *rb) {
+    if (rb->len > 0) {
+        write_out(rb, rb->data, rb->len);
+        rb->len = 0;
+        rb->data[0] = '\0';
+    }
+}
+
+// ต่อข้อความโดยไม่นับเป็นชิ้นส่วน (ใช้กับรหัสสีที่ผู้เรียกไม่ได้ต่อเอง)
+static void put(render_buf_t *rb, const char *s, size_t n) {
+    if (n > space_left(rb)) {
+        spill(rb);
+        if (n > space_left(rb)) {
+            // ยาวกว่าทั้งบัฟเฟอร์: เขียนออกตรงๆ ไม่ต้อง copy
+            write_out(rb, s, n);
+            return;
+        }
+    }
+    memcpy(rb->data + rb->len, s, n);
+    rb->len += n;
+    rb->data[rb->len] = '\0';
+}
+
+void render_buf_append_n(render_buf_t *rb, const char *s, size_t n) {
+    rb->stats.fragments++;
+    if (!rb->muted) {
+        put(rb, s, n);
+    }
+}
+
+void render_buf_append(render_buf_t *rb, const char *s) {
+    render_buf_append_n(rb, s, strlen(s));
+}
+
+// copy ชิ้นแรก แล้วขยายด้วยการ copy ส่วนที่มีอยู่แล้วแบบเพิ่มเท่าตัว (total เป็นทวีคูณของ unit และพอดีที่ว่าง)
+static void fill_repeat(render_buf_t *rb, const char *s, size_t unit, size_t total) {
+    char *start = rb->data + rb->len;
+    memcpy(start, s, unit);
+    size_t filled = unit;
+    while (filled < total) {
+        size_t chunk = filled <= total - filled ? filled : total - filled;
+        memcpy(start + filled, start, chunk);
+        filled += chunk;
+    }
+    rb->len += total;
+    rb->data[rb->len] = '\0';
+}
+
+void render_buf_repeat(render_buf_t *rb, const char *s, int count) {
+    size_t unit = strlen(s);
+    if (count <= 0 || unit == 0) {
+        return;
+    }
+    rb->stats.fragments += (uint32_t)count;
+    if (rb->muted) {
+        return;
+    }
+
+    // ไม่พอสำหรับทั้งหมด: เติมเป็นช่วงที่ลงตัวทีละหน่วย (อีโมจิ UTF-8 ไม่ขาดครึ่ง) แล้วเขียนออกก่อนเต็ม
+    size_t remaining = unit * (size_t)count;
+    while (remaining > space_left(rb)) {
+        size_t fit = (space_left(rb) / unit) * unit;
+        if (fit == 0) {
+            if (rb->len == 0) {
+                // หน่วยเดียวยาวกว่าทั้งบัฟเฟอร์
+                for (; remaining > 0; remaining -= unit) {
+                    write_out(rb, s, unit);
+                }
+                return;
+            }
+            spill(rb);
+            continue;
+        }
+        fill_repeat(rb, s, unit, fit);
+        remaining -= fit;
+        spill(rb);
+    }
+    if (remaining > 0) {
+        fill_repeat(rb, s, unit, remaining);
+    }
+}
+
+void render_buf_vprintf(render_buf_t *rb, const char *fmt, va_list ap) {
+    rb->stats.fragments++;
+    if (rb->muted) {
+        return;
+    }
+    va_list retry;
+    va_copy(retry, ap);
+    size_t avail = space_left(rb);
+    int n = vsnprintf(rb->data + rb->len, avail + 1, fmt, ap);
+    if (n >= 0 && (size_t)n > avail) {
+        // ไม่พอ: เขียนส่วนที่มีออกก่อน แล้วจัดรูปใหม่ในบัฟเฟอร์ว่าง
+        rb->data[rb->len] = '\0';
+        spill(rb);
+        avail = space_left(rb);
+        if ((size_t)n <= avail) {
+            vsnprintf(rb->data, avail + 1, fmt, retry);
+        } else {
+            // ยาวกว่าทั้งบัฟเฟอร์: ให้ stdio จัดรูปและเขียนออกตรงๆ
+            vfprintf(stdout, fmt, retry);
+            size_t fmt_len = strlen(fmt);
+            rb->mid_line = fmt_len == 0 || fmt[fmt_len - 1] != '\n';
+            rb->stats.writes++;
+            rb->stats.bytes += (uint32_t)n;
+            n = 0;
+        }
+    }
+    va_end(retry);
+    if (n < 0) {
+        rb->data[rb->len] = '\0';
+        return;
+    }
+    rb->len += (size_t)n;
+}
+
+void render_buf_printf(render_buf_t *rb, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    render_buf_vprintf(rb, fmt, ap);
+    va_end(ap);
+}
+
+// ปิดบรรทัด log ที่เปิดอยู่: ปิดสี (LOG_RESET_COLOR) แล้วขึ้นบรรทัดถ้ายังไม่ได้ขึ้น
+static void end_line(render_buf_t *rb) {
+    bool open = rb->len > 0 ? rb->data[rb->len - 1] != '\n' : rb->mid_line;
+    if (rb->in_log_line && !rb->muted) {
+        put(rb, LOG_RESET_COLOR, strlen(LOG_RESET_COLOR));
+    }
+    rb->in_log_line = false;
+    rb->muted = false;
+    if (open) {
+        render_buf_append_n(rb, "\n", 1);
+    }
+}
+
+void render_buf_log_line(render_buf_t *rb, const char *tag) {
+    end_line(rb);
+    rb->in_log_line = true;
+    if (esp_log_level_get(tag) < ESP_LOG_INFO) {
+        rb->muted = true;
+        return;
+    }
+    render_buf_printf(rb, LOG_COLOR_I "I (%" PRIu32 ") %s: ", esp_log_timestamp(), tag);
+}
+
+size_t render_buf_flush(render_buf_t *rb) {
+    uint32_t before = rb->stats.bytes;
+    end_line(rb);
+    if (rb->len > 0) {
+        write_out(rb, rb->data, rb->len);
+    }
+    fflush(stdout);
+    render_buf_reset(rb);
+    return rb->stats.bytes - before;
+}
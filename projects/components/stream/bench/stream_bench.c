@@ -0,0 +1,114 @@
+// 🖥️ benchmark ของ stream_stats บนเครื่อง host — พิมพ์ CSV (cycle ต่อค่า) ออก stdout
+// และอัตรา samples/วินาที (นาฬิกาจริง) ออก stderr
+// เทียบกับการคำนวณใหม่ทั้งหน้าต่างทุกค่า (naive) ซึ่งโตตามขนาดหน้าต่าง ส่วน stream_stats คงที่
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "bench.h"
+#include "stream_stats.h"
+
+#define SAMPLES 4096
+#define RATE_SAMPLES 20000000u
+
+typedef struct {
+    uint32_t window;
+    stream_stats_t stats;
+    uint32_t pos;
+} window_case_t;
+
+static double samples[SAMPLES];
+static double naive_ring[4096];
+static volatile double sink;
+
+// 🎲 ค่าจำลองเซนเซอร์: คลื่นช้า + สัญญาณรบกวน (xorshift — ได้ชุดเดิมทุกครั้ง)
+static void fill_samples(void) {
+    uint32_t x = 2463534242u;
+    for (int i = 0; i < SAMPLES; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        samples[i] = 25.0 + 3.0 * sin(i / 200.0) + (x % 1000) / 1000.0;
+    }
+}
+
+static void bench_stream(void *ctx, uint32_t iters) {
+    window_case_t *c = ctx;
+    for (uint32_t k = 0; k < iters; k++) {
+        stream_stats_push(&c->stats, samples[c->pos]);
+        c->pos = (c->pos + 1) & (SAMPLES - 1);
+    }
+    sink = c->stats.mean;
+}
+
+// 🐢 naive: เก็บค่าใน ring แล้วไล่ทั้งหน้าต่างหาผลรวม/ต่ำสุด/สูงสุด/ความแปรปรวนทุกครั้ง
+static void bench_naive(void *ctx, uint32_t iters) {
+    window_case_t *c = ctx;
+    uint32_t w = c->window;
+    for (uint32_t k = 0; k < iters; k++) {
+        naive_ring[c->pos % w] = samples[c->pos];
+        c->pos = (c->pos + 1) & (SAMPLES - 1);
+        double sum = 0, mn = INFINITY, mx = -INFINITY;
+        for (uint32_t i = 0; i < w; i++) {
+            double v = naive_ring[i];
+            sum += v;
+            mn = v < mn ? v : mn;
+            mx = v > mx ? v : mx;
+        }
+        double mean = sum / w, m2 = 0;
+        for (uint32_t i = 0; i < w; i++) {
+            m2 += (naive_ring[i] - mean) * (naive_ring[i] - mean);
+        }
+        sink = m2 + mn + mx;
+    }
+}
+
+static double wall_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(void) {
+    static const uint32_t windows[] = { 16, 256, 4096 };
+    static window_case_t stream_cases[3], naive_cases[3];
+    static char names[6][32];
+    bench_config_t cfg = BENCH_CONFIG_DEFAULT;
+    bench_result_t r;
+
+    fill_samples();
+    cfg.inner_iters = 1024;
+    bench_calibrate(&cfg);
+    bench_print_csv_header(stdout);
+    for (int i = 0; i < 3; i++) {
+        stream_cases[i].window = naive_cases[i].window = windows[i];
+        if (!stream_stats_init(&stream_cases[i].stats, windows[i], 0.05)) {
+            fprintf(stderr, "init failed\n");
+            return 1;
+        }
+        snprintf(names[2 * i], sizeof(names[0]), "stream_w%u", (unsigned)windows[i]);
+        snprintf(names[2 * i + 1], sizeof(names[0]), "naive_w%u", (unsigned)windows[i]);
+        bench_case_t sc = { .name = names[2 * i], .fn = bench_stream, .ctx = &stream_cases[i] };
+        bench_case_t nc = { .name = names[2 * i + 1], .fn = bench_naive, .ctx = &naive_cases[i] };
+        bench_run(&sc, &cfg, &r);
+        bench_print_csv(stdout, &r);
+        bench_run(&nc, &cfg, &r);
+        bench_print_csv(stdout, &r);
+    }
+
+    // ⏱️ อัตราต่อวินาทีแบบนาฬิกาจริง (ต่อเนื่อง 20 ล้านค่า)
+    for (int i = 0; i < 3; i++) {
+        stream_stats_t *s = &stream_cases[i].stats;
+        stream_stats_reset(s);
+        double t0 = wall_seconds();
+        for (uint32_t k = 0; k < RATE_SAMPLES; k++) {
+            stream_stats_push(s, samples[k & (SAMPLES - 1)]);
+        }
+        double t = wall_seconds() - t0;
+        stream_snapshot_t snap;
+        stream_stats_snapshot(s, &snap);
+        fprintf(stderr, "stream_w%u: %.1f M samples/s (mean %.3f sd %.3f min %.3f max %.3f ewma %.3f)\n",
+                (unsigned)windows[i], RATE_SAMPLES / t / 1e6, snap.mean, sqrt(snap.variance),
+                snap.min, snap.max, snap.ewma);
+        stream_stats_free(s);
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 🌊 stream_stats: สถิติของค่าที่ไหลเข้ามาไม่หยุด (เช่นเซนเซอร์) ใช้หน่วยความจำคงที่ O(1) ต่อค่า
+// - หน้าต่างเลื่อน window ค่าล่าสุด: ผลรวม (ชดเชยการปัดเศษแบบ Neumaier), ค่าเฉลี่ยเคลื่อนที่,
+//   ความแปรปรวน (Welford แบบแทนค่าเก่าด้วยค่าใหม่), ต่ำสุด/สูงสุด (monotonic deque)
+//   ทุกครั้งที่ครบรอบหน้าต่าง ผลรวม/Welford ถูกแทนด้วยชุดที่สะสมใหม่ทั้งรอบ ความคลาดเคลื่อนจึงไม่สะสมเกินหนึ่งรอบ
+// - EWMA และสถิติตลอดสาย (Welford) ไม่ขึ้นกับหน้าต่าง
+// จองหน่วยความจำครั้งเดียวตอน init: 16 ไบต์ต่อช่องของหน้าต่าง ไม่มีการจองระหว่างทำงาน
+
+typedef struct {
+    uint32_t window;                // ขนาดหน้าต่าง (จำนวนค่า)
+    double alpha;                   // น้ำหนักค่าใหม่ของ EWMA (0, 1]
+
+    double *ring;                   // [window] ค่าในหน้าต่าง
+    uint32_t *min_q;                // [window] deque ของตำแหน่งใน ring ค่าเพิ่มขึ้นจากหัวไปท้าย
+    uint32_t *max_q;                // [window] deque ของตำแหน่งใน ring ค่าลดลงจากหัวไปท้าย
+    uint32_t pos;                   // ช่องถัดไปใน ring (= ช่องของค่าที่เก่าที่สุดเมื่อเต็ม)
+    uint32_t n;                     // จำนวนค่าในหน้าต่าง (≤ window)
+    uint32_t min_head, min_len;
+    uint32_t max_head, max_len;
+    double sum, sum_comp;           // ผลรวมในหน้าต่าง + ส่วนชดเชย
+    double mean, m2;                // Welford ของหน้าต่าง
+    double fresh_sum, fresh_comp;   // สะสมใหม่ตั้งแต่ ring วนกลับช่อง 0 ครั้งล่าสุด
+    double fresh_mean, fresh_m2;    // (ครบรอบ = ทั้งหน้าต่างพอดี ใช้แทนค่าที่เลื่อนมา ล้างการปัดเศษสะสม)
+
+    double ewma;
+    uint64_t count;                 // ค่าที่รับทั้งหมด
+    uint64_t rejected;              // ค่า NaN/inf ที่ถูกทิ้ง
+    double total_mean, total_m2;    // Welford ตลอดสาย
+    double total_min, total_max;
+} stream_stats_t;
+
+// 📸 สรุป ณ ตอนนี้ (ค่าเป็น 0 ถ้ายังไม่มีข้อมูล)
+typedef struct {
+    uint64_t count;
+    uint64_t rejected;
+    uint32_t window_count;          // จำนวนค่าในหน้าต่าง
+    double sum;                     // ผลรวมเลื่อน
+    double mean;                    // ค่าเฉลี่ยเคลื่อนที่
+    double variance;                // ความแปรปรวน (population) ในหน้าต่าง
+    double min;
+    double max;
+    double ewma;
+    double total_mean;
+    double total_variance;
+    double total_min;
+    double total_max;
+} stream_snapshot_t;
+
+// 🏗️ จองหน่วยความจำหน้าต่าง window × 16 ไบต์ (window ≥ 1, 0 < alpha ≤ 1)
+bool stream_stats_init(stream_stats_t *s, uint32_t window, double alpha);
+void stream_stats_free(stream_stats_t *s);
+void stream_stats_reset(stream_stats_t *s);
+
+// ➕ เพิ่มหนึ่งค่า O(1) (ต่ำสุด/สูงสุด O(1) แบบเฉลี่ย) คืนค่า false ถ้าเป็น NaN/inf (นับใน rejected)
+bool stream_stats_push(stream_stats_t *s, double x);
+
+// ➕ เพิ่มทั้งอาร์เรย์ คืนจำนวนที่รับ
+size_t stream_stats_push_many(stream_stats_t *s, const double *x, size_t n);
+
+void stream_stats_snapshot(const stream_stats_t *s, stream_snapshot_t *out);
+
+// หน้าต่างเต็มแล้วหรือยัง
+static inline bool stream_stats_window_full(const stream_stats_t *s) {
+    return s->n == s->window;
+}
@@ -0,0 +1,167 @@
+#include "stream_stats.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+bool stream_stats_init(stream_stats_t *s, uint32_t window, double alpha) {
+    memset(s, 0, sizeof(*s));
+    if (window == 0 || !(alpha > 0.0 && alpha <= 1.0)) {
+        return false;
+    }
+    // ก้อนเดียว: ring (double) ก่อน แล้ว deque สองชุด
+    void *block = malloc((size_t)window * (sizeof(double) + 2 * sizeof(uint32_t)));
+    if (block == NULL) {
+        return false;
+    }
+    s->window = window;
+    s->alpha = alpha;
+    s->ring = block;
+    s->min_q = (uint32_t *)(s->ring + window);
+    s->max_q = s->min_q + window;
+    return true;
+}
+
+void stream_stats_free(stream_stats_t *s) {
+    free(s->ring);
+    memset(s, 0, sizeof(*s));
+}
+
+void stream_stats_reset(stream_stats_t *s) {
+    double *ring = s->ring;
+    uint32_t *min_q = s->min_q;
+    uint32_t *max_q = s->max_q;
+    uint32_t window = s->window;
+    double alpha = s->alpha;
+
+    memset(s, 0, sizeof(*s));
+    s->ring = ring;
+    s->min_q = min_q;
+    s->max_q = max_q;
+    s->window = window;
+    s->alpha = alpha;
+}
+
+// ➕ ผลรวมชดเชยแบบ Neumaier: เก็บส่วนที่หายจากการปัดไว้ใน comp (ทั้งบวกค่าใหม่และลบค่าเก่า)
+static inline void neumaier_add(double *sum, double *comp, double x) {
+    double t = *sum + x;
+    if (fabs(*sum) >= fabs(x)) {
+        *comp += (*sum - t) + x;
+    } else {
+        *comp += (x - t) + *sum;
+    }
+    *sum = t;
+}
+
+static inline uint32_t wrap(uint32_t i, uint32_t n) {
+    return i >= n ? i - n : i;
+}
+
+bool stream_stats_push(stream_stats_t *s, double x) {
+    if (!isfinite(x)) {
+        s->rejected++;
+        return false;
+    }
+    uint32_t w = s->window;
+    uint32_t pos = s->pos;
+
+    // 📤 หน้าต่างเต็ม: ค่าที่ pos ออกจากหน้าต่าง ถ้าเป็นหัว deque (ค่าที่เก่าที่สุดในนั้น) ก็ออกด้วย
+    if (s->n == w) {
+        double y = s->ring[pos];
+        if (s->min_len > 0 && s->min_q[s->min_head] == pos) {
+            s->min_head = wrap(s->min_head + 1, w);
+            s->min_len--;
+        }
+        if (s->max_len > 0 && s->max_q[s->max_head] == pos) {
+            s->max_head = wrap(s->max_head + 1, w);
+            s->max_len--;
+        }
+        // แทน y ด้วย x ในครั้งเดียว: Δmean = (x - y) / n, Δm2 = (x - y)(x - mean' + y - mean)
+        double old_mean = s->mean;
+        neumaier_add(&s->sum, &s->sum_comp, x);
+        neumaier_add(&s->sum, &s->sum_comp, -y);
+        s->mean = (s->sum + s->sum_comp) / w;
+        s->m2 += (x - y) * (x - s->mean + y - old_mean);
+        if (s->m2 < 0.0) {
+            s->m2 = 0.0;    // กันค่าติดลบเล็กน้อยจากการปัดเศษ
+        }
+    } else {
+        s->n++;
+        double d = x - s->mean;
+        neumaier_add(&s->sum, &s->sum_comp, x);
+        s->mean = (s->sum + s->sum_comp) / s->n;
+        s->m2 += d * (x - s->mean);
+    }
+    s->ring[pos] = x;
+
+    // 📉 monotonic deque: ตัดท้ายที่ไม่มีวันเป็นคำตอบอีก (ถูกค่าใหม่ที่อยู่นานกว่าบังไว้)
+    while (s->min_len > 0 && s->ring[s->min_q[wrap(s->min_head + s->min_len - 1, w)]] >= x) {
+        s->min_len--;
+    }
+    s->min_q[wrap(s->min_head + s->min_len, w)] = pos;
+    s->min_len++;
+    while (s->max_len > 0 && s->ring[s->max_q[wrap(s->max_head + s->max_len - 1, w)]] <= x) {
+        s->max_len--;
+    }
+    s->max_q[wrap(s->max_head + s->max_len, w)] = pos;
+    s->max_len++;
+
+    // 🔄 สะสมชุดใหม่ไปพร้อมกัน พอวนครบรอบ ชุดนี้คือทั้งหน้าต่างพอดี ใช้แทนค่าที่เลื่อนมา
+    uint32_t fresh_n = pos + 1;
+    double fd = x - s->fresh_mean;
+    neumaier_add(&s->fresh_sum, &s->fresh_comp, x);
+    s->fresh_mean = (s->fresh_sum + s->fresh_comp) / fresh_n;
+    s->fresh_m2 += fd * (x - s->fresh_mean);
+    s->pos = wrap(pos + 1, w);
+    if (s->pos == 0) {
+        s->sum = s->fresh_sum;
+        s->sum_comp = s->fresh_comp;
+        s->mean = s->fresh_mean;
+        s->m2 = s->fresh_m2;
+        s->fresh_sum = s->fresh_comp = s->fresh_mean = s->fresh_m2 = 0.0;
+    }
+
+    // 📈 EWMA และ Welford ตลอดสาย
+    if (s->count == 0) {
+        s->ewma = x;
+        s->total_min = x;
+        s->total_max = x;
+    } else {
+        s->ewma += s->alpha * (x - s->ewma);
+        s->total_min = x < s->total_min ? x : s->total_min;
+        s->total_max = x > s->total_max ? x : s->total_max;
+    }
+    s->count++;
+    double d = x - s->total_mean;
+    s->total_mean += d / (double)s->count;
+    s->total_m2 += d * (x - s->total_mean);
+    return true;
+}
+
+size_t stream_stats_push_many(stream_stats_t *s, const double *x, size_t n) {
+    size_t accepted = 0;
+    for (size_t i = 0; i < n; i++) {
+        accepted += stream_stats_push(s, x[i]);
+    }
+    return accepted;
+}
+
+void stream_stats_snapshot(const stream_stats_t *s, stream_snapshot_t *out) {
+    memset(out, 0, sizeof(*out));
+    out->count = s->count;
+    out->rejected = s->rejected;
+    if (s->n == 0) {
+        return;
+    }
+    out->window_count = s->n;
+    out->sum = s->sum + s->sum_comp;
+    out->mean = s->mean;
+    out->variance = s->m2 / s->n;
+    out->min = s->ring[s->min_q[s->min_head]];
+    out->max = s->ring[s->max_q[s->max_head]];
+    out->ewma = s->ewma;
+    out->total_mean = s->total_mean;
+    out->total_variance = s->total_m2 / (double)s->count;
+    out->total_min = s->total_min;
+    out->total_max = s->total_max;
+}
@@ -0,0 +1,90 @@
+// 📡 อ่านสตรีม telemetry จาก stdin แล้วแปลงกลับเป็นข้อความ
+// ข้อความธรรมดาที่ปนมา (log เตือน/ผิดพลาด) ส่งผ่านออกไปตามเดิม เว้นแต่ใช้ -q
+//
+//   telemetry_decode [-q] < capture.bin
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include "calculator.h"
+#include "telemetry.h"
+
+// ชื่อการดำเนินการ = ชื่อแถวใน CALC_OPERATIONS ของโปรเจค 08 (พิมพ์เป็นตัวเล็ก)
+// สร้างจากทะเบียนเดียวกับตัวเข้ารหัส op ใหม่จึงถอดชื่อได้ทันทีโดยไม่ต้องแก้ตัวถอด
+static const char *const op_names[OP_COUNT] = {
+#define OP_NAME(id, ...) [OP_##id] = #id,
+    CALC_OPERATIONS(OP_NAME)
+#undef OP_NAME
+};
+
+static void print_op_name(uint8_t op) {
+    const char *name = op < OP_COUNT && op_names[op] ? op_names[op] : "?";
+    for (; *name; name++) {
+        putchar(tolower((unsigned char)*name));
+    }
+}
+
+static void print_record(const telemetry_record_t *r) {
+    printf("#%03lu t=%lums ", (unsigned long)r->id, (unsigned long)r->timestamp_ms);
+    print_op_name(r->op);
+    putchar('(');
+    for (int i = 0; i < r->n_operands; i++) {
+        printf(i ? ", %.10g" : "%.10g", r->operands[i]);
+    }
+    // ชื่อรหัสข้อผิดพลาดจาก arith (รหัสที่ไม่รู้จักได้ "unknown")
+    printf(") = %.10g [%s]\n", r->result, arith_err_name((arith_err_t)r->err));
+}
+
+int main(int argc, char **argv) {
+    int quiet = argc > 1 && strcmp(argv[1], "-q") == 0;
+    static uint8_t buf[4096 + TELEMETRY_MAX_FRAME];
+    size_t have = 0;
+    unsigned long records = 0, frame_bytes = 0, text_bytes = 0;
+    int eof = 0;
+
+    while (!eof || have > 0) {
+        if (!eof) {
+            size_t n = fread(buf + have, 1, sizeof(buf) - have, stdin);
+            if (n == 0) {
+                eof = 1;
+            }
+            have += n;
+        }
+
+        size_t pos = 0, text_start = 0;
+        while (pos < have) {
+            telemetry_record_t rec;
+            int r = telemetry_decode_frame(buf + pos, have - pos, &rec);
+            if (r < 0 && !eof) {
+                break;  // เฟรมยังมาไม่ครบ รออ่านรอบถัดไป
+            }
+            if (r > 0) {
+                if (!quiet) {
+                    fwrite(buf + text_start, 1, pos - text_start, stdout);
+                }
+                text_bytes += pos - text_start;
+                print_record(&rec);
+                records++;
+                frame_bytes += (unsigned long)r;
+                pos += (size_t)r;
+                text_start = pos;
+            } else {
+                pos++;
+            }
+        }
+
+        if (!quiet) {
+            fwrite(buf + text_start, 1, pos - text_start, stdout);
+        }
+        text_bytes += pos - text_start;
+        memmove(buf, buf + pos, have - pos);
+        have -= pos;
+        if (eof) {
+            break;
+        }
+    }
+
+    fprintf(stderr, "telemetry: %lu records, %lu frame bytes (%.1f B/record), %lu text bytes\n",
+            records, frame_bytes, records ? (double)frame_bytes / records : 0.0, text_bytes);
+    return 0;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 📡 telemetry: ส่งผลการคำนวณเป็นเรคคอร์ดไบนารีขนาดเล็กแทนข้อความ log
+//
+// เฟรม:   0xA5 | len (1 ไบต์) | payload (len ไบต์) | crc8(payload)
+// payload (little-endian):
+//   u8  kind         TELEMETRY_KIND_RESULT
+//   u8  op           รหัสการดำเนินการของแอป
+//   u8  err          รหัสข้อผิดพลาด (arith_err_t)
+//   u8  n_operands   0..TELEMETRY_MAX_OPERANDS
+//   u32 id           ลำดับเรคคอร์ด
+//   u32 timestamp_ms
+//   f64 operands[n_operands]
+//   f64 result
+// ข้อความธรรมดาที่ปนมาระหว่างเฟรม (เช่น ESP_LOGE) ตัวถอดรหัสจะข้ามไปเอง
+
+#define TELEMETRY_SYNC 0xA5
+#define TELEMETRY_KIND_RESULT 0x01
+#define TELEMETRY_MAX_OPERANDS 3
+#define TELEMETRY_HEADER_SIZE 12
+#define TELEMETRY_MAX_PAYLOAD (TELEMETRY_HEADER_SIZE + 8 * (TELEMETRY_MAX_OPERANDS + 1))
+#define TELEMETRY_MAX_FRAME (TELEMETRY_MAX_PAYLOAD + 3)
+
+typedef struct {
+    uint8_t op;
+    uint8_t err;
+    uint8_t n_operands;
+    uint32_t id;
+    uint32_t timestamp_ms;
+    double operands[TELEMETRY_MAX_OPERANDS];
+    double result;
+} telemetry_record_t;
+
+// ✍️ เข้ารหัสเป็นเฟรมลงใน buf (ขนาด ≥ TELEMETRY_MAX_FRAME) คืนค่าความยาวเฟรม
+size_t telemetry_encode(const telemetry_record_t *rec, uint8_t *buf);
+
+// 📤 ตัวส่ง: เข้ารหัสแล้วส่งต่อให้ sink (UART, stdout, ไฟล์ ...) ครั้งเดียวต่อเฟรม
+typedef void (*telemetry_sink_fn)(void *ctx, const uint8_t *data, size_t len);
+
+typedef struct {
+    telemetry_sink_fn sink;
+    void *sink_ctx;
+    uint32_t records;
+    uint32_t bytes;
+} telemetry_writer_t;
+
+void telemetry_writer_init(telemetry_writer_t *w, telemetry_sink_fn sink, void *sink_ctx);
+void telemetry_write(telemetry_writer_t *w, const telemetry_record_t *rec);
+
+// 📥 ถอดรหัสเฟรมที่ตำแหน่ง buf[0] (ใช้ใน host decoder)
+// คืนค่า:  > 0  ความยาวเฟรมที่ถูกต้อง (ผลอยู่ใน *out)
+//          0    buf[0] ไม่ใช่จุดเริ่มเฟรมที่ถูกต้อง (ให้เลื่อนไป 1 ไบต์)
+//         -1    ข้อมูลยังไม่พอ ต้องรออ่านเพิ่ม
+int telemetry_decode_frame(const uint8_t *buf, size_t avail, telemetry_record_t *out);
@@ -0,0 +1,121 @@
+#include "telemetry.h"
+
+#include <string.h>
+
+// 🔐 CRC-8 (poly 0x07) ตรวจเฟรมเสีย/ข้อความที่ไม่ใช่เฟรม
+static uint8_t crc8(const uint8_t *data, size_t len) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static void put_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void put_f64(uint8_t *p, double v) {
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    put_u32(p, (uint32_t)bits);
+    put_u32(p + 4, (uint32_t)(bits >> 32));
+}
+
+static double get_f64(const uint8_t *p) {
+    uint64_t bits = (uint64_t)get_u32(p) | ((uint64_t)get_u32(p + 4) << 32);
+    double v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+size_t telemetry_encode(const telemetry_record_t *rec, uint8_t *buf) {
+    uint8_t n = rec->n_operands > TELEMETRY_MAX_OPERANDS ? TELEMETRY_MAX_OPERANDS : rec->n_operands;
+    uint8_t *p = buf + 2;
+
+    p[0] = TELEMETRY_KIND_RESULT;
+    p[1] = rec->op;
+    p[2] = rec->err;
+    p[3] = n;
+    put_u32(p + 4, rec->id);
+    put_u32(p + 8, rec->timestamp_ms);
+    size_t len = TELEMETRY_HEADER_SIZE;
+    for (uint8_t i = 0; i < n; i++, len += 8) {
+        put_f64(p + len, rec->operands[i]);
+    }
+    put_f64(p + len, rec->result);
+    len += 8;
+
+    buf[0] = TELEMETRY_SYNC;
+    buf[1] = (uint8_t)len;
+    buf[2 + len] = crc8(p, len);
+    return len + 3;
+}
+
+void telemetry_writer_init(telemetry_writer_t *w, telemetry_sink_fn sink, void *sink_ctx) {
+    memset(w, 0, sizeof(*w));
+    w->sink = sink;
+    w->sink_ctx = sink_ctx;
+}
+
+void telemetry_write(telemetry_writer_t *w, const telemetry_record_t *rec) {
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    size_t len = telemetry_encode(rec, frame);
+    w->sink(w->sink_ctx, frame, len);
+    w->records++;
+    w->bytes += (uint32_t)len;
+}
+
+static bool parse_payload(const uint8_t *p, uint8_t len, telemetry_record_t *out) {
+    if (len < TELEMETRY_HEADER_SIZE + 8 || p[0] != TELEMETRY_KIND_RESULT) {
+        return false;
+    }
+    uint8_t n = p[3];
+    if (n > TELEMETRY_MAX_OPERANDS || len != TELEMETRY_HEADER_SIZE + 8 * (n + 1)) {
+        return false;
+    }
+    memset(out, 0, sizeof(*out));
+    out->op = p[1];
+    out->err = p[2];
+    out->n_operands = n;
+    out->id = get_u32(p + 4);
+    out->timestamp_ms = get_u32(p + 8);
+    for (uint8_t i = 0; i < n; i++) {
+        out->operands[i] = get_f64(p + TELEMETRY_HEADER_SIZE + 8 * i);
+    }
+    out->result = get_f64(p + TELEMETRY_HEADER_SIZE + 8 * n);
+    return true;
+}
+
+int telemetry_decode_frame(const uint8_t *buf, size_t avail, telemetry_record_t *out) {
+    if (avail < 1) {
+        return -1;
+    }
+    if (buf[0] != TELEMETRY_SYNC) {
+        return 0;
+    }
+    if (avail < 2) {
+        return -1;
+    }
+    uint8_t len = buf[1];
+    if (len < TELEMETRY_HEADER_SIZE + 8 || len > TELEMETRY_MAX_PAYLOAD) {
+        return 0;
+    }
+    if (avail < (size_t)len + 3) {
+        return -1;
+    }
+    if (buf[2 + len] != crc8(buf + 2, len) || !parse_payload(buf + 2, len, out)) {
+        return 0;
+    }
+    return len + 3;
+}
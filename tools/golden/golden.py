@@ -0,0 +1,381 @@
+#!/usr/bin/env python3
+"""🧪 golden: build ทุก lab (01-08) รันพร้อมกันแบบไม่มีจอ แล้วเทียบผลกับไฟล์ golden
+
+สองโหมด:
+  --host (ค่าเริ่มต้น)  gcc คอมไพล์ main/*.c + components ด้วย shim ใน tools/golden/host
+                        (รวมแคตตาล็อกที่ main/CMakeLists.txt สั่งสร้างด้วย catalog_generate)
+                        ไม่ต้องมี ESP-IDF รันจบในไม่กี่วินาที ใช้เป็น gate ทุกครั้งที่แก้โค้ด
+  --idf                 idf.py build ด้วย linux target (ESP-IDF ≥ 5.x) แล้วรัน .elf ที่ได้
+                        โปรแกรมบน linux target ไม่จบเองหลัง app_main คืนค่า จึงถือว่าจบเมื่อเงียบ
+                        เกิน --idle วินาที (เวลาจริงที่รายงานนับถึงบรรทัดสุดท้าย)
+
+ผลลัพธ์ถูกทำให้เป็นรูปมาตรฐานก่อนเทียบ (ตัด timestamp ของ log, ค่าเวลา และบรรทัดที่ขึ้นกับเครื่อง)
+การปรับแต่งความเร็วที่ผ่าน gate นี้จึงพิสูจน์ได้ว่าผลที่ผู้ใช้เห็นไม่เปลี่ยน
+
+รายงานต่อโปรเจค (เวลา build, เวลาจริง, RSS สูงสุด) อยู่ใน build/golden/report.csv
+ผลที่ไม่ตรงมี diff อยู่ที่ build/golden/<project>.diff
+
+ใช้งาน:
+  python3 tools/golden/golden.py                 # gate: build + รัน + เทียบ
+  python3 tools/golden/golden.py --update        # เขียน golden ใหม่จากผลปัจจุบัน
+  python3 tools/golden/golden.py -p 08 -p 06     # เฉพาะบางโปรเจค
+  python3 tools/golden/golden.py --idf -j 4      # build/รันด้วย ESP-IDF linux target
+"""
+
+import argparse
+import concurrent.futures
+import csv
+import difflib
+import glob
+import os
+import re
+import select
+import shutil
+import subprocess
+import sys
+import time
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+PROJECTS_DIR = os.path.join(ROOT, "projects")
+COMPONENTS_DIR = os.path.join(PROJECTS_DIR, "components")
+HOST_DIR = os.path.join(ROOT, "tools", "golden", "host")
+EXPECTED_DIR = os.path.join(ROOT, "tools", "golden", "expected")
+OUT_DIR = os.path.join(ROOT, "build", "golden")
+
+# 🧩 component ที่ไม่เข้า build บน host (bench ใช้ตัวนับรอบของ x86 และมี main ของตัวเอง)
+HOST_SKIP_COMPONENTS = {"bench"}
+
+# 🧹 กฎทำให้เป็นรูปมาตรฐาน — ทุกอย่างที่ขึ้นกับเวลาหรือเครื่องต้องหายไป ผลคำนวณต้องอยู่ครบ
+ANSI_RE = re.compile(r"\x1b\[[0-9;]*m")
+LOG_RE = re.compile(r"^([EWIDV]) \(\d+\) ([^:]+): ?(.*)$")
+TIME_RE = re.compile(r"-?\d+(?:\.\d+)?(\s*)(มิลลิวินาที|วินาที|ms|µs|us)(?![A-Za-z])")
+DATETIME_RE = re.compile(r"\d{4}-\d{2}-\d{2}[ T]\d{2}:\d{2}(?::\d{2})?")
+# บรรทัดที่ค่าขึ้นกับเวลาหรือหน่วยความจำของเครื่อง (ไม่ใช่ผลคำนวณ) ตัดตัวเลขออกทั้งบรรทัด
+VOLATILE_LINE_RE = re.compile(r"^[EWI] [^:]+: 📏|^# mem |รีเซ็ต → ผลแรก|first result|ops/s|cycles|/วินาที")
+NUMBER_RE = re.compile(r"\d+(?:\.\d+)?k?")
+# ระดับที่ตัดสินจากเวลาเฉลี่ย (08: ยอดเยี่ยม/ดี/ปกติ)
+RATING_RE = re.compile(r"(🚀 ประสิทธิภาพ: )\S+")
+
+
+def normalize(text):
+    """คืนรายการบรรทัดที่ตัดส่วนที่ขึ้นกับเวลาแล้ว"""
+    lines = []
+    for raw in text.splitlines():
+        line = ANSI_RE.sub("", raw).rstrip()
+        m = LOG_RE.match(line)
+        if m:
+            line = "%s %s: %s" % (m.group(1), m.group(2), m.group(3))
+        line = DATETIME_RE.sub("<datetime>", line)
+        line = RATING_RE.sub(r"\1<rating>", line)
+        if VOLATILE_LINE_RE.search(line):
+            # ความกว้างของตัวเลขเปลี่ยนได้ (%8u) ช่องว่างจึงยุบเหลือช่องเดียว
+            line = re.sub(r"\s+", " ", NUMBER_RE.sub("<n>", line))
+        else:
+            line = TIME_RE.sub(r"<t>\1\2", line)
+        lines.append(line)
+    while lines and not lines[-1]:
+        lines.pop()
+    return lines
+
+
+def discover(filters):
+    projects = sorted(
+        os.path.basename(p)
+        for p in glob.glob(os.path.join(PROJECTS_DIR, "0[1-8]_*"))
+        if os.path.isfile(os.path.join(p, "CMakeLists.txt"))
+    )
+    if filters:
+        projects = [p for p in projects if any(p.startswith(f) for f in filters)]
+    return projects
+
+
+# 🔨 build --------------------------------------------------------------------
+
+HOST_CFLAGS = ["-std=gnu11", "-O2", "-Wall", "-Wextra"]
+
+# catalog_generate(<csv> <symbol>) ใน main/CMakeLists.txt (components/catalog/project_include.cmake)
+CATALOG_GEN_RE = re.compile(r'catalog_generate\(\s*"?([^"\s)]+)"?\s+(\w+)\s*\)')
+CATALOG_GENERATOR = os.path.join(COMPONENTS_DIR, "catalog", "gen_catalog.py")
+
+
+def host_includes():
+    dirs = [HOST_DIR]
+    for comp in sorted(os.listdir(COMPONENTS_DIR)):
+        inc = os.path.join(COMPONENTS_DIR, comp, "include")
+        if comp not in HOST_SKIP_COMPONENTS and os.path.isdir(inc):
+            dirs.append(inc)
+    return dirs
+
+
+def up_to_date(obj):
+    """obj ใหม่กว่าทุกไฟล์ที่มันพึ่ง (จากไฟล์ .d ที่ gcc -MMD เขียนไว้)"""
+    dep = obj + ".d"
+    if not os.path.isfile(obj) or not os.path.isfile(dep):
+        return False
+    with open(dep) as f:
+        files = f.read().replace("\\\n", " ").split(":", 1)[1].split()
+    t = os.path.getmtime(obj)
+    return all(os.path.isfile(x) and os.path.getmtime(x) <= t for x in files)
+
+
+def compile_c(cc, src, obj, includes):
+    if up_to_date(obj):
+        return True, ""
+    os.makedirs(os.path.dirname(obj), exist_ok=True)
+    cmd = [cc] + HOST_CFLAGS + ["-MMD", "-MF", obj + ".d", "-c", src, "-o", obj]
+    cmd += ["-I" + d for d in includes]
+    proc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    return proc.returncode == 0, proc.stdout
+
+
+def build_host_common(cc, pool):
+    """คอมไพล์ components + host_main ครั้งเดียวใช้ร่วมทุกโปรเจค (ข้ามไฟล์ที่ไม่เปลี่ยน)"""
+    includes = host_includes()
+    jobs = [(os.path.join(HOST_DIR, "host_main.c"), os.path.join(OUT_DIR, "host", "common", "host_main.o"))]
+    for comp in sorted(os.listdir(COMPONENTS_DIR)):
+        if comp in HOST_SKIP_COMPONENTS:
+            continue
+        for src in sorted(glob.glob(os.path.join(COMPONENTS_DIR, comp, "*.c"))):
+            obj = os.path.join(OUT_DIR, "host", "common", comp, os.path.basename(src)[:-2] + ".o")
+            jobs.append((src, obj))
+    results = list(pool.map(lambda j: compile_c(cc, j[0], j[1], includes), jobs))
+    log = "".join(out for _, out in results)
+    return ([obj for _, obj in jobs] if all(ok for ok, _ in results) else None), log
+
+
+def generate_catalogs(project, main_dir, log):
+    """สร้างแคตตาล็อกสินค้าแบบเดียวกับ catalog_generate ของ IDF คืนรายการไฟล์ .c (None = ล้มเหลว)"""
+    with open(os.path.join(main_dir, "CMakeLists.txt")) as f:
+        calls = CATALOG_GEN_RE.findall(f.read())
+    srcs = []
+    for csv_path, symbol in calls:
+        csv_path = os.path.join(main_dir, csv_path)
+        out = os.path.join(OUT_DIR, "host", project, symbol + ".c")
+        srcs.append(out)
+        if os.path.isfile(out) and os.path.getmtime(out) >= max(
+                os.path.getmtime(csv_path), os.path.getmtime(CATALOG_GENERATOR)):
+            continue
+        os.makedirs(os.path.dirname(out), exist_ok=True)
+        proc = subprocess.run([sys.executable, CATALOG_GENERATOR, csv_path, "--symbol", symbol, "--out", out],
+                              stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+        log.append(proc.stdout)
+        if proc.returncode != 0:
+            return None
+    return srcs
+
+
+def build_host(project, cc, common):
+    main_dir = os.path.join(PROJECTS_DIR, project, "main")
+    includes = host_includes() + [main_dir]
+    objs = []
+    log = []
+    generated = generate_catalogs(project, main_dir, log)
+    if generated is None:
+        return None, "".join(log)
+    for src in sorted(glob.glob(os.path.join(main_dir, "*.c"))) + generated:
+        obj = os.path.join(OUT_DIR, "host", project, os.path.basename(src)[:-2] + ".o")
+        ok, out = compile_c(cc, src, obj, includes)
+        log.append(out)
+        if not ok:
+            return None, "".join(log)
+        objs.append(obj)
+
+    exe = os.path.join(OUT_DIR, "host", project, project)
+    proc = subprocess.run([cc, "-o", exe] + objs + common + ["-lm", "-pthread"],
+                          stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    log.append(proc.stdout)
+    return (exe if proc.returncode == 0 else None), "".join(log)
+
+
+def project_name(project):
+    with open(os.path.join(PROJECTS_DIR, project, "CMakeLists.txt")) as f:
+        m = re.search(r"project\((\w+)\)", f.read())
+    return m.group(1) if m else project
+
+
+def build_idf(project, idf):
+    bdir = os.path.join(OUT_DIR, "idf", project)
+    pdir = os.path.join(PROJECTS_DIR, project)
+    # sdkconfig แยกต่อ build dir: ไม่ทับ sdkconfig ของผู้ใช้ที่ build ให้บอร์ดจริง
+    base = [idf, "-C", pdir, "-B", bdir, "-D", "SDKCONFIG=" + os.path.join(bdir, "sdkconfig")]
+    log = []
+    for args in (["--preview", "set-target", "linux"], ["build"]):
+        if args[0] == "build" or not os.path.isfile(os.path.join(bdir, "sdkconfig")):
+            proc = subprocess.run(base + args, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+            log.append(proc.stdout)
+            if proc.returncode != 0:
+                return None, "".join(log)
+    exe = os.path.join(bdir, project_name(project) + ".elf")
+    return (exe if os.path.isfile(exe) else None), "".join(log)
+
+
+# ▶️ run ----------------------------------------------------------------------
+
+def vm_hwm(pid):
+    """VmHWM (KB) ของ process ที่ยังทำงานอยู่ หรือ 0"""
+    try:
+        with open("/proc/%d/status" % pid) as f:
+            for line in f:
+                if line.startswith("VmHWM:"):
+                    return int(line.split()[1])
+    except (OSError, ValueError):
+        pass
+    return 0
+
+
+def run(exe, timeout, idle):
+    """รันแบบไม่มี stdin คืน (สถานะ, ผลลัพธ์, เวลาจริง s, RSS สูงสุด KB)
+
+    idle > 0: ถือว่าจบเมื่อไม่มีผลลัพธ์ใหม่นานเกิน idle วินาที (linux target ของ ESP-IDF)
+    RSS มาจาก VmHWM ที่ host_main เขียนตอนจบ หรือที่อ่านจาก /proc ระหว่างรัน
+    (ru_maxrss ของลูกนับหน่วยความจำของ python ก่อน exec รวมมาด้วย จึงใช้ไม่ได้)
+    """
+    hwm_file = exe + ".hwm"
+    if os.path.exists(hwm_file):
+        os.remove(hwm_file)
+    env = dict(os.environ, GOLDEN_HWM_FILE=hwm_file)
+    start = time.monotonic()
+    proc = subprocess.Popen([exe], stdin=subprocess.DEVNULL, stdout=subprocess.PIPE,
+                            stderr=subprocess.STDOUT, cwd=os.path.dirname(exe), env=env)
+    fd = proc.stdout.fileno()
+    chunks = []
+    last = start
+    hwm = 0
+    state = "exit"
+    while True:
+        ready, _, _ = select.select([fd], [], [], 0.1)
+        now = time.monotonic()
+        hwm = max(hwm, vm_hwm(proc.pid))
+        if ready:
+            data = os.read(fd, 65536)
+            if not data:
+                last = now
+                break
+            chunks.append(data)
+            last = now
+        elif idle > 0 and now - last >= idle:
+            state = "idle"
+            proc.kill()
+            break
+        if now - start >= timeout:
+            state = "timeout"
+            proc.kill()
+            break
+    proc.wait()
+    proc.stdout.close()
+    if state == "exit" and proc.returncode != 0:
+        state = "crash(%d)" % proc.returncode
+    if os.path.isfile(hwm_file):
+        with open(hwm_file) as f:
+            hwm = max(hwm, int(f.read() or 0))
+    out = b"".join(chunks).decode("utf-8", errors="replace")
+    return state, out, last - start, hwm
+
+
+# 🧪 หนึ่งโปรเจค: build → run → เทียบ ------------------------------------------
+
+def check(project, args, common):
+    row = {"project": project, "mode": "idf" if args.idf else "host", "status": "",
+           "build_s": 0.0, "wall_s": 0.0, "peak_rss_kb": 0, "lines": 0}
+    t0 = time.monotonic()
+    exe, log = build_idf(project, args.idf_py) if args.idf else build_host(project, args.cc, common)
+    row["build_s"] = time.monotonic() - t0
+    if log.strip():
+        # คำเตือนของ compiler ไม่ทำให้ gate ล้ม แต่ต้องเห็นทุกครั้ง
+        with open(os.path.join(OUT_DIR, project + ".build.log"), "w") as f:
+            f.write(log)
+        print(log, file=sys.stderr, end="")
+    if exe is None:
+        row["status"] = "build-failed"
+        return row
+
+    idle = args.idle if args.idf else 0
+    state, out, wall, rss = run(exe, args.timeout, idle)
+    row.update(wall_s=wall, peak_rss_kb=rss)
+    with open(os.path.join(OUT_DIR, project + ".out"), "w") as f:
+        f.write(out)
+    if state not in ("exit", "idle"):
+        row["status"] = state
+        return row
+
+    got = normalize(out)
+    row["lines"] = len(got)
+    golden = os.path.join(EXPECTED_DIR, project + ".txt")
+    if args.update:
+        with open(golden, "w") as f:
+            f.write("\n".join(got) + "\n")
+        row["status"] = "updated"
+        return row
+    if not os.path.isfile(golden):
+        row["status"] = "no-golden"
+        return row
+    with open(golden) as f:
+        want = f.read().splitlines()
+    if want == got:
+        row["status"] = "ok"
+        return row
+    row["status"] = "mismatch"
+    with open(os.path.join(OUT_DIR, project + ".diff"), "w") as f:
+        f.writelines(line + "\n" for line in difflib.unified_diff(
+            want, got, "expected/" + project + ".txt", project + ".out", lineterm=""))
+    return row
+
+
+def main():
+    ap = argparse.ArgumentParser(description="golden-output regression + เวลา/RSS ของทุก lab")
+    ap.add_argument("-p", "--project", action="append", default=[],
+                    help="คำนำหน้าชื่อโปรเจค เช่น 08 (ใส่ซ้ำได้) ค่าเริ่มต้น: ทุก lab 01-08")
+    ap.add_argument("-j", "--jobs", type=int, default=os.cpu_count() or 1)
+    ap.add_argument("--idf", action="store_true", help="build ด้วย idf.py linux target แทน gcc + shim")
+    ap.add_argument("--idf-py", default=shutil.which("idf.py") or "idf.py")
+    ap.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    ap.add_argument("--update", action="store_true", help="เขียนไฟล์ golden ใหม่จากผลปัจจุบัน")
+    ap.add_argument("--timeout", type=float, default=120.0, help="วินาทีต่อหนึ่งโปรเจค")
+    ap.add_argument("--idle", type=float, default=6.0,
+                    help="(--idf) วินาทีที่เงียบแล้วถือว่าจบ ต้องนานกว่าการหน่วงยาวสุดของเดโม")
+    args = ap.parse_args()
+
+    projects = discover(args.project)
+    if not projects:
+        print("ไม่พบโปรเจค", file=sys.stderr)
+        return 2
+    os.makedirs(OUT_DIR, exist_ok=True)
+    os.makedirs(EXPECTED_DIR, exist_ok=True)
+    for stale in glob.glob(os.path.join(OUT_DIR, "*.diff")) + glob.glob(os.path.join(OUT_DIR, "*.build.log")):
+        os.remove(stale)
+
+    t0 = time.monotonic()
+    with concurrent.futures.ThreadPoolExecutor(max_workers=max(1, args.jobs)) as pool:
+        common = None
+        if not args.idf:
+            common, log = build_host_common(args.cc, pool)
+            print(log, file=sys.stderr, end="")
+            if common is None:
+                print("❌ build components ไม่ผ่าน", file=sys.stderr)
+                return 1
+        rows = list(pool.map(lambda p: check(p, args, common), projects))
+    total = time.monotonic() - t0
+
+    fields = ["project", "mode", "status", "build_s", "wall_s", "peak_rss_kb", "lines"]
+    with open(os.path.join(OUT_DIR, "report.csv"), "w", newline="") as f:
+        w = csv.DictWriter(f, fieldnames=fields)
+        w.writeheader()
+        for r in rows:
+            w.writerow(dict(r, build_s="%.3f" % r["build_s"], wall_s="%.3f" % r["wall_s"]))
+
+    print("%-28s %-13s %8s %8s %10s %6s" % ("project", "status", "build s", "wall s", "RSS KB", "lines"))
+    for r in rows:
+        print("%-28s %-13s %8.2f %8.3f %10d %6d" % (r["project"], r["status"], r["build_s"],
+                                                   r["wall_s"], r["peak_rss_kb"], r["lines"]))
+    bad = [r for r in rows if r["status"] not in ("ok", "updated")]
+    print("%d/%d ผ่าน ใน %.1f s — รายงาน: %s" % (len(rows) - len(bad), len(rows), total,
+                                                  os.path.relpath(os.path.join(OUT_DIR, "report.csv"), ROOT)))
+    for r in bad:
+        hint = {"mismatch": ".diff", "build-failed": ".build.log"}.get(r["status"], ".out")
+        print("  ❌ %s: %s (ดู %s)" % (r["project"], r["status"],
+                                      os.path.relpath(os.path.join(OUT_DIR, r["project"] + hint), ROOT)))
+    return 1 if bad else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <stdint.h>
+
+// 🖥️ CRC32 (little-endian, poly 0xEDB88320) แบบเดียวกับ ROM ของ ESP32
+static inline uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len) {
+    crc = ~crc;
+    while (len--) {
+        crc ^= *buf++;
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+#include "esp_err.h"
+
+// 🖥️ esp_timer บน host: ไมโครวินาทีจาก CLOCK_MONOTONIC
+static inline int64_t esp_timer_get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+// ⏲️ timer แบบ callback ไม่มีบน host (ผลของเดโมต้องไม่ขึ้นกับจังหวะเวลา)
+typedef struct esp_timer *esp_timer_handle_t;
+typedef void (*esp_timer_cb_t)(void *arg);
+
+typedef struct {
+    esp_timer_cb_t callback;
+    void *arg;
+    const char *name;
+} esp_timer_create_args_t;
+
+static inline esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out) {
+    (void)args;
+    (void)out;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static inline esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period_us) {
+    (void)timer;
+    (void)period_us;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static inline esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    (void)timer;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static inline esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+    (void)timer;
+    return ESP_ERR_NOT_SUPPORTED;
+}
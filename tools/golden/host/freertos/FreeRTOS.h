@@ -0,0 +1,23 @@
+#pragma once
+
+#include <pthread.h>
+#include <stdint.h>
+
+// 🖥️ FreeRTOS บน host: ชนิดและค่าคงที่ที่โปรเจคใช้
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define portMAX_DELAY 0xffffffffu
+#define portNUM_PROCESSORS 2
+#define configMAX_TASK_NAME_LEN 16
+#define pdPASS 1
+#define pdFAIL 0
+
+// spinlock ของ critical section (portMUX) บน host = pthread mutex
+typedef pthread_mutex_t portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED PTHREAD_MUTEX_INITIALIZER
+#define taskENTER_CRITICAL(mux) pthread_mutex_lock(mux)
+#define taskEXIT_CRITICAL(mux) pthread_mutex_unlock(mux)
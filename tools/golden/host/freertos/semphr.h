@@ -0,0 +1,41 @@
+#pragma once
+
+#include <semaphore.h>
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+
+// 🖥️ semaphore นับได้บน host (POSIX)
+typedef sem_t *SemaphoreHandle_t;
+typedef sem_t StaticSemaphore_t;
+
+static inline SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max, UBaseType_t initial) {
+    sem_t *s = malloc(sizeof(*s));
+    (void)max;
+    if (s != NULL && sem_init(s, 0, initial) != 0) {
+        free(s);
+        s = NULL;
+    }
+    return s;
+}
+
+static inline SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    return xSemaphoreCreateCounting(1, 1);
+}
+
+static inline SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *storage) {
+    return sem_init(storage, 0, 1) == 0 ? storage : NULL;
+}
+
+static inline BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+    return sem_post(s) == 0 ? pdPASS : pdFAIL;
+}
+
+static inline BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks) {
+    (void)ticks;
+    return sem_wait(s) == 0 ? pdPASS : pdFAIL;
+}
+
+static inline void vSemaphoreDelete(SemaphoreHandle_t s) {
+    sem_destroy(s);
+    free(s);
+}
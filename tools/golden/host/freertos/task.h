@@ -0,0 +1,56 @@
+#pragma once
+
+#include <pthread.h>
+#include "freertos/FreeRTOS.h"
+
+// 🖥️ task บน host: หนึ่ง task = หนึ่ง pthread (ไม่ pin core)
+// vTaskDelay ไม่รอจริง — การหน่วงของเดโมมีไว้ให้คนอ่าน ผลลัพธ์ไม่เปลี่ยน
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+static inline void vTaskDelay(const TickType_t ticks) {
+    (void)ticks;
+}
+
+static inline TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return (TaskHandle_t)pthread_self();
+}
+
+static inline char *pcTaskGetName(TaskHandle_t task) {
+    (void)task;
+    return "main";              // ทุก lab รันใน main task บน host
+}
+
+static inline UBaseType_t uxTaskPriorityGet(TaskHandle_t task) {
+    (void)task;
+    return 1;
+}
+
+static inline void vTaskDelete(TaskHandle_t task) {
+    if (task == NULL) {
+        pthread_exit(NULL);
+    }
+}
+
+typedef struct {
+    TaskFunction_t fn;
+    void *arg;
+} host_task_start_t;
+
+static inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack,
+                                                 void *arg, UBaseType_t prio, TaskHandle_t *out,
+                                                 BaseType_t core) {
+    pthread_t thread;
+    (void)name;
+    (void)stack;
+    (void)prio;
+    (void)core;
+    if (pthread_create(&thread, NULL, (void *(*)(void *))(void *)fn, arg) != 0) {
+        return pdFAIL;
+    }
+    pthread_detach(thread);
+    if (out != NULL) {
+        *out = (TaskHandle_t)thread;
+    }
+    return pdPASS;
+}
@@ -0,0 +1,38 @@
+// 🖥️ จุดเริ่มบน host: เรียก app_main ของโปรเจคแล้วจบ process (เหมือนเฟิร์มแวร์ที่รันจนจบเดโม)
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void app_main(void);
+
+// 📏 RSS สูงสุดของ image นี้ (VmHWM) เขียนลงไฟล์ที่ golden.py ขอไว้
+// ru_maxrss ของ wait4 ใช้ไม่ได้: มันนับหน่วยความจำของ python ก่อน exec รวมมาด้วย
+static void report_hwm(void) {
+    const char *path = getenv("GOLDEN_HWM_FILE");
+    char line[128];
+    FILE *in = fopen("/proc/self/status", "r");
+    if (path == NULL || in == NULL) {
+        if (in != NULL) {
+            fclose(in);
+        }
+        return;
+    }
+    while (fgets(line, sizeof(line), in) != NULL) {
+        if (strncmp(line, "VmHWM:", 6) == 0) {
+            FILE *out = fopen(path, "w");
+            if (out != NULL) {
+                fprintf(out, "%ld\n", strtol(line + 6, NULL, 10));
+                fclose(out);
+            }
+            break;
+        }
+    }
+    fclose(in);
+}
+
+int main(void) {
+    atexit(report_hwm);
+    app_main();
+    fflush(stdout);
+    return 0;
+}
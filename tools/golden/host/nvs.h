@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stddef.h>
+#include "esp_err.h"
+
+// 🖥️ host ไม่มี flash: ทุกคำสั่งของ NVS ล้มเหลว
+typedef int nvs_handle_t;
+typedef enum { NVS_READONLY, NVS_READWRITE } nvs_open_mode_t;
+
+static inline esp_err_t nvs_open(const char *ns, nvs_open_mode_t mode, nvs_handle_t *out) {
+    (void)ns;
+    (void)mode;
+    (void)out;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static inline void nvs_close(nvs_handle_t h) {
+    (void)h;
+}
+
+static inline esp_err_t nvs_commit(nvs_handle_t h) {
+    (void)h;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static inline esp_err_t nvs_set_blob(nvs_handle_t h, const char *key, const void *value, size_t len) {
+    (void)h;
+    (void)key;
+    (void)value;
+    (void)len;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static inline esp_err_t nvs_get_blob(nvs_handle_t h, const char *key, void *value, size_t *len) {
+    (void)h;
+    (void)key;
+    (void)value;
+    (void)len;
+    return ESP_ERR_NOT_SUPPORTED;
+}
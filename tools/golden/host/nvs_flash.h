@@ -0,0 +1,12 @@
+#pragma once
+
+#include "esp_err.h"
+
+// 🖥️ host ไม่มี flash: NVS ใช้ไม่ได้ (warm snapshot จึงข้ามไปเอง)
+static inline esp_err_t nvs_flash_init(void) {
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static inline esp_err_t nvs_flash_erase(void) {
+    return ESP_ERR_NOT_SUPPORTED;
+}
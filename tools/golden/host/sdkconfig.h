@@ -0,0 +1,14 @@
+#pragma once
+
+// 🖥️ ค่า menuconfig สำหรับ build บน host (ค่าเริ่มต้นใน Kconfig ของทุกโปรเจค)
+// host ทำตัวเหมือน linux target: ไม่มี UART/RTC/esp_system
+#define CONFIG_IDF_TARGET_LINUX 1
+#define CONFIG_CALC_HISTORY_ARENA_SIZE 7600
+#define CONFIG_CALC_STATS_BUCKETS 24
+#define CONFIG_CALC_STATS_BUCKET_SEC 3600
+#define CONFIG_CALC_BIGINT_ARENA_SIZE 16384
+#define CONFIG_CALC_STREAM_WINDOW 64
+#define CONFIG_CALC_STREAM_EWMA_PERCENT 10
+#define CONFIG_CALC_SESSIONS 1
+#define CONFIG_CALC_SERVER_BATCH 32
+#define CONFIG_CALC_MEMSTAT_PERIOD_MS 0